@@ -20,6 +20,23 @@
 
 
 
+/* power-of-two buckets in microseconds, the last one collects everything
+ * above ~1 second */
+#define HISTOGRAM_N_BUCKETS 21
+
+struct _XfsdDebugHistogram
+{
+    XfsdDebugDomain domain;
+    gchar *name;
+    guint64 n_samples;
+    gint64 min;
+    gint64 max;
+    gint64 total;
+    guint64 buckets[HISTOGRAM_N_BUCKETS];
+};
+
+
+
 static const GDebugKey dbg_keys[] = {
     { "xsettings", XFSD_DEBUG_XSETTINGS },
     { "fontconfig", XFSD_DEBUG_FONTCONFIG },
@@ -125,3 +142,91 @@ xfsettings_dbg_filtered (XfsdDebugDomain domain,
     xfsettings_dbg_print (domain, message, args);
     va_end (args);
 }
+
+
+
+gboolean
+xfsettings_dbg_enabled (XfsdDebugDomain domain)
+{
+    return (xfsettings_dbg_init () & domain) != 0;
+}
+
+
+
+XfsdDebugHistogram *
+xfsettings_dbg_histogram_new (XfsdDebugDomain domain,
+                              const gchar *name)
+{
+    XfsdDebugHistogram *histogram;
+
+    g_return_val_if_fail (name != NULL, NULL);
+
+    histogram = g_new0 (XfsdDebugHistogram, 1);
+    histogram->domain = domain;
+    histogram->name = g_strdup (name);
+    histogram->min = G_MAXINT64;
+
+    return histogram;
+}
+
+
+
+void
+xfsettings_dbg_histogram_add (XfsdDebugHistogram *histogram,
+                              gint64 usec)
+{
+    GString *string;
+    guint bucket;
+    guint i;
+
+    g_return_if_fail (histogram != NULL);
+
+    /* only record samples when somebody is going to look at them */
+    if (!xfsettings_dbg_enabled (histogram->domain))
+        return;
+
+    usec = MAX (usec, 0);
+    bucket = usec > 0 ? MIN (g_bit_storage ((gulong) usec) - 1, HISTOGRAM_N_BUCKETS - 1) : 0;
+
+    histogram->buckets[bucket]++;
+    histogram->n_samples++;
+    histogram->total += usec;
+    histogram->min = MIN (histogram->min, usec);
+    histogram->max = MAX (histogram->max, usec);
+
+    string = g_string_new (NULL);
+    for (i = 0; i < HISTOGRAM_N_BUCKETS; i++)
+    {
+        if (histogram->buckets[i] == 0)
+            continue;
+
+        if (i == HISTOGRAM_N_BUCKETS - 1)
+            g_string_append_printf (string, " >=%" G_GINT64_FORMAT "us:%" G_GUINT64_FORMAT,
+                                    (gint64) 1 << i, histogram->buckets[i]);
+        else
+            g_string_append_printf (string, " <%" G_GINT64_FORMAT "us:%" G_GUINT64_FORMAT,
+                                    (gint64) 1 << (i + 1), histogram->buckets[i]);
+    }
+
+    xfsettings_dbg_filtered (histogram->domain,
+                             "%s: %" G_GINT64_FORMAT "us (n=%" G_GUINT64_FORMAT
+                             ", min=%" G_GINT64_FORMAT "us, avg=%" G_GINT64_FORMAT
+                             "us, max=%" G_GINT64_FORMAT "us)%s",
+                             histogram->name, usec, histogram->n_samples,
+                             histogram->min, histogram->total / (gint64) histogram->n_samples,
+                             histogram->max, string->str);
+
+    g_string_free (string, TRUE);
+}
+
+
+
+void
+xfsettings_dbg_histogram_free (XfsdDebugHistogram *histogram)
+{
+    if (histogram == NULL)
+        return;
+
+    g_free (histogram->name);
+    g_free (histogram);
+}
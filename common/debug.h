@@ -40,6 +40,8 @@ typedef enum
     XFSD_DEBUG_GTK_SETTINGS = 1 << 10,
 } XfsdDebugDomain;
 
+typedef struct _XfsdDebugHistogram XfsdDebugHistogram;
+
 void
 xfsettings_dbg (XfsdDebugDomain domain,
                 const gchar *message,
@@ -50,6 +52,20 @@ xfsettings_dbg_filtered (XfsdDebugDomain domain,
                          const gchar *message,
                          ...) G_GNUC_PRINTF (2, 3);
 
+gboolean
+xfsettings_dbg_enabled (XfsdDebugDomain domain);
+
+XfsdDebugHistogram *
+xfsettings_dbg_histogram_new (XfsdDebugDomain domain,
+                              const gchar *name);
+
+void
+xfsettings_dbg_histogram_add (XfsdDebugHistogram *histogram,
+                              gint64 usec);
+
+void
+xfsettings_dbg_histogram_free (XfsdDebugHistogram *histogram);
+
 G_END_DECLS
 
 #endif /* !__DEBUG_H__ */
@@ -0,0 +1,402 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Synthetic outputs for profiling the display code without a display
+ * server that has them. The mock is selected at runtime with
+ *
+ *   XFCE_DISPLAY_MOCK=<outputs>[:<crtcs>[:<seed>]]
+ *
+ * e.g. XFCE_DISPLAY_MOCK=16:8 for sixteen connected outputs of which at
+ * most eight can be active. The seed changes the EDIDs, so that different
+ * runs can look like different sets of monitors.
+ *
+ * For a specific setup, XFCE_DISPLAY_MOCK can name a key file instead:
+ *
+ *   [Mock]
+ *   CRTCs=2
+ *
+ *   [eDP-1]
+ *   EDID=00ffffffffffff00...
+ *   Modes=1920x1080@60;1280x720@60
+ *
+ *   [DP-1]
+ *   Name=Office Monitor
+ *   Modes=2560x1440@59.95;1920x1080@60
+ *
+ * Every group other than [Mock] is an output, in file order. EDID is the
+ * raw EDID in hex, it goes through the same decoding as a real one, so
+ * identical monitors can be described by repeating the same blob. Modes
+ * are listed largest first, the first one is preferred. Name overrides
+ * the name derived from the EDID.
+ */
+
+#include "debug.h"
+#include "display-mock.h"
+#include "edid.h"
+
+#include <libxfce4util/libxfce4util.h>
+#include <stdlib.h>
+
+#define MOCK_ENV "XFCE_DISPLAY_MOCK"
+#define MOCK_MAX_OUTPUTS 64
+
+
+
+static const DisplayMockMode mock_modes[] = {
+    { 3840, 2160, 60.0 },
+    { 3840, 2160, 30.0 },
+    { 2560, 1440, 144.0 },
+    { 2560, 1440, 60.0 },
+    { 1920, 1200, 60.0 },
+    { 1920, 1080, 144.0 },
+    { 1920, 1080, 60.0 },
+    { 1920, 1080, 50.0 },
+    { 1680, 1050, 60.0 },
+    { 1280, 1024, 60.0 },
+    { 1280, 720, 60.0 },
+    { 1024, 768, 60.0 },
+    { 800, 600, 60.0 },
+};
+
+
+
+static void
+display_mock_output_free (gpointer data)
+{
+    DisplayMockOutput *output = data;
+
+    g_free (output->name);
+    g_free (output->friendly_name);
+    g_free (output->edid);
+    g_free (output->modes);
+    g_free (output);
+}
+
+
+
+static GBytes *
+display_mock_parse_edid (const gchar *hex,
+                         GError **error)
+{
+    GByteArray *edid = g_byte_array_new ();
+    gint high = -1;
+
+    for (const gchar *p = hex; *p != '\0'; p++)
+    {
+        gint digit;
+        guint8 byte;
+
+        if (g_ascii_isspace (*p))
+            continue;
+
+        digit = g_ascii_xdigit_value (*p);
+        if (digit == -1)
+        {
+            g_set_error (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                         "Invalid character '%c' in EDID", *p);
+            g_byte_array_unref (edid);
+            return NULL;
+        }
+
+        if (high == -1)
+        {
+            high = digit;
+            continue;
+        }
+
+        byte = high << 4 | digit;
+        g_byte_array_append (edid, &byte, 1);
+        high = -1;
+    }
+
+    if (high != -1)
+    {
+        g_set_error_literal (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                             "EDID has an odd number of hex digits");
+        g_byte_array_unref (edid);
+        return NULL;
+    }
+
+    return g_byte_array_free_to_bytes (edid);
+}
+
+
+
+static gboolean
+display_mock_parse_modes (DisplayMockOutput *output,
+                          gchar **modes,
+                          GError **error)
+{
+    output->n_modes = g_strv_length (modes);
+    output->modes = g_new0 (DisplayMockMode, output->n_modes);
+
+    for (guint n = 0; n < output->n_modes; n++)
+    {
+        DisplayMockMode *mode = &output->modes[n];
+        gchar *end;
+
+        mode->width = strtoul (modes[n], &end, 10);
+        if (*end == 'x')
+            mode->height = strtoul (end + 1, &end, 10);
+        if (*end == '@')
+            mode->rate = g_ascii_strtod (end + 1, &end);
+
+        if (mode->width == 0 || mode->height == 0 || mode->rate <= 0.0 || *end != '\0')
+        {
+            g_set_error (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                         "Invalid mode \"%s\" for output %s, expected <width>x<height>@<rate>",
+                         modes[n], output->name);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+
+
+static DisplayMockOutput *
+display_mock_output_new_from_key_file (GKeyFile *key_file,
+                                       const gchar *group,
+                                       GError **error)
+{
+    DisplayMockOutput *output = g_new0 (DisplayMockOutput, 1);
+    const EdidInfo *edid_info = NULL;
+    gchar **modes;
+    gchar *value;
+
+    output->name = g_strdup (group);
+
+    modes = g_key_file_get_string_list (key_file, group, "Modes", NULL, error);
+    if (modes == NULL || modes[0] == NULL || !display_mock_parse_modes (output, modes, error))
+    {
+        if (modes != NULL && modes[0] == NULL)
+            g_set_error (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                         "Output %s has no modes", group);
+        g_strfreev (modes);
+        display_mock_output_free (output);
+        return NULL;
+    }
+    g_strfreev (modes);
+
+    value = g_key_file_get_string (key_file, group, "EDID", NULL);
+    if (value != NULL)
+    {
+        GBytes *edid = display_mock_parse_edid (value, error);
+
+        g_free (value);
+        if (edid == NULL)
+        {
+            display_mock_output_free (output);
+            return NULL;
+        }
+
+        /* like a real output, a short EDID is as good as none */
+        edid_info = edid_info_lookup (g_bytes_get_data (edid, NULL), g_bytes_get_size (edid));
+        g_bytes_unref (edid);
+    }
+
+    if (edid_info != NULL)
+    {
+        output->edid = g_strdup (edid_info->checksum);
+    }
+    else
+    {
+        gchar *edid = g_strdup_printf ("mock:%s", group);
+        output->edid = g_compute_checksum_for_string (G_CHECKSUM_SHA1, edid, -1);
+        g_free (edid);
+    }
+
+    /* the same order as xfce_randr_friendly_name() */
+    output->friendly_name = g_key_file_get_string (key_file, group, "Name", NULL);
+    if (output->friendly_name == NULL && display_name_is_laptop_name (group))
+        output->friendly_name = g_strdup (_("Laptop"));
+    if (output->friendly_name == NULL && edid_info != NULL)
+        output->friendly_name = g_strdup (edid_info->display_name);
+    if (output->friendly_name == NULL)
+        output->friendly_name = g_strdup (display_name_get_fallback (group));
+    if (output->friendly_name == NULL)
+        output->friendly_name = g_strdup (group);
+
+    return output;
+}
+
+
+
+static DisplayMock *
+display_mock_new_from_file (const gchar *filename,
+                            GError **error)
+{
+    GKeyFile *key_file = g_key_file_new ();
+    DisplayMock *mock;
+    gchar **groups;
+
+    if (!g_key_file_load_from_file (key_file, filename, G_KEY_FILE_NONE, error))
+    {
+        g_key_file_free (key_file);
+        return NULL;
+    }
+
+    mock = g_new0 (DisplayMock, 1);
+    mock->outputs = g_ptr_array_new_with_free_func (display_mock_output_free);
+
+    groups = g_key_file_get_groups (key_file, NULL);
+    for (guint n = 0; groups[n] != NULL; n++)
+    {
+        DisplayMockOutput *output;
+
+        if (g_strcmp0 (groups[n], "Mock") == 0)
+            continue;
+
+        output = display_mock_output_new_from_key_file (key_file, groups[n], error);
+        if (output == NULL)
+        {
+            display_mock_free (mock);
+            mock = NULL;
+            break;
+        }
+
+        g_ptr_array_add (mock->outputs, output);
+    }
+    g_strfreev (groups);
+
+    if (mock != NULL && mock->outputs->len == 0)
+    {
+        g_set_error (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_GROUP_NOT_FOUND,
+                     "No outputs in %s", filename);
+        display_mock_free (mock);
+        mock = NULL;
+    }
+
+    if (mock != NULL)
+    {
+        mock->n_crtcs = g_key_file_get_integer (key_file, "Mock", "CRTCs", NULL);
+        if (mock->n_crtcs == 0 || mock->n_crtcs > mock->outputs->len)
+            mock->n_crtcs = mock->outputs->len;
+
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Mock display backend: %u outputs, %u CRTCs from %s",
+                        mock->outputs->len, mock->n_crtcs, filename);
+    }
+
+    g_key_file_free (key_file);
+
+    return mock;
+}
+
+
+
+gboolean
+display_mock_enabled (void)
+{
+    const gchar *value = g_getenv (MOCK_ENV);
+
+    return value != NULL && *value != '\0';
+}
+
+
+
+/**
+ * display_mock_new:
+ * @error: return location for an error, or %NULL.
+ *
+ * Synthesize the outputs described by $XFCE_DISPLAY_MOCK, or load them
+ * from the fixture it names.
+ *
+ * Returns: the mock outputs, or %NULL if the mock is not enabled or the
+ *          fixture could not be loaded.
+ **/
+DisplayMock *
+display_mock_new (GError **error)
+{
+    const gchar *value = g_getenv (MOCK_ENV);
+    DisplayMock *mock;
+    gchar **fields;
+    guint n_outputs, n_crtcs, seed;
+
+    if (value == NULL || *value == '\0')
+    {
+        g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+                             "The mock display backend is not enabled");
+        return NULL;
+    }
+
+    if (g_file_test (value, G_FILE_TEST_IS_REGULAR))
+        return display_mock_new_from_file (value, error);
+
+    fields = g_strsplit (value, ":", 3);
+    n_outputs = CLAMP (strtoul (fields[0], NULL, 10), 1, MOCK_MAX_OUTPUTS);
+    n_crtcs = fields[1] != NULL ? CLAMP (strtoul (fields[1], NULL, 10), 1, n_outputs) : n_outputs;
+    seed = fields[1] != NULL && fields[2] != NULL ? strtoul (fields[2], NULL, 10) : 0;
+    g_strfreev (fields);
+
+    mock = g_new0 (DisplayMock, 1);
+    mock->n_crtcs = n_crtcs;
+    mock->outputs = g_ptr_array_new_with_free_func (display_mock_output_free);
+
+    for (guint n = 0; n < n_outputs; n++)
+    {
+        DisplayMockOutput *output = g_new0 (DisplayMockOutput, 1);
+        gchar *edid = g_strdup_printf ("mock:%u:%u", seed, n);
+        guint first = (n % 3) * 2;
+
+        output->name = g_strdup_printf ("MOCK-%u", n + 1);
+        output->friendly_name = g_strdup_printf ("Mock Display %u", n + 1);
+        output->edid = g_compute_checksum_for_string (G_CHECKSUM_SHA1, edid, -1);
+
+        /* mix 4K, 1440p and 1200p monitors */
+        output->n_modes = G_N_ELEMENTS (mock_modes) - first;
+        output->modes = g_memdup2 (mock_modes + first, output->n_modes * sizeof (DisplayMockMode));
+
+        g_ptr_array_add (mock->outputs, output);
+        g_free (edid);
+    }
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Mock display backend: %u outputs, %u CRTCs, seed %u",
+                    n_outputs, n_crtcs, seed);
+
+    return mock;
+}
+
+
+
+void
+display_mock_free (DisplayMock *mock)
+{
+    if (mock == NULL)
+        return;
+
+    g_ptr_array_unref (mock->outputs);
+    g_free (mock);
+}
+
+
+
+gchar **
+display_mock_get_display_infos (DisplayMock *mock)
+{
+    gchar **display_infos = g_new0 (gchar *, mock->outputs->len + 1);
+
+    for (guint n = 0; n < mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (mock->outputs, n);
+        display_infos[n] = g_strdup (output->edid);
+    }
+
+    return display_infos;
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __DISPLAY_MOCK_H__
+#define __DISPLAY_MOCK_H__
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+/* profiles of mock outputs never end up in the real channels */
+#define DISPLAYS_CHANNEL_MOCK "displays-mock"
+
+typedef struct _DisplayMockMode
+{
+    guint width;
+    guint height;
+    gdouble rate;
+} DisplayMockMode;
+
+typedef struct _DisplayMockOutput
+{
+    gchar *name;
+    gchar *friendly_name;
+
+    /* SHA-1 checksum, like the EDID of a real output */
+    gchar *edid;
+
+    /* largest first, the first one is preferred */
+    DisplayMockMode *modes;
+    guint n_modes;
+} DisplayMockOutput;
+
+typedef struct _DisplayMock
+{
+    GPtrArray *outputs;
+
+    /* at most this many outputs can be active at once */
+    guint n_crtcs;
+} DisplayMock;
+
+gboolean
+display_mock_enabled (void);
+
+DisplayMock *
+display_mock_new (GError **error);
+void
+display_mock_free (DisplayMock *mock);
+
+gchar **
+display_mock_get_display_infos (DisplayMock *mock);
+
+G_END_DECLS
+
+#endif /* !__DISPLAY_MOCK_H__ */
@@ -29,54 +29,647 @@
 #include <gdk/gdkwayland.h>
 #endif
 
+#include "debug.h"
 #include "display-profiles.h"
 
+#ifdef ENABLE_DISPLAY_MOCK
+#include "display-mock.h"
+#endif
+
 #define DISPLAYS_CHANNEL_X11 "displays"
+#define APPLY_SCHEME_PROP "/Schemes/Apply"
 
 #ifdef ENABLE_WAYLAND
 #define DISPLAYS_CHANNEL_WAYLAND "displays-wl"
 #define PROP_X11_MIGRATION_DONE "/X11MigrationDone"
 #endif
 
+/* a profile as seen by the index, keyed by its id in the channel */
+typedef struct _DisplayProfile
+{
+    gchar *name;
+    gboolean is_user_profile;
+
+    /* sorted EDIDs of the profile outputs joined by newlines, NULL if the
+     * profile has no outputs or one of them has no EDID */
+    gchar *edid_set;
+
+    /* only used while parsing */
+    GPtrArray *edids;
+    gboolean incomplete;
+} DisplayProfile;
+
+typedef struct _DisplayProfilesIndex
+{
+    XfconfChannel *channel;
+
+    /* profile id → table of the properties parse_profiles() looks at, kept
+     * up to date from property-changed so no profile is ever read twice */
+    GHashTable *props;
+
+    /* profile id → DisplayProfile */
+    GHashTable *profiles;
+
+    /* edid set → GPtrArray of profile ids */
+    GHashTable *edid_sets;
+
+    /* ids of the profiles changed since the last lookup */
+    GHashTable *stale;
+
+    /* set while the channel is read, with the tasks waiting for it and the
+     * properties changed meanwhile, property → GValue, unset if removed */
+    gboolean loading;
+    gint64 load_start_time;
+    GList *load_tasks;
+    GHashTable *pending;
+} DisplayProfilesIndex;
+
+#define PROFILES_INDEX_KEY "display-profiles-index"
+
+/* what the index is filled with once the channel was read, see
+ * profiles_load_new() */
+typedef struct _DisplayProfilesLoad
+{
+    /* same as DisplayProfilesIndex.props and .profiles */
+    GHashTable *props;
+    GHashTable *profiles;
+} DisplayProfilesLoad;
+
+struct _DisplayProfileWriter
+{
+    XfconfChannel *channel;
+    gchar *root;
+
+    /* remove the properties below root that were not written */
+    gboolean replace;
+
+    /* property → GValue */
+    GHashTable *values;
+
+    /* scheme to apply once the properties are written */
+    gchar *apply;
+};
+
+
+
+static void
+profile_value_free (gpointer data)
+{
+    GValue *value = data;
+
+    g_value_unset (value);
+    g_free (value);
+}
+
+
+
+static void
+display_profile_free (gpointer data)
+{
+    DisplayProfile *profile = data;
+
+    if (profile->edids != NULL)
+        g_ptr_array_unref (profile->edids);
+    g_free (profile->name);
+    g_free (profile->edid_set);
+    g_free (profile);
+}
+
+
+
+static gint
+compare_strings (gconstpointer a,
+                 gconstpointer b)
+{
+    return g_strcmp0 (*(const gchar **) a, *(const gchar **) b);
+}
+
+
+
+static gchar *
+make_edid_set (GPtrArray *edids)
+{
+    gchar *edid_set;
+
+    if (edids->len == 0)
+        return NULL;
+
+    g_ptr_array_sort (edids, compare_strings);
+    g_ptr_array_add (edids, NULL);
+    edid_set = g_strjoinv ("\n", (gchar **) edids->pdata);
+    g_ptr_array_remove_index (edids, edids->len - 1);
+
+    return edid_set;
+}
+
+
+
+static gchar *
+display_infos_get_edid_set (gchar **display_infos)
+{
+    GPtrArray *edids;
+    gchar *edid_set;
+
+    if (display_infos == NULL)
+        return NULL;
+
+    edids = g_ptr_array_new ();
+    for (guint i = 0; display_infos[i] != NULL; i++)
+        g_ptr_array_add (edids, display_infos[i]);
+    edid_set = make_edid_set (edids);
+    g_ptr_array_unref (edids);
+
+    return edid_set;
+}
+
+
+
+/* Collect the profiles found in a property table of the channel. Every
+ * "/<id>" tree is a profile; its outputs are the "/<id>/<output>" properties
+ * and it is a user profile if "/<id>", the profile name, is set and at least
+ * one output has an EDID. */
+static GHashTable *
+parse_profiles (GHashTable *props)
+{
+    GHashTable *profiles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, display_profile_free);
+    GHashTableIter iter;
+    gpointer key, value;
+
+    g_hash_table_iter_init (&iter, props);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        const gchar *property = key;
+        const gchar *output;
+        DisplayProfile *profile;
+        gchar *id;
+
+        if (property[0] != '/' || property[1] == '\0')
+            continue;
+
+        output = strchr (property + 1, '/');
+        id = output != NULL ? g_strndup (property + 1, output - property - 1) : g_strdup (property + 1);
+
+        profile = g_hash_table_lookup (profiles, id);
+        if (profile == NULL)
+        {
+            profile = g_new0 (DisplayProfile, 1);
+            profile->edids = g_ptr_array_new ();
+            g_hash_table_insert (profiles, id, profile);
+        }
+        else
+        {
+            g_free (id);
+        }
+
+        if (output == NULL)
+        {
+            if (G_VALUE_HOLDS_STRING (value))
+                profile->name = g_value_dup_string (value);
+            profile->is_user_profile = TRUE;
+        }
+        else if (output[1] != '\0' && strchr (output + 1, '/') == NULL)
+        {
+            gchar *prop = g_strconcat (property, "/EDID", NULL);
+            const GValue *edid = g_hash_table_lookup (props, prop);
+
+            if (edid != NULL && G_VALUE_HOLDS_STRING (edid) && g_value_get_string (edid) != NULL)
+                g_ptr_array_add (profile->edids, (gpointer) g_value_get_string (edid));
+            else
+                profile->incomplete = TRUE;
+
+            g_free (prop);
+        }
+    }
+
+    g_hash_table_iter_init (&iter, profiles);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+        DisplayProfile *profile = value;
+
+        if (profile->edids->len == 0)
+            profile->is_user_profile = FALSE;
+        else if (!profile->incomplete)
+            profile->edid_set = make_edid_set (profile->edids);
+
+        /* the EDIDs are owned by props */
+        g_ptr_array_unref (profile->edids);
+        profile->edids = NULL;
+    }
+
+    return profiles;
+}
+
+
+
 static gboolean
-is_user_profile (const gchar *property,
-                 XfconfChannel *channel)
+profiles_have_name (GHashTable *profiles,
+                    const gchar *name)
 {
-    GHashTable *props = xfconf_channel_get_properties (channel, property);
-    gboolean is_user_profile = FALSE;
+    GHashTableIter iter;
+    gpointer value;
 
-    if (g_hash_table_size (props) > 1 && g_strrstr_len (property, -1, "/") == property)
+    g_hash_table_iter_init (&iter, profiles);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
     {
-        GHashTableIter iter;
-        gpointer key;
-        g_hash_table_iter_init (&iter, props);
-        while (g_hash_table_iter_next (&iter, &key, NULL))
+        DisplayProfile *profile = value;
+        if (profile->is_user_profile && g_strcmp0 (name, profile->name) == 0)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+
+static void
+profiles_index_remove (DisplayProfilesIndex *index,
+                       const gchar *id)
+{
+    DisplayProfile *profile = g_hash_table_lookup (index->profiles, id);
+
+    if (profile == NULL)
+        return;
+
+    if (profile->edid_set != NULL)
+    {
+        GPtrArray *ids = g_hash_table_lookup (index->edid_sets, profile->edid_set);
+        guint i;
+
+        if (ids != NULL && g_ptr_array_find_with_equal_func (ids, id, g_str_equal, &i))
+        {
+            g_ptr_array_remove_index_fast (ids, i);
+            if (ids->len == 0)
+                g_hash_table_remove (index->edid_sets, profile->edid_set);
+        }
+    }
+
+    g_hash_table_remove (index->profiles, id);
+}
+
+
+
+static void
+profiles_index_add (DisplayProfilesIndex *index,
+                    GHashTable *profiles)
+{
+    GHashTableIter iter;
+    gpointer key, value;
+
+    g_hash_table_iter_init (&iter, profiles);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        DisplayProfile *profile = value;
+
+        g_hash_table_iter_steal (&iter);
+        profiles_index_remove (index, key);
+
+        if (profile->edid_set != NULL)
         {
-            gchar **tokens = g_strsplit (key, "/", -1);
-            gboolean maybe_output_name = g_strv_length (tokens) == 3;
-            g_strfreev (tokens);
-            if (maybe_output_name)
+            GPtrArray *ids = g_hash_table_lookup (index->edid_sets, profile->edid_set);
+            if (ids == NULL)
             {
-                gchar *prop = g_strdup_printf ("%s/EDID", (gchar *) key);
-                gchar *edid = xfconf_channel_get_string (channel, prop, NULL);
-                g_free (prop);
-                if (edid != NULL)
-                {
-                    is_user_profile = TRUE;
-                    g_free (edid);
-                    break;
-                }
+                ids = g_ptr_array_new_with_free_func (g_free);
+                g_hash_table_insert (index->edid_sets, g_strdup (profile->edid_set), ids);
             }
+            g_ptr_array_add (ids, g_strdup (key));
         }
+
+        g_hash_table_insert (index->profiles, key, profile);
     }
-    g_hash_table_destroy (props);
+}
+
+
+
+/* The id of the profile @property belongs to, or NULL if the index does not
+ * need @property: only the profile name, the outputs and their EDIDs are
+ * looked at. */
+static gchar *
+profile_property_get_id (const gchar *property)
+{
+    const gchar *output, *leaf;
+
+    if (property[0] != '/' || property[1] == '\0')
+        return NULL;
+
+    output = strchr (property + 1, '/');
+    if (output == NULL)
+        return g_strdup (property + 1);
+
+    leaf = strchr (output + 1, '/');
+    if (leaf != NULL && strcmp (leaf, "/EDID") != 0)
+        return NULL;
+
+    return g_strndup (property + 1, output - property - 1);
+}
+
+
+
+static void
+profiles_index_set_property (DisplayProfilesIndex *index,
+                             const gchar *id,
+                             const gchar *property,
+                             const GValue *value)
+{
+    GHashTable *props = g_hash_table_lookup (index->props, id);
+
+    if (value != NULL && G_VALUE_TYPE (value) != G_TYPE_INVALID)
+    {
+        GValue *copy = g_new0 (GValue, 1);
+
+        if (props == NULL)
+        {
+            props = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, profile_value_free);
+            g_hash_table_insert (index->props, g_strdup (id), props);
+        }
+
+        g_value_init (copy, G_VALUE_TYPE (value));
+        g_value_copy (value, copy);
+        g_hash_table_replace (props, g_strdup (property), copy);
+    }
+    else if (props != NULL)
+    {
+        g_hash_table_remove (props, property);
+        if (g_hash_table_size (props) == 0)
+            g_hash_table_remove (index->props, id);
+    }
+
+    /* parsed again on the next lookup */
+    g_hash_table_add (index->stale, g_strdup (id));
+}
+
+
+
+/* Group the properties of the channel by profile and parse every profile,
+ * without touching the index, so that it can run in a worker thread. */
+static DisplayProfilesLoad *
+profiles_load_new (GHashTable *channel_props)
+{
+    DisplayProfilesLoad *load = g_new0 (DisplayProfilesLoad, 1);
+    GHashTableIter iter;
+    gpointer key, value;
+
+    load->props = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_destroy);
+    load->profiles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, display_profile_free);
+
+    if (channel_props == NULL)
+        return load;
+
+    g_hash_table_iter_init (&iter, channel_props);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        gchar *id = profile_property_get_id (key);
+        GHashTable *props;
+        GValue *copy;
+
+        if (id == NULL)
+            continue;
+
+        props = g_hash_table_lookup (load->props, id);
+        if (props == NULL)
+        {
+            props = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, profile_value_free);
+            g_hash_table_insert (load->props, id, props);
+        }
+        else
+        {
+            g_free (id);
+        }
+
+        copy = g_new0 (GValue, 1);
+        g_value_init (copy, G_VALUE_TYPE ((GValue *) value));
+        g_value_copy (value, copy);
+        g_hash_table_insert (props, g_strdup (key), copy);
+    }
+
+    /* parsed per profile like the stale ones in profiles_index_get() */
+    g_hash_table_iter_init (&iter, load->props);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+        GHashTable *profiles = parse_profiles (value);
+        GHashTableIter profile_iter;
+        gpointer id, profile;
+
+        g_hash_table_iter_init (&profile_iter, profiles);
+        while (g_hash_table_iter_next (&profile_iter, &id, &profile))
+        {
+            g_hash_table_iter_steal (&profile_iter);
+            g_hash_table_replace (load->profiles, id, profile);
+        }
+        g_hash_table_destroy (profiles);
+    }
+
+    return load;
+}
+
+
+
+static void
+profiles_load_free (gpointer data)
+{
+    DisplayProfilesLoad *load = data;
+
+    g_hash_table_destroy (load->props);
+    g_hash_table_destroy (load->profiles);
+    g_free (load);
+}
+
+
+
+static void
+profiles_index_finish_load (DisplayProfilesIndex *index,
+                            DisplayProfilesLoad *load)
+{
+    GHashTableIter iter;
+    gpointer key, value;
+    GList *tasks;
+
+    if (load != NULL)
+    {
+        /* the index is empty until the first load */
+        g_hash_table_iter_init (&iter, load->props);
+        while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+            g_hash_table_iter_steal (&iter);
+            g_hash_table_replace (index->props, key, value);
+        }
+        profiles_index_add (index, load->profiles);
+    }
+
+    /* the read may or may not include the changes made meanwhile, replaying
+     * them leaves every property with its latest value */
+    g_hash_table_iter_init (&iter, index->pending);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        gchar *id = profile_property_get_id (key);
+
+        profiles_index_set_property (index, id, key, value);
+        g_free (id);
+    }
+    g_hash_table_remove_all (index->pending);
+    index->loading = FALSE;
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "read %u display profiles in %.1f ms",
+                    g_hash_table_size (index->props),
+                    (g_get_monotonic_time () - index->load_start_time) / 1000.0);
+
+    tasks = g_list_reverse (index->load_tasks);
+    index->load_tasks = NULL;
+    for (GList *lp = tasks; lp != NULL; lp = lp->next)
+    {
+        g_task_return_boolean (lp->data, TRUE);
+        g_object_unref (lp->data);
+    }
+    g_list_free (tasks);
+}
+
+
+
+/* xfconf is only used from the main thread, the worker gets the properties
+ * it read as task data */
+static void
+profiles_index_load_thread (GTask *task,
+                            gpointer source_object,
+                            gpointer task_data,
+                            GCancellable *cancellable)
+{
+    g_task_return_pointer (task, profiles_load_new (task_data), profiles_load_free);
+}
+
+
+
+static void
+profiles_index_loaded (GObject *source,
+                       GAsyncResult *result,
+                       gpointer user_data)
+{
+    DisplayProfilesIndex *index = g_object_get_data (source, PROFILES_INDEX_KEY);
+    DisplayProfilesLoad *load = g_task_propagate_pointer (G_TASK (result), NULL);
+
+    /* display_settings_profiles_load() may have read the channel meanwhile */
+    if (index->loading)
+        profiles_index_finish_load (index, load);
+
+    profiles_load_free (load);
+}
+
+
+
+static void
+profiles_index_property_changed (XfconfChannel *channel,
+                                 const gchar *property,
+                                 const GValue *value,
+                                 DisplayProfilesIndex *index)
+{
+    gchar *id = profile_property_get_id (property);
+
+    if (id == NULL)
+        return;
+
+    if (index->loading)
+    {
+        GValue *copy = g_new0 (GValue, 1);
 
-    return is_user_profile;
+        if (value != NULL && G_VALUE_TYPE (value) != G_TYPE_INVALID)
+        {
+            g_value_init (copy, G_VALUE_TYPE (value));
+            g_value_copy (value, copy);
+        }
+        g_hash_table_replace (index->pending, g_strdup (property), copy);
+    }
+    else
+    {
+        profiles_index_set_property (index, id, property, value);
+    }
+
+    g_free (id);
+}
+
+
+
+static void
+profiles_index_free (gpointer data)
+{
+    DisplayProfilesIndex *index = data;
+
+    g_hash_table_destroy (index->props);
+    g_hash_table_destroy (index->profiles);
+    g_hash_table_destroy (index->edid_sets);
+    g_hash_table_destroy (index->stale);
+    g_hash_table_destroy (index->pending);
+    g_free (index);
+}
+
+
+
+static DisplayProfilesIndex *
+profiles_index_new (XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index = g_new0 (DisplayProfilesIndex, 1);
+
+    index->channel = channel;
+    index->props = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_destroy);
+    index->profiles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, display_profile_free);
+    index->edid_sets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+    index->stale = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    index->pending = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, profile_value_free);
+    index->loading = TRUE;
+    index->load_start_time = g_get_monotonic_time ();
+
+    g_object_set_data_full (G_OBJECT (channel), PROFILES_INDEX_KEY, index, profiles_index_free);
+    g_signal_connect (G_OBJECT (channel), "property-changed",
+                      G_CALLBACK (profiles_index_property_changed), index);
+
+    return index;
+}
+
+
+
+/* The index of the profiles in @channel, kept in sync with the channel once
+ * it was read, so matching never needs a D-Bus round-trip. NULL until one of
+ * display_settings_profiles_load() or display_settings_profiles_load_async()
+ * is done, the lookups then behave as if there were no profiles. */
+static DisplayProfilesIndex *
+profiles_index_get (XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index = g_object_get_data (G_OBJECT (channel), PROFILES_INDEX_KEY);
+    GHashTableIter iter;
+    gpointer key;
+
+    if (index == NULL || index->loading)
+        return NULL;
+
+    /* parse the changed profiles again */
+    g_hash_table_iter_init (&iter, index->stale);
+    while (g_hash_table_iter_next (&iter, &key, NULL))
+    {
+        GHashTable *props = g_hash_table_lookup (index->props, key);
+
+        profiles_index_remove (index, key);
+        if (props != NULL)
+        {
+            GHashTable *profiles = parse_profiles (props);
+            profiles_index_add (index, profiles);
+            g_hash_table_destroy (profiles);
+        }
+
+        g_hash_table_iter_remove (&iter);
+    }
+
+    return index;
 }
 
+
+
 XfconfChannel *
 display_settings_profiles_channel_get (void)
 {
+#ifdef ENABLE_DISPLAY_MOCK
+    if (display_mock_enabled ())
+    {
+        return xfconf_channel_get (DISPLAYS_CHANNEL_MOCK);
+    }
+#endif
+
 #ifdef ENABLE_X11
     if (GDK_IS_X11_DISPLAY (gdk_display_get_default ()))
     {
@@ -94,27 +687,126 @@ display_settings_profiles_channel_get (void)
     g_error ("No supported windowing system for current environment");
 }
 
+/**
+ * display_settings_profiles_load:
+ * @channel: the displays channel.
+ *
+ * Read the profiles of @channel, blocking until xfconf replied. This is for
+ * xfsettingsd, which cannot configure the outputs without them, the dialogs
+ * use display_settings_profiles_load_async().
+ **/
+void
+display_settings_profiles_load (XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index;
+    DisplayProfilesLoad *load;
+    GHashTable *props;
+
+    g_return_if_fail (XFCONF_IS_CHANNEL (channel));
+
+    index = g_object_get_data (G_OBJECT (channel), PROFILES_INDEX_KEY);
+    if (index == NULL)
+        index = profiles_index_new (channel);
+    else if (!index->loading)
+        return;
+
+    /* NULL if the channel does not exist yet */
+    props = xfconf_channel_get_properties (channel, NULL);
+    load = profiles_load_new (props);
+    profiles_index_finish_load (index, load);
+    profiles_load_free (load);
+    if (props != NULL)
+        g_hash_table_destroy (props);
+}
+
+/**
+ * display_settings_profiles_load_async:
+ * @channel: the displays channel.
+ * @cancellable: a #GCancellable, or %NULL.
+ * @callback: called once the profiles of @channel are known.
+ * @user_data: data for @callback.
+ *
+ * Read the properties of @channel and index its profiles in a worker
+ * thread; xfconf itself is only queried from the calling thread. Until
+ * @callback ran, the profile lookups below find no profiles; after that they
+ * only look at memory.
+ **/
+void
+display_settings_profiles_load_async (XfconfChannel *channel,
+                                      GCancellable *cancellable,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data)
+{
+    DisplayProfilesIndex *index;
+    GTask *task;
+
+    g_return_if_fail (XFCONF_IS_CHANNEL (channel));
+
+    task = g_task_new (channel, cancellable, callback, user_data);
+    g_task_set_source_tag (task, display_settings_profiles_load_async);
+
+    index = g_object_get_data (G_OBJECT (channel), PROFILES_INDEX_KEY);
+    if (index == NULL)
+    {
+        GTask *load = g_task_new (channel, NULL, profiles_index_loaded, NULL);
+        GHashTable *props = xfconf_channel_get_properties (channel, NULL);
+
+        /* NULL if the channel does not exist yet */
+        if (props != NULL)
+            g_task_set_task_data (load, props, (GDestroyNotify) g_hash_table_destroy);
+        index = profiles_index_new (channel);
+        g_task_run_in_thread (load, profiles_index_load_thread);
+        g_object_unref (load);
+    }
+
+    if (index->loading)
+    {
+        index->load_tasks = g_list_prepend (index->load_tasks, task);
+    }
+    else
+    {
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+    }
+}
+
+gboolean
+display_settings_profiles_load_finish (XfconfChannel *channel,
+                                       GAsyncResult *result,
+                                       GError **error)
+{
+    g_return_val_if_fail (g_task_is_valid (result, channel), FALSE);
+
+    return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+gboolean
+display_settings_profiles_loaded (XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index = g_object_get_data (G_OBJECT (channel), PROFILES_INDEX_KEY);
+
+    return index != NULL && !index->loading;
+}
+
 gboolean
 display_settings_profile_name_exists (XfconfChannel *channel,
                                       const gchar *new_profile_name)
 {
-    GHashTable *props = xfconf_channel_get_properties (channel, NULL);
-    GHashTableIter iter;
-    gpointer key;
-    gboolean exists = FALSE;
+    DisplayProfilesIndex *index = profiles_index_get (channel);
+    GHashTable *props, *profiles;
+    gboolean exists;
 
-    g_hash_table_iter_init (&iter, props);
-    while (g_hash_table_iter_next (&iter, &key, NULL))
-    {
-        if (is_user_profile (key, channel))
-        {
-            gchar *old_profile_name = xfconf_channel_get_string (channel, key, NULL);
-            exists = g_strcmp0 (new_profile_name, old_profile_name) == 0;
-            g_free (old_profile_name);
-            if (exists)
-                break;
-        }
-    }
+    if (index != NULL)
+        return profiles_have_name (index->profiles, new_profile_name);
+
+    /* still loading, a duplicate name must not slip through meanwhile */
+    props = xfconf_channel_get_properties (channel, NULL);
+    if (props == NULL)
+        return FALSE;
+
+    profiles = parse_profiles (props);
+    exists = profiles_have_name (profiles, new_profile_name);
+    g_hash_table_destroy (profiles);
     g_hash_table_destroy (props);
 
     return exists;
@@ -125,25 +817,40 @@ display_settings_get_profiles (gchar **display_infos,
                                XfconfChannel *channel,
                                gboolean matching_only)
 {
-    GHashTable *props = xfconf_channel_get_properties (channel, NULL);
+    DisplayProfilesIndex *index = profiles_index_get (channel);
     GList *profiles = NULL;
-    GHashTableIter iter;
-    gpointer key;
 
-    g_hash_table_iter_init (&iter, props);
-    while (g_hash_table_iter_next (&iter, &key, NULL))
+    if (index == NULL)
+        return NULL;
+
+    if (matching_only)
     {
-        if (is_user_profile (key, channel))
+        /* look up the profiles with exactly the current set of EDIDs */
+        gchar *edid_set = display_infos_get_edid_set (display_infos);
+        GPtrArray *ids = edid_set != NULL ? g_hash_table_lookup (index->edid_sets, edid_set) : NULL;
+
+        for (guint i = 0; ids != NULL && i < ids->len; i++)
         {
-            const gchar *profile = (gchar *) key + 1; /* remove leading '/' */
-            if (!matching_only || display_settings_profile_matches (profile, display_infos, channel))
-            {
-                profiles = g_list_prepend (profiles, g_strdup (profile));
-            }
+            DisplayProfile *profile = g_hash_table_lookup (index->profiles, g_ptr_array_index (ids, i));
+            if (profile->is_user_profile)
+                profiles = g_list_prepend (profiles, g_strdup (g_ptr_array_index (ids, i)));
         }
+
+        g_free (edid_set);
     }
+    else
+    {
+        GHashTableIter iter;
+        gpointer key, value;
 
-    g_hash_table_destroy (props);
+        g_hash_table_iter_init (&iter, index->profiles);
+        while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+            DisplayProfile *profile = value;
+            if (profile->is_user_profile)
+                profiles = g_list_prepend (profiles, g_strdup (key));
+        }
+    }
 
     return profiles;
 }
@@ -153,57 +860,301 @@ display_settings_profile_matches (const gchar *profile,
                                   gchar **display_infos,
                                   XfconfChannel *channel)
 {
-    /* Walk through the profile and check if every EDID referenced there is also currently available */
-    gchar *profile_prop = g_strdup_printf ("/%s", profile);
-    GHashTable *props = xfconf_channel_get_properties (channel, profile_prop);
+    /* check if the profile references exactly the EDIDs currently available */
+    DisplayProfilesIndex *index = profiles_index_get (channel);
+    DisplayProfile *entry = index != NULL ? g_hash_table_lookup (index->profiles, profile) : NULL;
+    gchar *edid_set;
+    gboolean matches;
+
+    if (entry == NULL || entry->edid_set == NULL)
+        return FALSE;
+
+    edid_set = display_infos_get_edid_set (display_infos);
+    matches = g_strcmp0 (edid_set, entry->edid_set) == 0;
+    g_free (edid_set);
+
+    return matches;
+}
+
+gchar *
+display_settings_profile_get_name (const gchar *profile,
+                                   XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index = profiles_index_get (channel);
+    DisplayProfile *entry = index != NULL ? g_hash_table_lookup (index->profiles, profile) : NULL;
+
+    return entry != NULL ? g_strdup (entry->name) : NULL;
+}
+
+gboolean
+display_settings_profile_exists (const gchar *profile,
+                                 XfconfChannel *channel)
+{
+    DisplayProfilesIndex *index = profiles_index_get (channel);
+    DisplayProfile *entry = index != NULL ? g_hash_table_lookup (index->profiles, profile) : NULL;
+
+    return entry != NULL && entry->is_user_profile;
+}
+
+static gboolean
+profile_values_equal (const GValue *a,
+                      const GValue *b)
+{
+    if (G_VALUE_TYPE (a) != G_VALUE_TYPE (b))
+        return FALSE;
+
+    switch (G_VALUE_TYPE (a))
+    {
+        case G_TYPE_STRING: return g_strcmp0 (g_value_get_string (a), g_value_get_string (b)) == 0;
+        case G_TYPE_BOOLEAN: return g_value_get_boolean (a) == g_value_get_boolean (b);
+        case G_TYPE_INT: return g_value_get_int (a) == g_value_get_int (b);
+        case G_TYPE_UINT: return g_value_get_uint (a) == g_value_get_uint (b);
+        case G_TYPE_INT64: return g_value_get_int64 (a) == g_value_get_int64 (b);
+        case G_TYPE_UINT64: return g_value_get_uint64 (a) == g_value_get_uint64 (b);
+        case G_TYPE_DOUBLE: return g_value_get_double (a) == g_value_get_double (b);
+        default: return FALSE;
+    }
+}
+
+
+
+/**
+ * display_profile_writer_new:
+ * @channel: the displays channel.
+ * @root: the root property of the profile, e.g. "/Default".
+ * @replace: whether properties below @root that are not written should be
+ *           removed on commit.
+ *
+ * Start collecting the properties of a profile. Nothing is sent to xfconf
+ * before display_profile_writer_commit().
+ *
+ * Returns: a new writer, freed by display_profile_writer_commit().
+ **/
+DisplayProfileWriter *
+display_profile_writer_new (XfconfChannel *channel,
+                            const gchar *root,
+                            gboolean replace)
+{
+    DisplayProfileWriter *writer;
+
+    g_return_val_if_fail (XFCONF_IS_CHANNEL (channel), NULL);
+    g_return_val_if_fail (root != NULL && root[0] == '/', NULL);
+
+    writer = g_new0 (DisplayProfileWriter, 1);
+    writer->channel = g_object_ref (channel);
+    writer->root = g_strdup (root);
+    writer->replace = replace;
+    writer->values = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, profile_value_free);
+
+    return writer;
+}
+
+
+
+void
+display_profile_writer_set_value (DisplayProfileWriter *writer,
+                                  const gchar *property,
+                                  const GValue *value)
+{
+    GValue *copy;
+
+    g_return_if_fail (writer != NULL && property != NULL);
+    g_return_if_fail (G_IS_VALUE (value));
+
+    copy = g_new0 (GValue, 1);
+    g_value_init (copy, G_VALUE_TYPE (value));
+    g_value_copy (value, copy);
+    g_hash_table_replace (writer->values, g_strdup (property), copy);
+}
+
+
+
+void
+display_profile_writer_set_string (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   const gchar *value)
+{
+    GValue val = G_VALUE_INIT;
+
+    g_value_init (&val, G_TYPE_STRING);
+    g_value_set_static_string (&val, value);
+    display_profile_writer_set_value (writer, property, &val);
+}
+
+
+
+void
+display_profile_writer_set_bool (DisplayProfileWriter *writer,
+                                 const gchar *property,
+                                 gboolean value)
+{
+    GValue val = G_VALUE_INIT;
+
+    g_value_init (&val, G_TYPE_BOOLEAN);
+    g_value_set_boolean (&val, value);
+    display_profile_writer_set_value (writer, property, &val);
+}
+
+
+
+void
+display_profile_writer_set_int (DisplayProfileWriter *writer,
+                                const gchar *property,
+                                gint value)
+{
+    GValue val = G_VALUE_INIT;
+
+    g_value_init (&val, G_TYPE_INT);
+    g_value_set_int (&val, value);
+    display_profile_writer_set_value (writer, property, &val);
+}
+
+
+
+void
+display_profile_writer_set_uint64 (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   guint64 value)
+{
+    GValue val = G_VALUE_INIT;
+
+    g_value_init (&val, G_TYPE_UINT64);
+    g_value_set_uint64 (&val, value);
+    display_profile_writer_set_value (writer, property, &val);
+}
+
+
+
+void
+display_profile_writer_set_double (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   gdouble value)
+{
+    GValue val = G_VALUE_INIT;
+
+    g_value_init (&val, G_TYPE_DOUBLE);
+    g_value_set_double (&val, value);
+    display_profile_writer_set_value (writer, property, &val);
+}
+
+
+
+/**
+ * display_profile_writer_apply:
+ * @writer: a #DisplayProfileWriter.
+ * @scheme: the scheme xfsettingsd should apply.
+ *
+ * Ask xfsettingsd to apply @scheme as part of the batch, so it is applied
+ * only once all properties of the batch are written.
+ **/
+void
+display_profile_writer_apply (DisplayProfileWriter *writer,
+                              const gchar *scheme)
+{
+    g_return_if_fail (writer != NULL && scheme != NULL);
+
+    g_free (writer->apply);
+    writer->apply = g_strdup (scheme);
+}
+
+
+
+/**
+ * display_profile_writer_commit:
+ * @writer: a #DisplayProfileWriter.
+ *
+ * Write the collected properties and free @writer. The current values are
+ * read with a single query and only the properties that changed are sent;
+ * xfsettingsd holds back apply requests until the batch is done.
+ *
+ * Returns: %TRUE if every changed property was written.
+ **/
+gboolean
+display_profile_writer_commit (DisplayProfileWriter *writer)
+{
+    GHashTable *old_values;
     GHashTableIter iter;
-    gpointer key;
-    guint n_infos = g_strv_length (display_infos);
-    guint n_outputs = 0;
-    gboolean all_match = FALSE;
+    gpointer key, value;
+    guint n_changed = 0, n_removed = 0;
+    gboolean succeeded = TRUE;
+    gint64 start = g_get_monotonic_time ();
 
-    g_hash_table_iter_init (&iter, props);
-    while (g_hash_table_iter_next (&iter, &key, NULL))
+    g_return_val_if_fail (writer != NULL, FALSE);
+
+    old_values = xfconf_channel_get_properties (writer->channel, writer->root);
+
+    xfconf_channel_set_string (writer->channel, PROFILE_BATCH_PROP, writer->root);
+
+    if (writer->replace && old_values != NULL)
     {
-        gchar **tokens = g_strsplit (key, "/", -1);
-        gboolean is_output_name = g_strv_length (tokens) == 3;
-        g_strfreev (tokens);
-        if (is_output_name)
+        g_hash_table_iter_init (&iter, old_values);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
         {
-            gchar *property;
-            gchar *edid;
-            if (++n_outputs > n_infos)
-                break;
-
-            property = g_strdup_printf ("%s/EDID", (gchar *) key);
-            edid = xfconf_channel_get_string (channel, property, NULL);
-            all_match = g_strv_contains ((const gchar *const *) display_infos, edid);
-            g_free (edid);
-            g_free (property);
-            if (!all_match)
-                break;
+            if (!g_hash_table_contains (writer->values, key))
+            {
+                xfconf_channel_reset_property (writer->channel, key, FALSE);
+                n_removed++;
+            }
         }
     }
-    g_hash_table_destroy (props);
-    g_free (profile_prop);
 
-    return all_match && n_outputs == n_infos;
+    g_hash_table_iter_init (&iter, writer->values);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        const GValue *old_value = old_values != NULL ? g_hash_table_lookup (old_values, key) : NULL;
+
+        if (old_value == NULL || !profile_values_equal (old_value, value))
+        {
+            if (!xfconf_channel_set_property (writer->channel, key, value))
+                succeeded = FALSE;
+            n_changed++;
+        }
+    }
+
+    if (writer->apply != NULL)
+        xfconf_channel_set_string (writer->channel, APPLY_SCHEME_PROP, writer->apply);
+
+    xfconf_channel_reset_property (writer->channel, PROFILE_BATCH_PROP, FALSE);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "saved %s: %u changed, %u removed, %u unchanged (%.1f ms)",
+                    writer->root, n_changed, n_removed,
+                    g_hash_table_size (writer->values) - n_changed,
+                    (g_get_monotonic_time () - start) / 1000.0);
+
+    if (old_values != NULL)
+        g_hash_table_destroy (old_values);
+    g_hash_table_destroy (writer->values);
+    g_object_unref (writer->channel);
+    g_free (writer->root);
+    g_free (writer->apply);
+    g_free (writer);
+
+    return succeeded;
 }
 
+
+
 #ifdef ENABLE_WAYLAND
 
-static void
+static gboolean
 migrate_profile (XfconfChannel *x11_channel,
                  XfconfChannel *wl_channel,
                  const gchar *profile_root_prop,
                  gint ui_scale_factor)
 {
     GHashTable *properties = xfconf_channel_get_properties (x11_channel, profile_root_prop);
+    if (properties == NULL)
+    {
+        /* nothing to copy */
+        return TRUE;
+    }
+
+    DisplayProfileWriter *writer = display_profile_writer_new (wl_channel, profile_root_prop, FALSE);
 
     const GValue *profile_name_value = g_hash_table_lookup (properties, profile_root_prop);
     if (profile_name_value != NULL)
     {
-        xfconf_channel_set_property (wl_channel, profile_root_prop, profile_name_value);
+        display_profile_writer_set_value (writer, profile_root_prop, profile_name_value);
     }
 
     GHashTableIter iter;
@@ -245,7 +1196,7 @@ migrate_profile (XfconfChannel *x11_channel,
         const GValue *monitor_name_value = g_hash_table_lookup (properties, monitor_root_prop);
         if (monitor_name_value != NULL)
         {
-            xfconf_channel_set_property (wl_channel, monitor_root_prop, monitor_name_value);
+            display_profile_writer_set_value (writer, monitor_root_prop, monitor_name_value);
         }
 
         for (gsize i = 0; i < G_N_ELEMENTS (profile_copy_verbatim); i++)
@@ -254,7 +1205,7 @@ migrate_profile (XfconfChannel *x11_channel,
             const GValue *value = g_hash_table_lookup (properties, prop);
             if (value != NULL)
             {
-                xfconf_channel_set_property (wl_channel, prop, value);
+                display_profile_writer_set_value (writer, prop, value);
             }
 
             g_free (prop);
@@ -270,28 +1221,32 @@ migrate_profile (XfconfChannel *x11_channel,
         }
         gdouble x11_scale = MAX (0.01, G_VALUE_HOLDS_DOUBLE (scale_value) ? g_value_get_double (scale_value) : 1.0);
         gdouble wl_scale = (gdouble) ui_scale_factor / x11_scale;
-        xfconf_channel_set_double (wl_channel, scale_prop, MAX (wl_scale, 0.01));
+        display_profile_writer_set_double (writer, scale_prop, MAX (wl_scale, 0.01));
         g_free (scale_prop);
 
         gchar *posx_prop = g_strconcat (monitor_root_prop, "/Position/X", NULL);
         const GValue *posx_value = g_hash_table_lookup (properties, posx_prop);
         gint x11_posx = G_VALUE_HOLDS_INT (posx_value) ? g_value_get_int (posx_value) : 0;
         gint wl_posx = x11_posx / ui_scale_factor;
-        xfconf_channel_set_int (wl_channel, posx_prop, wl_posx);
+        display_profile_writer_set_int (writer, posx_prop, wl_posx);
         g_free (posx_prop);
 
         gchar *posy_prop = g_strconcat (monitor_root_prop, "/Position/Y", NULL);
         const GValue *posy_value = g_hash_table_lookup (properties, posy_prop);
         gint x11_posy = G_VALUE_HOLDS_INT (posy_value) ? g_value_get_int (posy_value) : 0;
         gint wl_posy = x11_posy / ui_scale_factor;
-        xfconf_channel_set_int (wl_channel, posy_prop, wl_posy);
+        display_profile_writer_set_int (writer, posy_prop, wl_posy);
         g_free (posy_prop);
 
         g_free (monitor_root_prop);
     }
 
+    gboolean succeeded = display_profile_writer_commit (writer);
+
     g_list_free_full (monitors, g_free);
     g_hash_table_destroy (properties);
+
+    return succeeded;
 }
 
 void
@@ -303,24 +1258,28 @@ display_settings_wayland_migrate_profiles (void)
         return;
     }
 
-    xfconf_channel_set_bool (wl_channel, PROP_X11_MIGRATION_DONE, TRUE);
-
     XfconfChannel *xsettings = xfconf_channel_get ("xsettings");
     gint ui_scale_factor = MAX (1, xfconf_channel_get_int (xsettings, "/Gdk/WindowScalingFactor", 1));
 
     XfconfChannel *x11_channel = xfconf_channel_get (DISPLAYS_CHANNEL_X11);
+    gboolean succeeded = TRUE;
+
+    /* the profile lookups find nothing until the index is read */
+    display_settings_profiles_load (x11_channel);
     GList *profiles = display_settings_get_profiles (NULL, x11_channel, FALSE);
 
     for (GList *pp = profiles; pp != NULL; pp = pp->next)
     {
         const gchar *profile_id = pp->data;
         gchar *profile_root_prop = g_strconcat ("/", profile_id, NULL);
-        migrate_profile (x11_channel, wl_channel, profile_root_prop, ui_scale_factor);
+        if (!migrate_profile (x11_channel, wl_channel, profile_root_prop, ui_scale_factor))
+            succeeded = FALSE;
         g_free (profile_root_prop);
     }
     g_list_free_full (profiles, g_free);
 
-    migrate_profile (x11_channel, wl_channel, "/Default", ui_scale_factor);
+    if (!migrate_profile (x11_channel, wl_channel, "/Default", ui_scale_factor))
+        succeeded = FALSE;
 
     static const gchar *root_copy_verbatim[] = {
         "/ActiveProfile",
@@ -333,10 +1292,17 @@ display_settings_wayland_migrate_profiles (void)
         GValue value = G_VALUE_INIT;
         if (xfconf_channel_get_property (x11_channel, root_copy_verbatim[i], &value))
         {
-            xfconf_channel_set_property (wl_channel, root_copy_verbatim[i], &value);
+            if (!xfconf_channel_set_property (wl_channel, root_copy_verbatim[i], &value))
+                succeeded = FALSE;
             g_value_unset (&value);
         }
     }
+
+    /* try again next time if something could not be copied */
+    if (succeeded)
+        xfconf_channel_set_bool (wl_channel, PROP_X11_MIGRATION_DONE, TRUE);
+    else
+        g_warning ("Failed to migrate the X11 display profiles, will retry on next start");
 }
 
 #endif
@@ -19,7 +19,7 @@
 #ifndef __DISPLAY_PROFILES_H__
 #define __DISPLAY_PROFILES_H__
 
-#include <glib.h>
+#include <gio/gio.h>
 #include <xfconf/xfconf.h>
 
 G_BEGIN_DECLS
@@ -43,9 +43,28 @@ enum
 #define ACTION_ON_NEW_OUTPUT_DEFAULT ACTION_ON_NEW_OUTPUT_SHOW_DIALOG
 #define AUTO_ENABLE_PROFILES_DEFAULT AUTO_ENABLE_PROFILES_ALWAYS
 
+/* set while a DisplayProfileWriter commits, xfsettingsd defers applying until it is reset */
+#define PROFILE_BATCH_PROP "/Schemes/Batch"
+
+typedef struct _DisplayProfileWriter DisplayProfileWriter;
+
 XfconfChannel *
 display_settings_profiles_channel_get (void);
 
+void
+display_settings_profiles_load (XfconfChannel *channel);
+void
+display_settings_profiles_load_async (XfconfChannel *channel,
+                                      GCancellable *cancellable,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data);
+gboolean
+display_settings_profiles_load_finish (XfconfChannel *channel,
+                                       GAsyncResult *result,
+                                       GError **error);
+gboolean
+display_settings_profiles_loaded (XfconfChannel *channel);
+
 gboolean
 display_settings_profile_name_exists (XfconfChannel *channel,
                                       const gchar *new_profile_name);
@@ -57,6 +76,46 @@ gboolean
 display_settings_profile_matches (const gchar *profile,
                                   gchar **display_infos,
                                   XfconfChannel *channel);
+gchar *
+display_settings_profile_get_name (const gchar *profile,
+                                   XfconfChannel *channel);
+gboolean
+display_settings_profile_exists (const gchar *profile,
+                                 XfconfChannel *channel);
+
+DisplayProfileWriter *
+display_profile_writer_new (XfconfChannel *channel,
+                            const gchar *root,
+                            gboolean replace);
+void
+display_profile_writer_set_value (DisplayProfileWriter *writer,
+                                  const gchar *property,
+                                  const GValue *value);
+void
+display_profile_writer_set_string (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   const gchar *value);
+void
+display_profile_writer_set_bool (DisplayProfileWriter *writer,
+                                 const gchar *property,
+                                 gboolean value);
+void
+display_profile_writer_set_int (DisplayProfileWriter *writer,
+                                const gchar *property,
+                                gint value);
+void
+display_profile_writer_set_uint64 (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   guint64 value);
+void
+display_profile_writer_set_double (DisplayProfileWriter *writer,
+                                   const gchar *property,
+                                   gdouble value);
+void
+display_profile_writer_apply (DisplayProfileWriter *writer,
+                              const gchar *scheme);
+gboolean
+display_profile_writer_commit (DisplayProfileWriter *writer);
 
 #ifdef ENABLE_WAYLAND
 void
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Decoded EDIDs are kept for the lifetime of the process, keyed by the base
+ * block checksum, vendor, product and serial number. Display names are also
+ * stored in $XDG_CACHE_HOME, keyed by the SHA1 of the base block, so naming
+ * a known monitor does not need to load the PNP id database at all.
+ */
+
+#include "debug.h"
+#include "edid.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define EDID_BLOCK_SIZE 128
+
+#define CACHE_GROUP "Cache"
+#define CACHE_KEY_PNP_IDS "PnpIds"
+#define CACHE_GROUP_NAMES "Names"
+
+
+
+typedef struct _EdidCacheEntry
+{
+    EdidInfo info;
+    guint8 block[EDID_BLOCK_SIZE];
+} EdidCacheEntry;
+
+
+
+static GHashTable *edid_cache = NULL;
+static GKeyFile *name_cache = NULL;
+static gchar *name_cache_file = NULL;
+
+
+
+static guint
+edid_block_hash (gconstpointer key)
+{
+    const guint8 *block = key;
+
+    /* vendor and product (0x08-0x0b), serial number (0x0c-0x0f) and the
+     * checksum of the block (0x7f) tell monitors apart well enough */
+    return ((guint) block[0x08] << 24 | (guint) block[0x09] << 16 | (guint) block[0x0a] << 8 | block[0x0b])
+           ^ ((guint) block[0x0c] << 24 | (guint) block[0x0d] << 16 | (guint) block[0x0e] << 8 | block[0x0f])
+           ^ ((guint) block[0x7f] << 4);
+}
+
+
+
+static gboolean
+edid_block_equal (gconstpointer a,
+                  gconstpointer b)
+{
+    return memcmp (a, b, EDID_BLOCK_SIZE) == 0;
+}
+
+
+
+static gchar *
+name_cache_pnp_ids_stamp (void)
+{
+    const gchar *builtin = display_name_get_vendors_checksum ();
+    struct stat st;
+
+    /* names come from pnp.ids first, then from the built-in table */
+    if (stat (PNP_IDS, &st) == 0)
+        return g_strdup_printf ("%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT ":%s",
+                                (gint64) st.st_mtime, (gint64) st.st_size, builtin);
+
+    return g_strdup_printf ("none:%s", builtin);
+}
+
+
+
+static void
+name_cache_load (void)
+{
+    gchar *stamp, *saved_stamp;
+
+    if (name_cache != NULL)
+        return;
+
+    name_cache = g_key_file_new ();
+    name_cache_file = g_build_filename (g_get_user_cache_dir (), "xfce4", "displays", "edid-names", NULL);
+
+    stamp = name_cache_pnp_ids_stamp ();
+    if (g_key_file_load_from_file (name_cache, name_cache_file, G_KEY_FILE_NONE, NULL))
+    {
+        /* vendor names change with the PNP id database and the built-in table */
+        saved_stamp = g_key_file_get_string (name_cache, CACHE_GROUP, CACHE_KEY_PNP_IDS, NULL);
+        if (g_strcmp0 (stamp, saved_stamp) != 0)
+        {
+            g_key_file_free (name_cache);
+            name_cache = g_key_file_new ();
+        }
+        g_free (saved_stamp);
+    }
+    g_key_file_set_string (name_cache, CACHE_GROUP, CACHE_KEY_PNP_IDS, stamp);
+    g_free (stamp);
+}
+
+
+
+static gchar *
+name_cache_lookup (const gchar *checksum,
+                   const MonitorInfo *info)
+{
+    gchar *display_name;
+    gchar *dirname;
+    GError *error = NULL;
+
+    name_cache_load ();
+
+    display_name = g_key_file_get_string (name_cache, CACHE_GROUP_NAMES, checksum, NULL);
+    if (display_name != NULL)
+        return display_name;
+
+    display_name = make_display_name (info, 0);
+    g_key_file_set_string (name_cache, CACHE_GROUP_NAMES, checksum, display_name);
+
+    /* the cache is optional, failing to write it is not fatal */
+    dirname = g_path_get_dirname (name_cache_file);
+    if (g_mkdir_with_parents (dirname, 0700) == -1
+        || !g_key_file_save_to_file (name_cache, name_cache_file, &error))
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Failed to write %s: %s", name_cache_file,
+                        error != NULL ? error->message : g_strerror (errno));
+        g_clear_error (&error);
+    }
+    g_free (dirname);
+
+    return display_name;
+}
+
+
+
+/**
+ * edid_info_lookup:
+ * @data: the raw EDID.
+ * @length: the length of @data.
+ *
+ * Decode an EDID, or return the result of an earlier decode of the same
+ * base block.
+ *
+ * Returns: the decoded EDID, owned by the cache, or %NULL if @data is
+ *          shorter than the EDID base block.
+ **/
+const EdidInfo *
+edid_info_lookup (const guint8 *data,
+                  gsize length)
+{
+    EdidCacheEntry *entry;
+
+    if (data == NULL || length < EDID_BLOCK_SIZE)
+        return NULL;
+
+    if (edid_cache == NULL)
+        edid_cache = g_hash_table_new (edid_block_hash, edid_block_equal);
+
+    entry = g_hash_table_lookup (edid_cache, data);
+    if (entry != NULL)
+        return &entry->info;
+
+    entry = g_new0 (EdidCacheEntry, 1);
+    memcpy (entry->block, data, EDID_BLOCK_SIZE);
+    entry->info.checksum = g_compute_checksum_for_data (G_CHECKSUM_SHA1, data, EDID_BLOCK_SIZE);
+    entry->info.monitor_info = decode_edid (data);
+    if (entry->info.monitor_info != NULL)
+        entry->info.display_name = name_cache_lookup (entry->info.checksum, entry->info.monitor_info);
+
+    g_hash_table_insert (edid_cache, entry->block, entry);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Decoded EDID %s: %s", entry->info.checksum,
+                    entry->info.display_name != NULL ? entry->info.display_name : "invalid");
+
+    return &entry->info;
+}
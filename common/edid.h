@@ -194,15 +194,27 @@ struct MonitorInfo
     char dsc_string[14]; /* Unspecified ASCII data */
 };
 
+typedef struct EdidInfo
+{
+    gchar *checksum; /* SHA1 of the base block */
+    MonitorInfo *monitor_info; /* NULL if the base block does not decode */
+    gchar *display_name; /* NULL if monitor_info is NULL */
+} EdidInfo;
+
 MonitorInfo *
 decode_edid (const uchar *data);
 char *
 make_display_name (const MonitorInfo *info,
                    guint output);
+const gchar *
+display_name_get_vendors_checksum (void);
 gboolean
 display_name_is_laptop_name (const gchar *name);
 const gchar *
 display_name_get_fallback (const gchar *name);
+const EdidInfo *
+edid_info_lookup (const guint8 *data,
+                  gsize length);
 
 G_END_DECLS
 
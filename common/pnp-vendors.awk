@@ -0,0 +1,52 @@
+# Turn the sorted lines of pnp-vendors.ids into C tables for bsearch():
+# vendor_ids holds the 3-byte codes in order, vendor_name_offsets the
+# offset of the matching name in the NUL-separated vendor_names blob.
+
+BEGIN {
+    FS = "\t"
+    n = 0
+    offset = 0
+}
+
+/^#/ || /^$/ {
+    next
+}
+
+{
+    if (length ($1) != 3 || $2 == "") {
+        printf "pnp-vendors.ids: invalid line: %s\n", $0 > "/dev/stderr"
+        exit 1
+    }
+    if (n > 0 && codes[n - 1] == $1) {
+        printf "pnp-vendors.ids: duplicate code: %s\n", $1 > "/dev/stderr"
+        exit 1
+    }
+
+    name = $2
+    gsub (/\\/, "\\\\", name)
+    gsub (/"/, "\\\"", name)
+
+    codes[n] = $1
+    names[n] = name
+    offsets[n] = offset
+    offset += length ($2) + 1
+    n++
+}
+
+END {
+    print "/* generated from pnp-vendors.ids, do not edit */"
+    print ""
+    print "static const guint8 vendor_ids[][3] = {"
+    for (i = 0; i < n; i++)
+        printf "    { '%s', '%s', '%s' },\n", substr (codes[i], 1, 1), substr (codes[i], 2, 1), substr (codes[i], 3, 1)
+    print "};"
+    print ""
+    print "static const guint32 vendor_name_offsets[] = {"
+    for (i = 0; i < n; i++)
+        printf "    %d,\n", offsets[i]
+    print "};"
+    print ""
+    print "static const gchar vendor_names[] ="
+    for (i = 0; i < n; i++)
+        printf "    \"%s\\0\"%s\n", names[i], i == n - 1 ? ";" : ""
+}
@@ -17,12 +17,17 @@
  *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include "debug.h"
 #include "edid.h"
 #include "xfce-randr.h"
 
 #include <X11/Xatom.h>
+#include <X11/Xlib-xcb.h>
 #include <gdk/gdkx.h>
 #include <libxfce4util/libxfce4util.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xcb/randr.h>
 
 #ifdef HAVE_MATH_H
 #include <math.h>
@@ -30,6 +35,11 @@
 
 
 
+/* key of the resolution tables, RandR sizes are 16-bit */
+#define SIZE_KEY(width, height) GUINT_TO_POINTER (((guint) (width) << 16) | (guint) (height))
+
+
+
 struct _XfceRandrPrivate
 {
     GdkDisplay *display;
@@ -40,8 +50,16 @@ struct _XfceRandrPrivate
     XfceRRMode **modes;
     RROutput *rr_outputs;
 
+    /* mode tables, built once per reload */
+    GHashTable **mode_ids;
+    RRMode *preferred;
+    RRMode *clonable;
+
     /* SHA-1 checksum of the EDID */
     gchar **edid;
+
+    /* every connected output reported a decodable EDID */
+    gboolean edids_complete;
 };
 
 
@@ -49,18 +67,18 @@ struct _XfceRandrPrivate
 static gchar *
 xfce_randr_friendly_name (XfceRandr *randr,
                           guint output,
-                          RROutput rr_output);
+                          const guint8 *edid_data,
+                          gsize edid_length);
 
 
 
 static Rotation
 xfce_randr_get_safe_rotations (XfceRandr *randr,
-                               Display *xdisplay,
+                               XfceRandrQuery *query,
                                guint num_output)
 {
-    XRRCrtcInfo *crtc_info;
     Rotation rot;
-    gint n;
+    gint n, crtc;
 
     g_return_val_if_fail (num_output < randr->noutput, RR_Rotate_0);
     g_return_val_if_fail (randr->priv->output_info[num_output]->ncrtc > 0, RR_Rotate_0);
@@ -68,10 +86,9 @@ xfce_randr_get_safe_rotations (XfceRandr *randr,
     rot = XFCE_RANDR_ROTATIONS_MASK | XFCE_RANDR_REFLECTIONS_MASK;
     for (n = 0; n < randr->priv->output_info[num_output]->ncrtc; ++n)
     {
-        crtc_info = XRRGetCrtcInfo (xdisplay, randr->priv->resources,
-                                    randr->priv->output_info[num_output]->crtcs[n]);
-        rot &= crtc_info->rotations;
-        XRRFreeCrtcInfo (crtc_info);
+        crtc = xfce_randr_query_find_crtc (query, randr->priv->output_info[num_output]->crtcs[n]);
+        if (crtc != -1 && query->crtc_info[crtc] != NULL)
+            rot &= query->crtc_info[crtc]->rotations;
     }
 
     return rot;
@@ -80,13 +97,14 @@ xfce_randr_get_safe_rotations (XfceRandr *randr,
 
 
 static XfceRRMode *
-xfce_randr_list_supported_modes (XRRScreenResources *resources,
+xfce_randr_list_supported_modes (GHashTable *resource_modes,
                                  XRROutputInfo *output_info)
 {
     XfceRRMode *modes;
-    gint m, n;
+    XRRModeInfo *mode_info;
+    gint n;
 
-    g_return_val_if_fail (resources != NULL, NULL);
+    g_return_val_if_fail (resource_modes != NULL, NULL);
     g_return_val_if_fail (output_info != NULL, NULL);
 
     if (output_info->nmode == 0)
@@ -98,21 +116,108 @@ xfce_randr_list_supported_modes (XRRScreenResources *resources,
     {
         modes[n].id = output_info->modes[n];
 
-        /* we need to walk yet another list to get the mode info */
-        for (m = 0; m < resources->nmode; ++m)
+        mode_info = g_hash_table_lookup (resource_modes, GUINT_TO_POINTER (output_info->modes[n]));
+        if (mode_info != NULL)
         {
-            if (output_info->modes[n] == resources->modes[m].id)
-            {
-                modes[n].width = resources->modes[m].width;
-                modes[n].height = resources->modes[m].height;
-                modes[n].rate = xfce_randr_calculate_refresh_rate (resources->modes[m]);
-                modes[n].flags = resources->modes[m].modeFlags;
+            modes[n].width = mode_info->width;
+            modes[n].height = mode_info->height;
+            modes[n].rate = xfce_randr_calculate_refresh_rate (*mode_info);
+            modes[n].flags = mode_info->modeFlags;
+        }
+    }
+
+    return modes;
+}
+
+
+
+static RRMode
+xfce_randr_find_preferred_mode (XfceRandr *randr,
+                                guint output)
+{
+    RRMode best_mode;
+    gint best_dist, dist, n;
+
+    /* mimic xrandr's preferred_mode () */
 
+    best_mode = None;
+    best_dist = 0;
+    for (n = 0; n < randr->priv->output_info[output]->nmode; ++n)
+    {
+        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+        if (n < randr->priv->output_info[output]->npreferred)
+            dist = 0;
+        else if ((randr->priv->output_info[output]->mm_height != 0) && (gdk_screen_height_mm () != 0))
+        {
+            dist = (1000 * gdk_screen_height () / gdk_screen_height_mm ()
+                    - 1000 * randr->priv->modes[output][n].height / randr->priv->output_info[output]->mm_height);
+        }
+        else
+            dist = gdk_screen_height () - randr->priv->modes[output][n].height;
+        G_GNUC_END_IGNORE_DEPRECATIONS
+
+        dist = ABS (dist);
+
+        if (best_mode == None || dist < best_dist)
+        {
+            best_mode = randr->priv->modes[output][n].id;
+            best_dist = dist;
+        }
+    }
+    return best_mode;
+}
+
+
+
+static RRMode *
+xfce_randr_find_clonable_modes (XfceRandr *randr)
+{
+    GHashTable **sizes;
+    RRMode *modes;
+    gpointer mode;
+    gint n, l;
+    guint m;
+
+    if (randr->noutput == 0)
+        return NULL;
+
+    /* the first mode of each size, for every output */
+    sizes = g_new0 (GHashTable *, randr->noutput);
+    for (m = 0; m < randr->noutput; ++m)
+    {
+        sizes[m] = g_hash_table_new (NULL, NULL);
+        for (l = 0; l < randr->priv->output_info[m]->nmode; ++l)
+        {
+            gpointer key = SIZE_KEY (randr->priv->modes[m][l].width, randr->priv->modes[m][l].height);
+            if (!g_hash_table_contains (sizes[m], key))
+                g_hash_table_insert (sizes[m], key, GUINT_TO_POINTER (randr->priv->modes[m][l].id));
+        }
+    }
+
+    /* the first screen mode whose size all outputs support */
+    modes = g_new0 (RRMode, randr->noutput);
+    for (n = 0; n < randr->priv->resources->nmode; ++n)
+    {
+        gpointer key = SIZE_KEY (randr->priv->resources->modes[n].width, randr->priv->resources->modes[n].height);
+
+        for (m = 0; m < randr->noutput; ++m)
+        {
+            if (!g_hash_table_lookup_extended (sizes[m], key, NULL, &mode))
                 break;
-            }
+            modes[m] = GPOINTER_TO_UINT (mode);
         }
+
+        if (m == randr->noutput)
+            break;
     }
 
+    if (n == randr->priv->resources->nmode)
+        g_clear_pointer (&modes, g_free);
+
+    for (m = 0; m < randr->noutput; ++m)
+        g_hash_table_destroy (sizes[m]);
+    g_free (sizes);
+
     return modes;
 }
 
@@ -151,46 +256,47 @@ xfce_randr_populate (XfceRandr *randr,
                      Display *xdisplay,
                      GdkWindow *root_window)
 {
+    XfceRandrQuery *query;
     GPtrArray *outputs;
-    XRROutputInfo *output_info;
     XRRCrtcInfo *crtc_info;
-    gint n;
+    gint n, crtc;
     guint m, connected;
     RROutput *rr_outputs = NULL;
+    gint *query_outputs;
+    GHashTable *resource_modes;
 
     g_return_if_fail (randr != NULL);
     g_return_if_fail (randr->priv != NULL);
     g_return_if_fail (randr->priv->resources != NULL);
 
+    /* fetch everything at once */
+    query = xfce_randr_query_new (xdisplay, GDK_WINDOW_XID (root_window),
+                                  randr->priv->resources, XFCE_RANDR_QUERY_EDID);
+
     /* prepare the temporary cache */
     outputs = g_ptr_array_new ();
     rr_outputs = g_new0 (RROutput, randr->priv->resources->noutput);
+    query_outputs = g_new0 (gint, randr->priv->resources->noutput);
 
     /* walk the outputs */
     connected = 0;
     for (n = 0; n < randr->priv->resources->noutput; ++n)
     {
-        /* get the output info */
-        output_info = XRRGetOutputInfo (xdisplay, randr->priv->resources,
-                                        randr->priv->resources->outputs[n]);
-
         /* forget about disconnected outputs */
-        if (output_info->connection != RR_Connected)
-        {
-            XRRFreeOutputInfo (output_info);
+        if (query->output_info[n] == NULL || query->output_info[n]->connection != RR_Connected)
             continue;
-        }
-        else
-        {
-            rr_outputs[connected] = randr->priv->resources->outputs[n];
-            connected++;
-        }
+
+        rr_outputs[connected] = randr->priv->resources->outputs[n];
+        query_outputs[connected] = n;
+        connected++;
 
         /* cache it */
-        g_ptr_array_add (outputs, output_info);
+        g_ptr_array_add (outputs, query->output_info[n]);
+        query->output_info[n] = NULL;
     }
 
     /* migrate the temporary cache */
+    randr->priv->edids_complete = TRUE;
     randr->noutput = outputs->len;
     randr->priv->output_info = (XRROutputInfo **) g_ptr_array_free (outputs, FALSE);
     randr->priv->rr_outputs = rr_outputs;
@@ -198,6 +304,8 @@ xfce_randr_populate (XfceRandr *randr,
     /* allocate final space for the settings */
     randr->mode = g_new0 (RRMode, randr->noutput);
     randr->priv->modes = g_new0 (XfceRRMode *, randr->noutput);
+    randr->priv->mode_ids = g_new0 (GHashTable *, randr->noutput);
+    randr->priv->preferred = g_new0 (RRMode, randr->noutput);
     randr->priv->edid = g_new0 (gchar *, randr->noutput);
     randr->position = g_new0 (XfceOutputPosition, randr->noutput);
     randr->scalex = g_new0 (gdouble, randr->noutput);
@@ -208,53 +316,77 @@ xfce_randr_populate (XfceRandr *randr,
     randr->status = g_new0 (XfceOutputStatus, randr->noutput);
     randr->friendly_name = g_new0 (gchar *, randr->noutput);
 
+    /* index the screen modes once instead of scanning them for every output mode */
+    resource_modes = g_hash_table_new (NULL, NULL);
+    for (n = 0; n < randr->priv->resources->nmode; ++n)
+        g_hash_table_insert (resource_modes, GUINT_TO_POINTER (randr->priv->resources->modes[n].id),
+                             &randr->priv->resources->modes[n]);
+
     /* walk the connected outputs */
     for (m = 0; m < randr->noutput; ++m)
     {
         /* fill in supported modes */
-        randr->priv->modes[m] = xfce_randr_list_supported_modes (randr->priv->resources, randr->priv->output_info[m]);
+        randr->priv->modes[m] = xfce_randr_list_supported_modes (resource_modes, randr->priv->output_info[m]);
+        randr->priv->mode_ids[m] = g_hash_table_new (NULL, NULL);
+        for (n = 0; n < randr->priv->output_info[m]->nmode; ++n)
+            g_hash_table_insert (randr->priv->mode_ids[m], GUINT_TO_POINTER (randr->priv->modes[m][n].id),
+                                 &randr->priv->modes[m][n]);
+        randr->priv->preferred[m] = xfce_randr_find_preferred_mode (randr, m);
 
         /* find the primary screen */
-        if (XRRGetOutputPrimary (xdisplay, GDK_WINDOW_XID (root_window)) == rr_outputs[m])
+        if (query->primary == rr_outputs[m])
             randr->status[m] = XFCE_OUTPUT_STATUS_PRIMARY;
         else
             randr->status[m] = XFCE_OUTPUT_STATUS_SECONDARY;
 
+        crtc = -1;
+        crtc_info = NULL;
         if (randr->priv->output_info[m]->crtc != None)
         {
-            XRRCrtcTransformAttributes *attr;
-            crtc_info = XRRGetCrtcInfo (xdisplay, randr->priv->resources,
-                                        randr->priv->output_info[m]->crtc);
+            crtc = xfce_randr_query_find_crtc (query, randr->priv->output_info[m]->crtc);
+            if (crtc != -1)
+                crtc_info = query->crtc_info[crtc];
+        }
+
+        if (crtc_info != NULL)
+        {
             randr->mode[m] = crtc_info->mode;
             randr->rotation[m] = crtc_info->rotation;
             randr->rotations[m] = crtc_info->rotations;
             randr->position[m].x = crtc_info->x;
             randr->position[m].y = crtc_info->y;
-            XRRFreeCrtcInfo (crtc_info);
-            if (XRRGetCrtcTransform (xdisplay, randr->priv->output_info[m]->crtc, &attr) && attr)
-            {
-                randr->scalex[m] = XFixedToDouble (attr->currentTransform.matrix[0][0]);
-                randr->scaley[m] = XFixedToDouble (attr->currentTransform.matrix[1][1]);
-                XFree (attr);
-            }
+            randr->scalex[m] = query->crtc_scalex[crtc];
+            randr->scaley[m] = query->crtc_scaley[crtc];
         }
         else
         {
             /* output disabled */
             randr->mode[m] = None;
             randr->rotation[m] = RR_Rotate_0;
-            randr->rotations[m] = xfce_randr_get_safe_rotations (randr, xdisplay, m);
+            randr->rotations[m] = xfce_randr_get_safe_rotations (randr, query, m);
             randr->scalex[m] = 1.0;
             randr->scaley[m] = 1.0;
         }
 
         /* fill in the name used by the UI */
-        randr->friendly_name[m] = xfce_randr_friendly_name (randr, m, rr_outputs[m]);
+        if (query->edid != NULL)
+            randr->friendly_name[m] = xfce_randr_friendly_name (randr, m,
+                                                                query->edid[query_outputs[m]],
+                                                                query->edid_length[query_outputs[m]]);
+        else
+            randr->friendly_name[m] = xfce_randr_friendly_name (randr, m, NULL, 0);
 
         /* Replace spaces with underscore in name for xfconf compatibility */
         g_strcanon (randr->priv->output_info[m]->name,
                     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_<>", '_');
     }
+
+    g_free (query_outputs);
+    g_hash_table_destroy (resource_modes);
+    xfce_randr_query_free (query);
+
+    randr->priv->clonable = xfce_randr_find_clonable_modes (randr);
+
     /* populate mirrored details */
     xfce_randr_guess_relations (randr);
 }
@@ -315,6 +447,8 @@ xfce_randr_cleanup (XfceRandr *randr)
             XRRFreeOutputInfo (randr->priv->output_info[n]);
         if (G_LIKELY (randr->priv->modes[n]))
             g_free (randr->priv->modes[n]);
+        if (G_LIKELY (randr->priv->mode_ids[n]))
+            g_hash_table_destroy (randr->priv->mode_ids[n]);
         if (G_LIKELY (randr->priv->edid[n]))
             g_free (randr->priv->edid[n]);
         if (G_LIKELY (randr->friendly_name[n]))
@@ -328,6 +462,9 @@ xfce_randr_cleanup (XfceRandr *randr)
     g_free (randr->friendly_name);
     g_free (randr->mode);
     g_free (randr->priv->modes);
+    g_free (randr->priv->mode_ids);
+    g_free (randr->priv->preferred);
+    g_free (randr->priv->clonable);
     g_free (randr->priv->edid);
     g_free (randr->scalex);
     g_free (randr->scaley);
@@ -383,7 +520,7 @@ xfce_randr_reload (XfceRandr *randr)
 void
 xfce_randr_save_output (XfceRandr *randr,
                         const gchar *scheme,
-                        XfconfChannel *channel,
+                        DisplayProfileWriter *writer,
                         guint output,
                         gboolean duplicate)
 {
@@ -393,13 +530,13 @@ xfce_randr_save_output (XfceRandr *randr,
     gint degrees;
 
     g_return_if_fail (randr != NULL && scheme != NULL);
-    g_return_if_fail (XFCONF_IS_CHANNEL (channel));
+    g_return_if_fail (writer != NULL);
     g_return_if_fail (output < randr->noutput);
 
     /* save the device name */
     g_snprintf (property, sizeof (property), "/%s/%s", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_string (channel, property, randr->friendly_name[output]);
+    display_profile_writer_set_string (writer, property, randr->friendly_name[output]);
 
     /* find the resolution and refresh rate */
     mode = xfce_randr_find_mode_by_id (randr, output, randr->mode[output]);
@@ -407,14 +544,14 @@ xfce_randr_save_output (XfceRandr *randr,
     /* if no resolution was found, mark it as inactive and stop */
     g_snprintf (property, sizeof (property), "/%s/%s/Active", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_bool (channel, property, mode != NULL);
+    display_profile_writer_set_bool (writer, property, mode != NULL);
 
     g_snprintf (property, sizeof (property), "/%s/%s/EDID", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_string (channel, property, randr->priv->edid[output]);
+    display_profile_writer_set_string (writer, property, randr->priv->edid[output]);
     g_snprintf (property, sizeof (property), "/%s/%s/DuplicateEDID", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_bool (channel, property, duplicate);
+    display_profile_writer_set_bool (writer, property, duplicate);
 
     if (mode == NULL)
         return;
@@ -423,17 +560,17 @@ xfce_randr_save_output (XfceRandr *randr,
     str_value = g_strdup_printf ("%ux%u", mode->width, mode->height);
     g_snprintf (property, sizeof (property), "/%s/%s/Resolution", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_string (channel, property, str_value);
+    display_profile_writer_set_string (writer, property, str_value);
     g_free (str_value);
 
     /* save the refresh rate */
     g_snprintf (property, sizeof (property), "/%s/%s/RefreshRate", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_double (channel, property, mode->rate);
+    display_profile_writer_set_double (writer, property, mode->rate);
 
     g_snprintf (property, sizeof (property), "/%s/%s/ModeFlags", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_uint64 (channel, property, mode->flags);
+    display_profile_writer_set_uint64 (writer, property, mode->flags);
 
     /* convert the rotation into degrees */
     switch (randr->rotation[output] & XFCE_RANDR_ROTATIONS_MASK)
@@ -447,7 +584,7 @@ xfce_randr_save_output (XfceRandr *randr,
     /* save the rotation in degrees */
     g_snprintf (property, sizeof (property), "/%s/%s/Rotation", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_int (channel, property, degrees);
+    display_profile_writer_set_int (writer, property, degrees);
 
     /* convert the reflection into a string */
     switch (randr->rotation[output] & XFCE_RANDR_REFLECTIONS_MASK)
@@ -461,37 +598,26 @@ xfce_randr_save_output (XfceRandr *randr,
     /* save the reflection string */
     g_snprintf (property, sizeof (property), "/%s/%s/Reflection", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_string (channel, property, str_value);
+    display_profile_writer_set_string (writer, property, str_value);
 
     /* is it the primary output? */
     g_snprintf (property, sizeof (property), "/%s/%s/Primary", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_bool (channel, property,
-                             randr->status[output] == XFCE_OUTPUT_STATUS_PRIMARY);
+    display_profile_writer_set_bool (writer, property,
+                                     randr->status[output] == XFCE_OUTPUT_STATUS_PRIMARY);
 
     /* save the scale */
     g_snprintf (property, sizeof (property), "/%s/%s/Scale", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_double (channel, property, randr->scalex[output]);
-
-    /* clean up old properties so backward compatibility is triggered only once in xfsettingsd */
-    g_snprintf (property, sizeof (property), "/%s/%s/Scale/X", scheme,
-                randr->priv->output_info[output]->name);
-    if (xfconf_channel_has_property (channel, property))
-    {
-        xfconf_channel_reset_property (channel, property, TRUE);
-        g_snprintf (property, sizeof (property), "/%s/%s/Scale/Y", scheme,
-                    randr->priv->output_info[output]->name);
-        xfconf_channel_reset_property (channel, property, TRUE);
-    }
+    display_profile_writer_set_double (writer, property, randr->scalex[output]);
 
     /* save the position */
     g_snprintf (property, sizeof (property), "/%s/%s/Position/X", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_int (channel, property, MAX (randr->position[output].x, 0));
+    display_profile_writer_set_int (writer, property, MAX (randr->position[output].x, 0));
     g_snprintf (property, sizeof (property), "/%s/%s/Position/Y", scheme,
                 randr->priv->output_info[output]->name);
-    xfconf_channel_set_int (channel, property, MAX (randr->position[output].y, 0));
+    display_profile_writer_set_int (writer, property, MAX (randr->position[output].y, 0));
 }
 
 
@@ -505,35 +631,358 @@ xfce_randr_load (XfceRandr *randr,
 
 
 
-guint8 *
-xfce_randr_read_edid_data (Display *xdisplay,
-                           RROutput output)
+/* Turn the xcb replies into the Xlib structures used everywhere else. Like
+ * libXrandr, everything is allocated in a single block, so the results
+ * can be released with XRRFreeOutputInfo() and XRRFreeCrtcInfo(). */
+static XRROutputInfo *
+xfce_randr_query_output_info (xcb_randr_get_output_info_reply_t *reply)
 {
-    unsigned char *prop;
-    int actual_format;
-    unsigned long nitems, bytes_after;
-    Atom actual_type;
+    XRROutputInfo *info;
+    xcb_randr_crtc_t *crtcs = xcb_randr_get_output_info_crtcs (reply);
+    xcb_randr_mode_t *modes = xcb_randr_get_output_info_modes (reply);
+    xcb_randr_output_t *clones = xcb_randr_get_output_info_clones (reply);
+    guint8 *name = xcb_randr_get_output_info_name (reply);
+    gint n;
+
+    info = malloc (sizeof (XRROutputInfo)
+                   + reply->num_crtcs * sizeof (RRCrtc)
+                   + reply->num_modes * sizeof (RRMode)
+                   + reply->num_clones * sizeof (RROutput)
+                   + reply->name_len + 1);
+    if (info == NULL)
+        return NULL;
+
+    info->timestamp = reply->timestamp;
+    info->crtc = reply->crtc;
+    info->mm_width = reply->mm_width;
+    info->mm_height = reply->mm_height;
+    info->connection = reply->connection;
+    info->subpixel_order = reply->subpixel_order;
+    info->ncrtc = reply->num_crtcs;
+    info->nmode = reply->num_modes;
+    info->npreferred = reply->num_preferred;
+    info->nclone = reply->num_clones;
+    info->nameLen = reply->name_len;
+
+    info->crtcs = (RRCrtc *) (info + 1);
+    info->modes = (RRMode *) (info->crtcs + info->ncrtc);
+    info->clones = (RROutput *) (info->modes + info->nmode);
+    info->name = (char *) (info->clones + info->nclone);
+
+    for (n = 0; n < info->ncrtc; n++)
+        info->crtcs[n] = crtcs[n];
+    for (n = 0; n < info->nmode; n++)
+        info->modes[n] = modes[n];
+    for (n = 0; n < info->nclone; n++)
+        info->clones[n] = clones[n];
+    memcpy (info->name, name, info->nameLen);
+    info->name[info->nameLen] = '\0';
+
+    return info;
+}
+
+
+
+static XRRCrtcInfo *
+xfce_randr_query_crtc_info (xcb_randr_get_crtc_info_reply_t *reply)
+{
+    XRRCrtcInfo *info;
+    xcb_randr_output_t *outputs = xcb_randr_get_crtc_info_outputs (reply);
+    xcb_randr_output_t *possible = xcb_randr_get_crtc_info_possible (reply);
+    gint n;
+
+    info = malloc (sizeof (XRRCrtcInfo)
+                   + reply->num_outputs * sizeof (RROutput)
+                   + reply->num_possible_outputs * sizeof (RROutput));
+    if (info == NULL)
+        return NULL;
+
+    info->timestamp = reply->timestamp;
+    info->x = reply->x;
+    info->y = reply->y;
+    info->width = reply->width;
+    info->height = reply->height;
+    info->mode = reply->mode;
+    info->rotation = reply->rotation;
+    info->rotations = reply->rotations;
+    info->noutput = reply->num_outputs;
+    info->npossible = reply->num_possible_outputs;
+
+    info->outputs = (RROutput *) (info + 1);
+    info->possible = info->outputs + info->noutput;
+
+    for (n = 0; n < info->noutput; n++)
+        info->outputs[n] = outputs[n];
+    for (n = 0; n < info->npossible; n++)
+        info->possible[n] = possible[n];
+
+    return info;
+}
+
+
+
+/* Xlib does not look at the reply status, the replies below used to be
+ * taken as they were. A stale configTimestamp only means the configuration
+ * changed since @resources were read, so ask again with the current one and
+ * only then take whatever comes back. */
+static xcb_timestamp_t
+xfce_randr_query_config_timestamp (xcb_connection_t *connection,
+                                   Window root)
+{
+    xcb_randr_get_screen_resources_current_reply_t *reply;
+    xcb_timestamp_t timestamp = XCB_CURRENT_TIME;
+
+    reply = xcb_randr_get_screen_resources_current_reply (connection,
+                                                          xcb_randr_get_screen_resources_current (connection, root),
+                                                          NULL);
+    if (reply != NULL)
+        timestamp = reply->config_timestamp;
+    free (reply);
+
+    return timestamp;
+}
+
+
+
+/**
+ * xfce_randr_query_new:
+ * @xdisplay: the X display.
+ * @root: the root window of the screen.
+ * @resources: the screen resources.
+ * @flags: what to query besides outputs and CRTCs.
+ *
+ * Query all outputs, CRTCs and CRTC transforms of @resources, and the
+ * primary output. All requests are sent before the first reply is read,
+ * so this costs one round-trip (two with %XFCE_RANDR_QUERY_EDID) instead
+ * of one per request. Replies refused because the configuration changed
+ * meanwhile are asked for again with the current configTimestamp.
+ *
+ * Returns: the replies, free with xfce_randr_query_free().
+ **/
+XfceRandrQuery *
+xfce_randr_query_new (Display *xdisplay,
+                      Window root,
+                      XRRScreenResources *resources,
+                      XfceRandrQueryFlags flags)
+{
+    static XfsdDebugHistogram *histogram = NULL;
+    gint64 start_time = g_get_monotonic_time ();
+    xcb_connection_t *connection = XGetXCBConnection (xdisplay);
+    xcb_randr_get_output_info_cookie_t *output_cookies;
+    xcb_randr_get_crtc_info_cookie_t *crtc_cookies;
+    xcb_randr_get_crtc_transform_cookie_t *transform_cookies;
+    xcb_randr_get_output_property_cookie_t *edid_cookies = NULL;
+    xcb_randr_get_output_primary_cookie_t primary_cookie;
+    xcb_randr_get_output_primary_reply_t *primary_reply;
+    xcb_randr_get_output_info_reply_t **output_replies;
+    xcb_randr_get_crtc_info_reply_t **crtc_replies;
+    xcb_timestamp_t timestamp;
+    gboolean stale = FALSE;
+    XfceRandrQuery *query;
     Atom edid_atom;
-    guint8 *result = NULL;
+    gint n;
 
-    edid_atom = gdk_x11_get_xatom_by_name (RR_PROPERTY_RANDR_EDID);
+    g_return_val_if_fail (xdisplay != NULL && resources != NULL, NULL);
+
+    query = g_new0 (XfceRandrQuery, 1);
+    query->resources = resources;
+    query->noutput = resources->noutput;
+    query->ncrtc = resources->ncrtc;
+    query->output_info = g_new0 (XRROutputInfo *, query->noutput);
+    query->crtc_info = g_new0 (XRRCrtcInfo *, query->ncrtc);
+    query->crtc_scalex = g_new (gdouble, query->ncrtc);
+    query->crtc_scaley = g_new (gdouble, query->ncrtc);
+
+    /* send everything first */
+    output_cookies = g_new (xcb_randr_get_output_info_cookie_t, query->noutput);
+    for (n = 0; n < query->noutput; n++)
+        output_cookies[n] = xcb_randr_get_output_info (connection, resources->outputs[n], resources->configTimestamp);
+
+    crtc_cookies = g_new (xcb_randr_get_crtc_info_cookie_t, query->ncrtc);
+    transform_cookies = g_new (xcb_randr_get_crtc_transform_cookie_t, query->ncrtc);
+    for (n = 0; n < query->ncrtc; n++)
+    {
+        crtc_cookies[n] = xcb_randr_get_crtc_info (connection, resources->crtcs[n], resources->configTimestamp);
+        transform_cookies[n] = xcb_randr_get_crtc_transform (connection, resources->crtcs[n]);
+    }
+
+    primary_cookie = xcb_randr_get_output_primary (connection, root);
+
+    /* then collect the replies, errors are returned instead of being
+     * reported to the Xlib error handler */
+    output_replies = g_new0 (xcb_randr_get_output_info_reply_t *, query->noutput);
+    for (n = 0; n < query->noutput; n++)
+    {
+        output_replies[n] = xcb_randr_get_output_info_reply (connection, output_cookies[n], NULL);
+        if (output_replies[n] != NULL && output_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+            stale = TRUE;
+    }
 
-    if (edid_atom != None)
+    crtc_replies = g_new0 (xcb_randr_get_crtc_info_reply_t *, query->ncrtc);
+    for (n = 0; n < query->ncrtc; n++)
     {
-        if (XRRGetOutputProperty (xdisplay, output, edid_atom, 0, 100,
-                                  False, False, AnyPropertyType,
-                                  &actual_type, &actual_format, &nitems,
-                                  &bytes_after, &prop)
-            == Success)
+        crtc_replies[n] = xcb_randr_get_crtc_info_reply (connection, crtc_cookies[n], NULL);
+        if (crtc_replies[n] != NULL && crtc_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+            stale = TRUE;
+    }
+
+    primary_reply = xcb_randr_get_output_primary_reply (connection, primary_cookie, NULL);
+    query->primary = primary_reply != NULL ? primary_reply->output : None;
+    free (primary_reply);
+
+    if (G_UNLIKELY (stale))
+    {
+        timestamp = xfce_randr_query_config_timestamp (connection, root);
+
+        for (n = 0; n < query->noutput; n++)
+            if (output_replies[n] != NULL && output_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+                output_cookies[n] = xcb_randr_get_output_info (connection, resources->outputs[n], timestamp);
+        for (n = 0; n < query->ncrtc; n++)
+            if (crtc_replies[n] != NULL && crtc_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+                crtc_cookies[n] = xcb_randr_get_crtc_info (connection, resources->crtcs[n], timestamp);
+
+        for (n = 0; n < query->noutput; n++)
+        {
+            if (output_replies[n] != NULL && output_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+            {
+                free (output_replies[n]);
+                output_replies[n] = xcb_randr_get_output_info_reply (connection, output_cookies[n], NULL);
+            }
+        }
+        for (n = 0; n < query->ncrtc; n++)
+        {
+            if (crtc_replies[n] != NULL && crtc_replies[n]->status != XCB_RANDR_SET_CONFIG_SUCCESS)
+            {
+                free (crtc_replies[n]);
+                crtc_replies[n] = xcb_randr_get_crtc_info_reply (connection, crtc_cookies[n], NULL);
+            }
+        }
+    }
+
+    for (n = 0; n < query->noutput; n++)
+    {
+        if (output_replies[n] != NULL)
+            query->output_info[n] = xfce_randr_query_output_info (output_replies[n]);
+        free (output_replies[n]);
+    }
+
+    for (n = 0; n < query->ncrtc; n++)
+    {
+        xcb_randr_get_crtc_transform_reply_t *transform = xcb_randr_get_crtc_transform_reply (connection, transform_cookies[n], NULL);
+
+        if (crtc_replies[n] != NULL)
+            query->crtc_info[n] = xfce_randr_query_crtc_info (crtc_replies[n]);
+
+        if (transform != NULL)
         {
-            if (actual_type == XA_INTEGER && actual_format == 8)
-                result = g_memdup2 (prop, nitems);
+            query->crtc_scalex[n] = XFixedToDouble (transform->current_transform.matrix11);
+            query->crtc_scaley[n] = XFixedToDouble (transform->current_transform.matrix22);
+        }
+        else
+        {
+            query->crtc_scalex[n] = 1.0;
+            query->crtc_scaley[n] = 1.0;
         }
 
-        XFree (prop);
+        free (crtc_replies[n]);
+        free (transform);
     }
 
-    return result;
+    g_free (output_replies);
+    g_free (crtc_replies);
+    g_free (output_cookies);
+    g_free (crtc_cookies);
+    g_free (transform_cookies);
+
+    /* EDIDs of the connected outputs, in a second batch */
+    edid_atom = gdk_x11_get_xatom_by_name (RR_PROPERTY_RANDR_EDID);
+    if ((flags & XFCE_RANDR_QUERY_EDID) != 0 && edid_atom != None)
+    {
+        query->edid = g_new0 (guint8 *, query->noutput);
+        query->edid_length = g_new0 (gsize, query->noutput);
+        edid_cookies = g_new0 (xcb_randr_get_output_property_cookie_t, query->noutput);
+
+        for (n = 0; n < query->noutput; n++)
+        {
+            if (query->output_info[n] != NULL && query->output_info[n]->connection == RR_Connected)
+                edid_cookies[n] = xcb_randr_get_output_property (connection, resources->outputs[n], edid_atom,
+                                                                 XCB_GET_PROPERTY_TYPE_ANY, 0, 100, FALSE, FALSE);
+        }
+
+        for (n = 0; n < query->noutput; n++)
+        {
+            xcb_randr_get_output_property_reply_t *reply;
+
+            if (query->output_info[n] == NULL || query->output_info[n]->connection != RR_Connected)
+                continue;
+
+            reply = xcb_randr_get_output_property_reply (connection, edid_cookies[n], NULL);
+            if (reply != NULL && reply->type == XA_INTEGER && reply->format == 8 && reply->num_items > 0)
+            {
+                query->edid[n] = g_memdup2 (xcb_randr_get_output_property_data (reply), reply->num_items);
+                query->edid_length[n] = reply->num_items;
+            }
+            free (reply);
+        }
+
+        g_free (edid_cookies);
+    }
+
+    if (histogram == NULL)
+        histogram = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "RandR query, pipelined xcb");
+    xfsettings_dbg_histogram_add (histogram, g_get_monotonic_time () - start_time);
+
+    return query;
+}
+
+
+
+void
+xfce_randr_query_free (XfceRandrQuery *query)
+{
+    gint n;
+
+    if (query == NULL)
+        return;
+
+    for (n = 0; n < query->noutput; n++)
+    {
+        if (query->output_info[n] != NULL)
+            XRRFreeOutputInfo (query->output_info[n]);
+        if (query->edid != NULL)
+            g_free (query->edid[n]);
+    }
+
+    for (n = 0; n < query->ncrtc; n++)
+    {
+        if (query->crtc_info[n] != NULL)
+            XRRFreeCrtcInfo (query->crtc_info[n]);
+    }
+
+    g_free (query->output_info);
+    g_free (query->crtc_info);
+    g_free (query->crtc_scalex);
+    g_free (query->crtc_scaley);
+    g_free (query->edid);
+    g_free (query->edid_length);
+    g_free (query);
+}
+
+
+
+gint
+xfce_randr_query_find_crtc (XfceRandrQuery *query,
+                            RRCrtc crtc)
+{
+    gint n;
+
+    for (n = 0; n < query->ncrtc; n++)
+    {
+        if (query->resources->crtcs[n] == crtc)
+            return n;
+    }
+
+    return -1;
 }
 
 
@@ -541,26 +990,26 @@ xfce_randr_read_edid_data (Display *xdisplay,
 static gchar *
 xfce_randr_friendly_name (XfceRandr *randr,
                           guint output,
-                          RROutput rr_output)
+                          const guint8 *edid_data,
+                          gsize edid_length)
 {
-    Display *xdisplay;
-    MonitorInfo *info = NULL;
-    guint8 *edid_data;
+    const EdidInfo *edid_info;
     gchar *friendly_name = NULL;
     const gchar *name = randr->priv->output_info[output]->name;
 
     /* get the vendor & size */
-    xdisplay = gdk_x11_display_get_xdisplay (randr->priv->display);
-    edid_data = xfce_randr_read_edid_data (xdisplay, rr_output);
+    edid_info = edid_info_lookup (edid_data, edid_length);
 
-    if (edid_data)
+    if (edid_info != NULL)
     {
-        info = decode_edid (edid_data);
-        randr->priv->edid[output] = g_compute_checksum_for_data (G_CHECKSUM_SHA1, edid_data, 128);
+        randr->priv->edid[output] = g_strdup (edid_info->checksum);
     }
     else
     {
         XRROutputInfo *xinfo = randr->priv->output_info[output];
+
+        /* e.g. a freshly connected output that does not expose it yet */
+        randr->priv->edids_complete = FALSE;
         gchar *edid_str = g_strdup_printf ("%lu-%lu-%d-%d-%d",
                                            xinfo->mm_width, xinfo->mm_height,
                                            xinfo->ncrtc, xinfo->nclone, xinfo->nmode);
@@ -571,11 +1020,8 @@ xfce_randr_friendly_name (XfceRandr *randr,
     /* special case, a laptop */
     if (display_name_is_laptop_name (name))
         friendly_name = g_strdup (_("Laptop"));
-    else if (info)
-        friendly_name = make_display_name (info, output);
-
-    g_free (info);
-    g_free (edid_data);
+    else if (edid_info != NULL && edid_info->display_name != NULL)
+        friendly_name = g_strdup (edid_info->display_name);
 
     if (friendly_name)
         return friendly_name;
@@ -596,21 +1042,13 @@ xfce_randr_find_mode_by_id (XfceRandr *randr,
                             guint output,
                             RRMode id)
 {
-    gint n;
-
     g_return_val_if_fail (randr != NULL, NULL);
     g_return_val_if_fail (output < randr->noutput, NULL);
 
     if (id == None)
         return NULL;
 
-    for (n = 0; n < randr->priv->output_info[output]->nmode; ++n)
-    {
-        if (randr->priv->modes[output][n].id == id)
-            return &randr->priv->modes[output][n];
-    }
-
-    return NULL;
+    return g_hash_table_lookup (randr->priv->mode_ids[output], GUINT_TO_POINTER (id));
 }
 
 
@@ -619,39 +1057,10 @@ RRMode
 xfce_randr_preferred_mode (XfceRandr *randr,
                            guint output)
 {
-    RRMode best_mode;
-    gint best_dist, dist, n;
-
     g_return_val_if_fail (randr != NULL, None);
     g_return_val_if_fail (output < randr->noutput, None);
 
-    /* mimic xrandr's preferred_mode () */
-
-    best_mode = None;
-    best_dist = 0;
-    for (n = 0; n < randr->priv->output_info[output]->nmode; ++n)
-    {
-        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-        if (n < randr->priv->output_info[output]->npreferred)
-            dist = 0;
-        else if ((randr->priv->output_info[output]->mm_height != 0) && (gdk_screen_height_mm () != 0))
-        {
-            dist = (1000 * gdk_screen_height () / gdk_screen_height_mm ()
-                    - 1000 * randr->priv->modes[output][n].height / randr->priv->output_info[output]->mm_height);
-        }
-        else
-            dist = gdk_screen_height () - randr->priv->modes[output][n].height;
-        G_GNUC_END_IGNORE_DEPRECATIONS
-
-        dist = ABS (dist);
-
-        if (best_mode == None || dist < best_dist)
-        {
-            best_mode = randr->priv->modes[output][n].id;
-            best_dist = dist;
-        }
-    }
-    return best_mode;
+    return randr->priv->preferred[output];
 }
 
 
@@ -672,42 +1081,12 @@ xfce_randr_preferred_mode (XfceRandr *randr,
 RRMode *
 xfce_randr_clonable_modes (XfceRandr *randr)
 {
-    gint l, n, candidate, found;
-    guint m;
-    RRMode modes[randr->noutput];
-
     g_return_val_if_fail (randr != NULL, NULL);
 
-    /* walk all available modes */
-    for (n = 0; n < randr->priv->resources->nmode; ++n)
-    {
-        candidate = TRUE;
-        /* walk all connected outputs */
-        for (m = 0; m < randr->noutput; ++m)
-        {
-            found = FALSE;
-            /* walk supported modes from this output */
-            for (l = 0; l < randr->priv->output_info[m]->nmode; ++l)
-            {
-                if (randr->priv->resources->modes[n].width == randr->priv->modes[m][l].width
-                    && randr->priv->resources->modes[n].height == randr->priv->modes[m][l].height)
-                {
-                    found = TRUE;
-                    modes[m] = randr->priv->output_info[m]->modes[l];
-                    break;
-                }
-            }
-
-            /* if it is not present in one output, forget it */
-            candidate &= found;
-        }
-
-        /* common to all outputs, can be used for clone mode */
-        if (candidate)
-            return g_memdup2 (modes, sizeof (RRMode) * randr->noutput);
-    }
+    if (randr->priv->clonable == NULL)
+        return NULL;
 
-    return NULL;
+    return g_memdup2 (randr->priv->clonable, sizeof (RRMode) * randr->noutput);
 }
 
 
@@ -721,6 +1100,21 @@ xfce_randr_get_edid (XfceRandr *randr,
 
 
 
+/**
+ * xfce_randr_edids_complete:
+ * @randr: a #XfceRandr.
+ *
+ * Returns: %TRUE if every connected output had an EDID at the last reload,
+ *          %FALSE if some EDID checksums are only guessed from the output.
+ **/
+gboolean
+xfce_randr_edids_complete (XfceRandr *randr)
+{
+    return randr->priv->edids_complete;
+}
+
+
+
 const gchar *
 xfce_randr_get_edid_by_id (XfceRandr *randr,
                            RROutput output)
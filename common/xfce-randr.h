@@ -20,6 +20,8 @@
 #ifndef __XFCE_RANDR_H__
 #define __XFCE_RANDR_H__
 
+#include "display-profiles.h"
+
 #include <X11/extensions/Xrandr.h>
 #include <gdk/gdk.h>
 #include <xfconf/xfconf.h>
@@ -34,6 +36,7 @@ typedef struct _XfceRandrPrivate XfceRandrPrivate;
 typedef struct _XfceRRMode XfceRRMode;
 typedef enum _XfceOutputStatus XfceOutputStatus;
 typedef struct _XfceOutputPosition XfceOutputPosition;
+typedef struct _XfceRandrQuery XfceRandrQuery;
 
 enum _XfceOutputStatus
 {
@@ -56,6 +59,31 @@ struct _XfceOutputPosition
     gint y;
 };
 
+typedef enum
+{
+    XFCE_RANDR_QUERY_EDID = 1 << 0,
+} XfceRandrQueryFlags;
+
+struct _XfceRandrQuery
+{
+    XRRScreenResources *resources;
+    gint noutput;
+    gint ncrtc;
+
+    /* indexed like the outputs and CRTCs of the resources, NULL if the
+     * request failed; steal entries by setting them to NULL */
+    XRROutputInfo **output_info;
+    XRRCrtcInfo **crtc_info;
+    gdouble *crtc_scalex;
+    gdouble *crtc_scaley;
+
+    /* only with XFCE_RANDR_QUERY_EDID, NULL for disconnected outputs */
+    guint8 **edid;
+    gsize *edid_length;
+
+    RROutput primary;
+};
+
 struct _XfceRandr
 {
     /* number of connected outputs */
@@ -89,7 +117,7 @@ xfce_randr_reload (XfceRandr *randr);
 void
 xfce_randr_save_output (XfceRandr *randr,
                         const gchar *scheme,
-                        XfconfChannel *channel,
+                        DisplayProfileWriter *writer,
                         guint output,
                         gboolean duplicate);
 
@@ -98,9 +126,18 @@ xfce_randr_load (XfceRandr *randr,
                  const gchar *scheme,
                  XfconfChannel *channel);
 
-guint8 *
-xfce_randr_read_edid_data (Display *xdisplay,
-                           RROutput output);
+XfceRandrQuery *
+xfce_randr_query_new (Display *xdisplay,
+                      Window root,
+                      XRRScreenResources *resources,
+                      XfceRandrQueryFlags flags);
+
+void
+xfce_randr_query_free (XfceRandrQuery *query);
+
+gint
+xfce_randr_query_find_crtc (XfceRandrQuery *query,
+                            RRCrtc crtc);
 
 const XfceRRMode *
 xfce_randr_find_mode_by_id (XfceRandr *randr,
@@ -118,6 +155,9 @@ const gchar *
 xfce_randr_get_edid (XfceRandr *randr,
                      guint noutput);
 
+gboolean
+xfce_randr_edids_complete (XfceRandr *randr);
+
 const gchar *
 xfce_randr_get_edid_by_id (XfceRandr *randr,
                            RROutput output);
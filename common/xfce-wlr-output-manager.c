@@ -20,7 +20,12 @@
 #include "xfce-wlr-output-manager.h"
 
 #include <gdk/gdkwayland.h>
+#include <string.h>
 #include <sys/mman.h>
+#include <unistd.h>
+
+/* a compositor that did not describe its outputs by then never will */
+#define WAIT_READY_TIMEOUT 5
 
 
 
@@ -44,6 +49,8 @@ registry_global (void *data, struct wl_registry *registry, uint32_t id, const ch
 static void
 registry_global_remove (void *data, struct wl_registry *registry, uint32_t id);
 static void
+registry_done (void *data, struct wl_callback *callback, uint32_t callback_data);
+static void
 manager_head (void *data, struct zwlr_output_manager_v1 *wl_manager, struct zwlr_output_head_v1 *head);
 static void
 manager_done (void *data, struct zwlr_output_manager_v1 *wl_manager, uint32_t serial);
@@ -103,6 +110,16 @@ enum
     PROP_0,
     PROP_LISTENER,
     PROP_LISTENER_DATA,
+    PROP_ASYNC,
+};
+
+struct _XfceWlrEdid
+{
+    GBytes *bytes;
+    gchar *checksum;
+    const EdidInfo *info;
+    gboolean info_loaded;
+    guint ref_count;
 };
 
 struct _XfceWlrOutputManager
@@ -116,6 +133,10 @@ struct _XfceWlrOutputManager
     gboolean saw_first_wlr_done;
     gboolean saw_first_xfce_done;
 
+    gboolean async;
+    gboolean ready;
+    struct wl_callback *registry_callback;
+
     XfceWlrOutputListener listener;
     gpointer listener_data;
     GPtrArray *outputs;
@@ -126,6 +147,10 @@ static const struct wl_registry_listener registry_listener = {
     .global_remove = registry_global_remove,
 };
 
+static const struct wl_callback_listener registry_callback_listener = {
+    .done = registry_done,
+};
+
 static const struct zwlr_output_manager_v1_listener manager_listener = {
     .head = manager_head,
     .done = manager_done,
@@ -173,6 +198,11 @@ G_DEFINE_FINAL_TYPE (XfceWlrOutputManager, xfce_wlr_output_manager, G_TYPE_OBJEC
 
 
 
+/* EDIDs by content, shared by all managers and heads */
+static GHashTable *edid_store = NULL;
+
+
+
 static void
 xfce_wlr_output_manager_class_init (XfceWlrOutputManagerClass *klass)
 {
@@ -195,6 +225,34 @@ xfce_wlr_output_manager_class_init (XfceWlrOutputManagerClass *klass)
                                                            NULL,
                                                            NULL,
                                                            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+    g_object_class_install_property (gobject_class,
+                                     PROP_ASYNC,
+                                     g_param_spec_boolean ("async",
+                                                           NULL,
+                                                           NULL,
+                                                           FALSE,
+                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+    g_signal_new ("ready",
+                  G_TYPE_FROM_CLASS (gobject_class),
+                  G_SIGNAL_RUN_LAST,
+                  0, NULL, NULL,
+                  g_cclosure_marshal_VOID__VOID,
+                  G_TYPE_NONE, 0);
+
+    /* emitted before the XfceWlrOutput or XfceWlrMode is freed */
+    g_signal_new ("head-finished",
+                  G_TYPE_FROM_CLASS (gobject_class),
+                  G_SIGNAL_RUN_LAST,
+                  0, NULL, NULL,
+                  g_cclosure_marshal_VOID__POINTER,
+                  G_TYPE_NONE, 1, G_TYPE_POINTER);
+    g_signal_new ("mode-finished",
+                  G_TYPE_FROM_CLASS (gobject_class),
+                  G_SIGNAL_RUN_LAST,
+                  0, NULL, NULL,
+                  g_cclosure_marshal_VOID__POINTER,
+                  G_TYPE_NONE, 1, G_TYPE_POINTER);
 }
 
 
@@ -209,6 +267,52 @@ free_mode (gpointer data)
 
 
 
+static XfceWlrEdid *
+edid_store_get (gconstpointer data,
+                gsize size)
+{
+    XfceWlrEdid *edid;
+    GBytes *key;
+
+    if (edid_store == NULL)
+        edid_store = g_hash_table_new (g_bytes_hash, g_bytes_equal);
+
+    /* look up without copying the mapped memory */
+    key = g_bytes_new_static (data, size);
+    edid = g_hash_table_lookup (edid_store, key);
+    g_bytes_unref (key);
+
+    if (edid != NULL)
+    {
+        edid->ref_count++;
+        return edid;
+    }
+
+    edid = g_new0 (XfceWlrEdid, 1);
+    edid->bytes = g_bytes_new (data, size);
+    edid->checksum = g_compute_checksum_for_bytes (G_CHECKSUM_SHA1, edid->bytes);
+    edid->ref_count = 1;
+    g_hash_table_insert (edid_store, edid->bytes, edid);
+
+    return edid;
+}
+
+
+
+static void
+edid_store_release (XfceWlrEdid *edid)
+{
+    if (edid == NULL || --edid->ref_count > 0)
+        return;
+
+    g_hash_table_remove (edid_store, edid->bytes);
+    g_bytes_unref (edid->bytes);
+    g_free (edid->checksum);
+    g_free (edid);
+}
+
+
+
 static void
 free_output (gpointer data)
 {
@@ -223,7 +327,7 @@ free_output (gpointer data)
     g_free (output->manufacturer);
     g_free (output->model);
     g_free (output->serial_number);
-    g_free (output->edid_bytes);
+    edid_store_release (output->edid_blob);
     g_free (output->edid);
     g_free (output);
 }
@@ -255,6 +359,10 @@ xfce_wlr_output_manager_get_property (GObject *object,
             g_value_set_pointer (value, manager->listener_data);
             break;
 
+        case PROP_ASYNC:
+            g_value_set_boolean (value, manager->async);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
             break;
@@ -281,6 +389,10 @@ xfce_wlr_output_manager_set_property (GObject *object,
             manager->listener_data = g_value_get_pointer (value);
             break;
 
+        case PROP_ASYNC:
+            manager->async = g_value_get_boolean (value);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
             break;
@@ -290,15 +402,21 @@ xfce_wlr_output_manager_set_property (GObject *object,
 
 
 static void
-xfce_wlr_output_manager_constructed (GObject *object)
+set_ready (XfceWlrOutputManager *manager)
 {
-    XfceWlrOutputManager *manager = XFCE_WLR_OUTPUT_MANAGER (object);
-    struct wl_display *wl_display = gdk_wayland_display_get_wl_display (gdk_display_get_default ());
+    if (manager->ready)
+        return;
 
-    manager->outputs = g_ptr_array_new_with_free_func (free_output);
-    manager->wl_registry = wl_display_get_registry (wl_display);
-    wl_registry_add_listener (manager->wl_registry, &registry_listener, manager);
-    wl_display_roundtrip (wl_display);
+    manager->ready = TRUE;
+    g_signal_emit_by_name (manager, "ready");
+}
+
+
+
+/* returns whether there are heads to wait for */
+static gboolean
+listen_to_managers (XfceWlrOutputManager *manager)
+{
     if (manager->wl_manager != NULL)
         zwlr_output_manager_v1_add_listener (manager->wl_manager, &manager_listener, manager);
     else
@@ -311,8 +429,36 @@ xfce_wlr_output_manager_constructed (GObject *object)
     if (manager->xfce_manager != NULL)
         xfce_output_management_manager_private_v1_add_listener (manager->xfce_manager, &xfce_manager_listener, manager);
 
-    if (manager->wl_manager != NULL || manager->xfce_manager != NULL)
+    return manager->wl_manager != NULL || manager->xfce_manager != NULL;
+}
+
+
+
+static void
+xfce_wlr_output_manager_constructed (GObject *object)
+{
+    XfceWlrOutputManager *manager = XFCE_WLR_OUTPUT_MANAGER (object);
+    struct wl_display *wl_display = gdk_wayland_display_get_wl_display (gdk_display_get_default ());
+
+    manager->outputs = g_ptr_array_new_with_free_func (free_output);
+    manager->wl_registry = wl_display_get_registry (wl_display);
+    wl_registry_add_listener (manager->wl_registry, &registry_listener, manager);
+
+    if (manager->async)
+    {
+        /* the callback is done once all the globals have been announced, the rest
+         * of the initialization happens as GDK dispatches events */
+        manager->registry_callback = wl_display_sync (wl_display);
+        wl_callback_add_listener (manager->registry_callback, &registry_callback_listener, manager);
+        wl_display_flush (wl_display);
+    }
+    else
+    {
         wl_display_roundtrip (wl_display);
+        if (listen_to_managers (manager))
+            wl_display_roundtrip (wl_display);
+        set_ready (manager);
+    }
 
     G_OBJECT_CLASS (xfce_wlr_output_manager_parent_class)->constructed (object);
 }
@@ -324,13 +470,14 @@ xfce_wlr_output_manager_finalize (GObject *object)
 {
     XfceWlrOutputManager *manager = XFCE_WLR_OUTPUT_MANAGER (object);
 
+    if (manager->registry_callback != NULL)
+        wl_callback_destroy (manager->registry_callback);
     if (manager->xfce_manager != NULL)
         xfce_output_management_manager_private_v1_destroy (manager->xfce_manager);
     if (manager->wl_manager != NULL)
-    {
         zwlr_output_manager_v1_destroy (manager->wl_manager);
+    if (manager->outputs != NULL)
         g_ptr_array_unref (manager->outputs);
-    }
     wl_registry_destroy (manager->wl_registry);
 
     G_OBJECT_CLASS (xfce_wlr_output_manager_parent_class)->finalize (object);
@@ -366,6 +513,24 @@ registry_global_remove (void *data,
 
 
 
+static void
+registry_done (void *data,
+               struct wl_callback *callback,
+               uint32_t callback_data)
+{
+    XfceWlrOutputManager *manager = data;
+
+    g_clear_pointer (&manager->registry_callback, wl_callback_destroy);
+
+    /* without wlr-output-management, there will be no done event */
+    if (listen_to_managers (manager) && manager->wl_manager != NULL)
+        wl_display_flush (gdk_wayland_display_get_wl_display (gdk_display_get_default ()));
+    else
+        set_ready (manager);
+}
+
+
+
 static void
 manager_head (void *data,
               struct zwlr_output_manager_v1 *wl_manager,
@@ -376,6 +541,7 @@ manager_head (void *data,
 
     output->wl_head = head;
     output->new = TRUE;
+    output->added_time = g_get_monotonic_time ();
     output->scale = wl_fixed_from_double (1.0);
     output->manager = manager;
     g_ptr_array_add (manager->outputs, output);
@@ -389,8 +555,8 @@ output_make_edid (gpointer data,
                   gpointer user_data)
 {
     XfceWlrOutput *output = data;
-    if (output->edid_bytes != NULL)
-        output->edid = g_compute_checksum_for_data (G_CHECKSUM_SHA1, output->edid_bytes, output->edid_bytes_len);
+    if (output->edid_blob != NULL)
+        output->edid = g_strdup (output->edid_blob->checksum);
     else
     {
         gchar *edid_str = g_strdup_printf ("%s-%s-%s", output->serial_number, output->model, output->manufacturer);
@@ -421,6 +587,8 @@ notify_listener (XfceWlrOutputManager *manager,
         if (output->new)
             output->new = FALSE;
     }
+
+    set_ready (manager);
 }
 
 
@@ -563,6 +731,7 @@ head_finished (void *data,
 {
     XfceWlrOutput *output = data;
 
+    g_signal_emit_by_name (output->manager, "head-finished", output);
     g_clear_pointer (&output->wl_head, zwlr_output_head_v1_destroy);
     if (output->xfce_head == NULL || output->manager->xfce_manager == NULL)
     {
@@ -661,6 +830,7 @@ mode_finished (void *data,
                struct zwlr_output_mode_v1 *wl_mode)
 {
     XfceWlrMode *mode = data;
+    g_signal_emit_by_name (mode->output->manager, "mode-finished", mode);
     mode->output->modes = g_list_remove (mode->output->modes, mode);
     free_mode (mode);
 }
@@ -723,19 +893,30 @@ xfce_head_edid (void *data,
                 uint32_t size)
 {
     XfceWlrOutput *output = data;
+    XfceWlrEdid *edid = NULL;
     void *edid_mem;
 
-    g_clear_pointer (&output->edid_bytes, g_free);
-    output->edid_bytes_len = 0;
-
     edid_mem = mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
     if (edid_mem != MAP_FAILED)
     {
-        output->edid_bytes = g_memdup2 (edid_mem, size);
-        output->edid_bytes_len = size;
+        /* usually sent again unchanged, e.g. after a mode change */
+        if (output->edid_blob != NULL
+            && output->edid_bytes_len == size
+            && memcmp (output->edid_bytes, edid_mem, size) == 0)
+        {
+            munmap (edid_mem, size);
+            return;
+        }
 
+        edid = edid_store_get (edid_mem, size);
         munmap (edid_mem, size);
     }
+
+    edid_store_release (output->edid_blob);
+    output->edid_blob = edid;
+    output->edid_bytes = edid != NULL ? g_bytes_get_data (edid->bytes, NULL) : NULL;
+    output->edid_bytes_len = edid != NULL ? g_bytes_get_size (edid->bytes) : 0;
 }
 
 
@@ -768,6 +949,87 @@ xfce_wlr_output_manager_new (XfceWlrOutputListener listener,
 
 
 
+/**
+ * xfce_wlr_output_manager_new_async:
+ * @listener: called on every configuration change, like with
+ *            xfce_wlr_output_manager_new().
+ * @listener_data: data for @listener.
+ *
+ * Same as xfce_wlr_output_manager_new(), but returns without waiting for the
+ * compositor. The outputs are known once the manager emits "ready", after
+ * which xfce_wlr_output_manager_get_outputs() returns %NULL if the compositor
+ * does not support the wlr-output-management protocol.
+ *
+ * Returns: a new manager.
+ **/
+XfceWlrOutputManager *
+xfce_wlr_output_manager_new_async (XfceWlrOutputListener listener,
+                                   gpointer listener_data)
+{
+    return g_object_new (XFCE_TYPE_WLR_OUTPUT_MANAGER,
+                         "listener", listener,
+                         "listener-data", listener_data,
+                         "async", TRUE,
+                         NULL);
+}
+
+
+
+gboolean
+xfce_wlr_output_manager_is_ready (XfceWlrOutputManager *manager)
+{
+    g_return_val_if_fail (XFCE_IS_WLR_OUTPUT_MANAGER (manager), FALSE);
+    return manager->ready;
+}
+
+
+
+static gboolean
+wait_ready_timeout (gpointer data)
+{
+    gboolean *timed_out = data;
+
+    *timed_out = TRUE;
+
+    return G_SOURCE_REMOVE;
+}
+
+
+
+/**
+ * xfce_wlr_output_manager_wait_ready:
+ * @manager: a #XfceWlrOutputManager.
+ *
+ * Iterate the default main context until @manager is ready, for at most
+ * WAIT_READY_TIMEOUT seconds. Other sources are dispatched meanwhile.
+ *
+ * Returns: %FALSE if the compositor did not send the outputs in time.
+ **/
+gboolean
+xfce_wlr_output_manager_wait_ready (XfceWlrOutputManager *manager)
+{
+    gboolean timed_out = FALSE;
+    guint timeout_id;
+
+    g_return_val_if_fail (XFCE_IS_WLR_OUTPUT_MANAGER (manager), FALSE);
+
+    if (manager->ready)
+        return TRUE;
+
+    timeout_id = g_timeout_add_seconds (WAIT_READY_TIMEOUT, wait_ready_timeout, &timed_out);
+    while (!manager->ready && !timed_out)
+        g_main_context_iteration (NULL, TRUE);
+
+    if (!timed_out)
+        g_source_remove (timeout_id);
+    else
+        g_warning ("The compositor did not send its outputs within %d seconds", WAIT_READY_TIMEOUT);
+
+    return manager->ready;
+}
+
+
+
 gpointer
 xfce_wlr_output_manager_get_listener_data (XfceWlrOutputManager *manager)
 {
@@ -811,3 +1073,30 @@ xfce_wlr_output_manager_get_display_infos (XfceWlrOutputManager *manager)
 
     return display_infos;
 }
+
+
+
+/**
+ * xfce_wlr_output_get_edid_info:
+ * @output: a #XfceWlrOutput.
+ *
+ * Returns: the decoded EDID of @output, or %NULL if the compositor did not
+ *          send one or it is invalid.
+ **/
+const EdidInfo *
+xfce_wlr_output_get_edid_info (XfceWlrOutput *output)
+{
+    XfceWlrEdid *edid = output->edid_blob;
+
+    if (edid == NULL)
+        return NULL;
+
+    /* decoded once per unique EDID */
+    if (!edid->info_loaded)
+    {
+        edid->info = edid_info_lookup (g_bytes_get_data (edid->bytes, NULL), g_bytes_get_size (edid->bytes));
+        edid->info_loaded = TRUE;
+    }
+
+    return edid->info;
+}
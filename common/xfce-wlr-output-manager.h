@@ -19,6 +19,7 @@
 #ifndef __XFCE_WLR_OUTPUT_MANAGER_H__
 #define __XFCE_WLR_OUTPUT_MANAGER_H__
 
+#include "edid.h"
 #include "protocols/wlr-output-management-unstable-v1-client.h"
 #include "protocols/xfce-output-management-v1-client.h"
 
@@ -41,6 +42,9 @@ typedef enum _XfceWlrTransform
     XFCE_WLR_TRANSFORM_FLIPPED_270,
 } XfceWlrTransform;
 
+/* an EDID shared by all heads that report the same bytes */
+typedef struct _XfceWlrEdid XfceWlrEdid;
+
 typedef struct _XfceWlrOutput
 {
     XfceWlrOutputManager *manager;
@@ -56,9 +60,11 @@ typedef struct _XfceWlrOutput
     gchar *manufacturer;
     gchar *model;
     gchar *serial_number;
-    guchar *edid_bytes;
+    XfceWlrEdid *edid_blob;
+    const guchar *edid_bytes; /* owned by edid_blob */
     gsize edid_bytes_len;
     gchar *edid;
+    gint64 added_time; /* monotonic time the compositor announced it */
 
     /* writable */
     int32_t enabled;
@@ -85,6 +91,13 @@ typedef void (*XfceWlrOutputListener) (XfceWlrOutputManager *manager,
 XfceWlrOutputManager *
 xfce_wlr_output_manager_new (XfceWlrOutputListener listener,
                              gpointer listener_data);
+XfceWlrOutputManager *
+xfce_wlr_output_manager_new_async (XfceWlrOutputListener listener,
+                                   gpointer listener_data);
+gboolean
+xfce_wlr_output_manager_is_ready (XfceWlrOutputManager *manager);
+gboolean
+xfce_wlr_output_manager_wait_ready (XfceWlrOutputManager *manager);
 gpointer
 xfce_wlr_output_manager_get_listener_data (XfceWlrOutputManager *manager);
 struct zwlr_output_manager_v1 *
@@ -94,6 +107,9 @@ xfce_wlr_output_manager_get_outputs (XfceWlrOutputManager *manager);
 gchar **
 xfce_wlr_output_manager_get_display_infos (XfceWlrOutputManager *manager);
 
+const EdidInfo *
+xfce_wlr_output_get_edid_info (XfceWlrOutput *output);
+
 G_END_DECLS
 
 #endif /* !__XFCE_WLR_OUTPUT_MANAGER_H__ */
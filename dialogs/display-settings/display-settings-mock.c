@@ -0,0 +1,762 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "display-settings-mock.h"
+
+#include "common/display-mock.h"
+
+/* mode ids are 1-based indexes in DisplayMockOutput.modes, 0 means disabled */
+#define MOCK_MODE_NONE 0
+#define MOCK_MODE_ID(index) ((index) + 1)
+
+
+
+typedef struct _DisplayMockState
+{
+    guint mode_id;
+    RotationFlags rotation;
+    gdouble scale;
+    gint x;
+    gint y;
+    gboolean primary;
+} DisplayMockState;
+
+
+
+
+static void
+xfce_display_settings_mock_finalize (GObject *object);
+static guint
+xfce_display_settings_mock_get_n_outputs (XfceDisplaySettings *settings);
+static guint
+xfce_display_settings_mock_get_n_active_outputs (XfceDisplaySettings *settings);
+static gchar **
+xfce_display_settings_mock_get_display_infos (XfceDisplaySettings *settings);
+static GdkMonitor *
+xfce_display_settings_mock_get_monitor (XfceDisplaySettings *settings,
+                                        guint output_id);
+static const gchar *
+xfce_display_settings_mock_get_friendly_name (XfceDisplaySettings *settings,
+                                              guint output_id);
+static void
+xfce_display_settings_mock_get_geometry (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         GdkRectangle *geometry);
+static RotationFlags
+xfce_display_settings_mock_get_rotation (XfceDisplaySettings *settings,
+                                         guint output_id);
+static void
+xfce_display_settings_mock_set_rotation (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         RotationFlags rotation);
+static RotationFlags
+xfce_display_settings_mock_get_rotations (XfceDisplaySettings *settings,
+                                          guint output_id);
+static gdouble
+xfce_display_settings_mock_get_scale (XfceDisplaySettings *settings,
+                                      guint output_id);
+static void
+xfce_display_settings_mock_set_scale (XfceDisplaySettings *settings,
+                                      guint output_id,
+                                      gdouble scale);
+static void
+xfce_display_settings_mock_set_mode (XfceDisplaySettings *settings,
+                                     guint output_id,
+                                     guint mode_id);
+static void
+xfce_display_settings_mock_update_output_mode (XfceDisplaySettings *settings,
+                                               XfceOutput *output,
+                                               guint mode_id);
+static void
+xfce_display_settings_mock_set_position (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         gint x,
+                                         gint y);
+static XfceOutput *
+xfce_display_settings_mock_get_output (XfceDisplaySettings *settings,
+                                       guint output_id);
+static gboolean
+xfce_display_settings_mock_is_active (XfceDisplaySettings *settings,
+                                      guint output_id);
+static void
+xfce_display_settings_mock_set_active (XfceDisplaySettings *settings,
+                                       guint output_id,
+                                       gboolean active);
+static void
+xfce_display_settings_mock_update_output_active (XfceDisplaySettings *settings,
+                                                 XfceOutput *output,
+                                                 gboolean active);
+static gboolean
+xfce_display_settings_mock_is_primary (XfceDisplaySettings *settings,
+                                       guint output_id);
+static void
+xfce_display_settings_mock_set_primary (XfceDisplaySettings *settings,
+                                        guint output_id,
+                                        gboolean primary);
+static gboolean
+xfce_display_settings_mock_is_clonable (XfceDisplaySettings *settings);
+static void
+xfce_display_settings_mock_save (XfceDisplaySettings *settings,
+                                 DisplayProfileWriter *writer,
+                                 const gchar *scheme);
+static void
+xfce_display_settings_mock_mirror (XfceDisplaySettings *settings);
+static void
+xfce_display_settings_mock_unmirror (XfceDisplaySettings *settings);
+static void
+xfce_display_settings_mock_update_output_mirror (XfceDisplaySettings *settings,
+                                                 XfceOutput *output);
+static void
+xfce_display_settings_mock_extend (XfceDisplaySettings *settings,
+                                   guint output_id_1,
+                                   guint output_id_2,
+                                   ExtendedMode mode);
+
+
+
+struct _XfceDisplaySettingsMock
+{
+    XfceDisplaySettings __parent__;
+
+    DisplayMock *mock;
+
+    /* per output state, indexed like mock->outputs */
+    DisplayMockState *state;
+};
+
+
+
+G_DEFINE_FINAL_TYPE (XfceDisplaySettingsMock, xfce_display_settings_mock, XFCE_TYPE_DISPLAY_SETTINGS);
+
+
+
+static void
+xfce_display_settings_mock_class_init (XfceDisplaySettingsMockClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+    XfceDisplaySettingsClass *settings_class = XFCE_DISPLAY_SETTINGS_CLASS (klass);
+
+    gobject_class->finalize = xfce_display_settings_mock_finalize;
+
+    settings_class->get_n_outputs = xfce_display_settings_mock_get_n_outputs;
+    settings_class->get_n_active_outputs = xfce_display_settings_mock_get_n_active_outputs;
+    settings_class->get_display_infos = xfce_display_settings_mock_get_display_infos;
+    settings_class->get_monitor = xfce_display_settings_mock_get_monitor;
+    settings_class->get_friendly_name = xfce_display_settings_mock_get_friendly_name;
+    settings_class->get_geometry = xfce_display_settings_mock_get_geometry;
+    settings_class->get_rotation = xfce_display_settings_mock_get_rotation;
+    settings_class->set_rotation = xfce_display_settings_mock_set_rotation;
+    settings_class->get_rotations = xfce_display_settings_mock_get_rotations;
+    settings_class->get_scale = xfce_display_settings_mock_get_scale;
+    settings_class->set_scale = xfce_display_settings_mock_set_scale;
+    settings_class->set_mode = xfce_display_settings_mock_set_mode;
+    settings_class->update_output_mode = xfce_display_settings_mock_update_output_mode;
+    settings_class->set_position = xfce_display_settings_mock_set_position;
+    settings_class->get_output = xfce_display_settings_mock_get_output;
+    settings_class->is_active = xfce_display_settings_mock_is_active;
+    settings_class->set_active = xfce_display_settings_mock_set_active;
+    settings_class->update_output_active = xfce_display_settings_mock_update_output_active;
+    settings_class->is_primary = xfce_display_settings_mock_is_primary;
+    settings_class->set_primary = xfce_display_settings_mock_set_primary;
+    settings_class->is_clonable = xfce_display_settings_mock_is_clonable;
+    settings_class->save = xfce_display_settings_mock_save;
+    settings_class->mirror = xfce_display_settings_mock_mirror;
+    settings_class->unmirror = xfce_display_settings_mock_unmirror;
+    settings_class->update_output_mirror = xfce_display_settings_mock_update_output_mirror;
+    settings_class->extend = xfce_display_settings_mock_extend;
+}
+
+
+
+
+
+static void
+xfce_display_settings_mock_init (XfceDisplaySettingsMock *settings)
+{
+}
+
+
+
+static void
+xfce_display_settings_mock_finalize (GObject *object)
+{
+    XfceDisplaySettingsMock *settings = XFCE_DISPLAY_SETTINGS_MOCK (object);
+
+    g_free (settings->state);
+    display_mock_free (settings->mock);
+
+    G_OBJECT_CLASS (xfce_display_settings_mock_parent_class)->finalize (object);
+}
+
+
+
+static const DisplayMockMode *
+mock_find_mode (XfceDisplaySettingsMock *settings,
+                guint output_id,
+                guint mode_id)
+{
+    DisplayMockOutput *output = g_ptr_array_index (settings->mock->outputs, output_id);
+
+    if (mode_id == MOCK_MODE_NONE || mode_id > output->n_modes)
+        return NULL;
+
+    return &output->modes[mode_id - 1];
+}
+
+
+
+static guint
+xfce_display_settings_mock_get_n_outputs (XfceDisplaySettings *settings)
+{
+    return XFCE_DISPLAY_SETTINGS_MOCK (settings)->mock->outputs->len;
+}
+
+
+
+static guint
+xfce_display_settings_mock_get_n_active_outputs (XfceDisplaySettings *settings)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    guint count = 0;
+
+    for (guint n = 0; n < msettings->mock->outputs->len; n++)
+    {
+        if (msettings->state[n].mode_id != MOCK_MODE_NONE)
+            count++;
+    }
+
+    return count;
+}
+
+
+
+static gchar **
+xfce_display_settings_mock_get_display_infos (XfceDisplaySettings *settings)
+{
+    return display_mock_get_display_infos (XFCE_DISPLAY_SETTINGS_MOCK (settings)->mock);
+}
+
+
+
+static GdkMonitor *
+xfce_display_settings_mock_get_monitor (XfceDisplaySettings *settings,
+                                        guint output_id)
+{
+    return NULL;
+}
+
+
+
+static const gchar *
+xfce_display_settings_mock_get_friendly_name (XfceDisplaySettings *settings,
+                                              guint output_id)
+{
+    DisplayMockOutput *output = g_ptr_array_index (XFCE_DISPLAY_SETTINGS_MOCK (settings)->mock->outputs, output_id);
+    return output->friendly_name;
+}
+
+
+
+static void
+xfce_display_settings_mock_get_geometry (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         GdkRectangle *geometry)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    DisplayMockState *state = &msettings->state[output_id];
+    const DisplayMockMode *mode = mock_find_mode (msettings, output_id, state->mode_id);
+    if (mode == NULL)
+        mode = mock_find_mode (msettings, output_id, MOCK_MODE_ID (0));
+
+    geometry->x = state->x;
+    geometry->y = state->y;
+
+    if (state->rotation & (ROTATION_FLAGS_90 | ROTATION_FLAGS_270))
+    {
+        geometry->width = mode->height / state->scale;
+        geometry->height = mode->width / state->scale;
+    }
+    else
+    {
+        geometry->width = mode->width / state->scale;
+        geometry->height = mode->height / state->scale;
+    }
+}
+
+
+
+static RotationFlags
+xfce_display_settings_mock_get_rotation (XfceDisplaySettings *settings,
+                                         guint output_id)
+{
+    return XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].rotation;
+}
+
+
+
+static void
+xfce_display_settings_mock_set_rotation (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         RotationFlags rotation)
+{
+    XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].rotation = rotation;
+}
+
+
+
+static RotationFlags
+xfce_display_settings_mock_get_rotations (XfceDisplaySettings *settings,
+                                          guint output_id)
+{
+    return ROTATION_FLAGS_ALL;
+}
+
+
+
+static gdouble
+xfce_display_settings_mock_get_scale (XfceDisplaySettings *settings,
+                                      guint output_id)
+{
+    return XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].scale;
+}
+
+
+
+static void
+xfce_display_settings_mock_set_scale (XfceDisplaySettings *settings,
+                                      guint output_id,
+                                      gdouble scale)
+{
+    XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].scale = scale;
+}
+
+
+
+static void
+xfce_display_settings_mock_set_mode (XfceDisplaySettings *settings,
+                                     guint output_id,
+                                     guint mode_id)
+{
+    XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].mode_id = (mode_id == -1U ? MOCK_MODE_ID (0) : mode_id);
+}
+
+
+
+static void
+output_set_mode_and_tranformation (XfceOutput *output,
+                                   const DisplayMockMode *mode,
+                                   guint mode_id,
+                                   DisplayMockState *state)
+{
+    if (mode != NULL)
+    {
+        output->mode->id = mode_id;
+        output->mode->width = mode->width;
+        output->mode->height = mode->height;
+        output->mode->rate = mode->rate;
+        output->rotation = state->rotation;
+        output->scale = state->scale;
+    }
+    else
+    {
+        output->mode->id = 0;
+        output->mode->width = output->pref_width;
+        output->mode->height = output->pref_height;
+        output->mode->rate = 0;
+        output->rotation = ROTATION_FLAGS_0;
+        output->scale = 1.0;
+    }
+}
+
+
+
+static void
+xfce_display_settings_mock_update_output_mode (XfceDisplaySettings *settings,
+                                               XfceOutput *output,
+                                               guint mode_id)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    const DisplayMockMode *mode = mock_find_mode (msettings, output->id, mode_id);
+    output_set_mode_and_tranformation (output, mode, mode_id, &msettings->state[output->id]);
+}
+
+
+
+static void
+xfce_display_settings_mock_set_position (XfceDisplaySettings *settings,
+                                         guint output_id,
+                                         gint x,
+                                         gint y)
+{
+    DisplayMockState *state = &XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id];
+    state->x = x;
+    state->y = y;
+}
+
+
+
+static XfceOutput *
+xfce_display_settings_mock_get_output (XfceDisplaySettings *settings,
+                                       guint output_id)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    DisplayMockOutput *mock_output = g_ptr_array_index (msettings->mock->outputs, output_id);
+    DisplayMockState *state = &msettings->state[output_id];
+    XfceOutput *output = g_new0 (XfceOutput, 1);
+
+    output->id = output_id;
+    output->friendly_name = mock_output->friendly_name;
+    output->x = state->x;
+    output->y = state->y;
+    output->active = state->mode_id != MOCK_MODE_NONE;
+    output->pref_width = mock_output->modes[0].width;
+    output->pref_height = mock_output->modes[0].height;
+
+    output->mode = g_new0 (XfceMode, 1);
+    output_set_mode_and_tranformation (output, mock_find_mode (msettings, output_id, state->mode_id),
+                                       state->mode_id, state);
+
+    output->n_modes = mock_output->n_modes;
+    output->modes = g_new (XfceMode *, mock_output->n_modes);
+    for (guint n = 0; n < mock_output->n_modes; n++)
+    {
+        XfceMode *mode = g_new (XfceMode, 1);
+        mode->id = MOCK_MODE_ID (n);
+        mode->width = mock_output->modes[n].width;
+        mode->height = mock_output->modes[n].height;
+        mode->rate = mock_output->modes[n].rate;
+        output->modes[n] = mode;
+    }
+
+    return output;
+}
+
+
+
+static gboolean
+xfce_display_settings_mock_is_active (XfceDisplaySettings *settings,
+                                      guint output_id)
+{
+    return XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].mode_id != MOCK_MODE_NONE;
+}
+
+
+
+static void
+xfce_display_settings_mock_set_active (XfceDisplaySettings *settings,
+                                       guint output_id,
+                                       gboolean active)
+{
+    XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].mode_id = active ? MOCK_MODE_ID (0) : MOCK_MODE_NONE;
+}
+
+
+
+static void
+xfce_display_settings_mock_update_output_active (XfceDisplaySettings *settings,
+                                                 XfceOutput *output,
+                                                 gboolean active)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    DisplayMockState *state = &msettings->state[output->id];
+    const DisplayMockMode *mode = mock_find_mode (msettings, output->id, state->mode_id);
+    output_set_mode_and_tranformation (output, mode, state->mode_id, state);
+}
+
+
+
+static gboolean
+xfce_display_settings_mock_is_primary (XfceDisplaySettings *settings,
+                                       guint output_id)
+{
+    return XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].primary;
+}
+
+
+
+static void
+xfce_display_settings_mock_set_primary (XfceDisplaySettings *settings,
+                                        guint output_id,
+                                        gboolean primary)
+{
+    XFCE_DISPLAY_SETTINGS_MOCK (settings)->state[output_id].primary = primary;
+}
+
+
+
+static guint *
+mock_clonable_modes (XfceDisplaySettingsMock *settings)
+{
+    DisplayMockOutput *first = g_ptr_array_index (settings->mock->outputs, 0);
+    guint n_outputs = settings->mock->outputs->len;
+    guint *clonable_modes = g_new0 (guint, n_outputs);
+
+    /* the largest resolution of the first output that all others have too */
+    for (guint m = 0; m < first->n_modes; m++)
+    {
+        guint n;
+
+        clonable_modes[0] = MOCK_MODE_ID (m);
+        for (n = 1; n < n_outputs; n++)
+        {
+            DisplayMockOutput *output = g_ptr_array_index (settings->mock->outputs, n);
+
+            clonable_modes[n] = MOCK_MODE_NONE;
+            for (guint k = 0; k < output->n_modes; k++)
+            {
+                if (output->modes[k].width == first->modes[m].width
+                    && output->modes[k].height == first->modes[m].height)
+                {
+                    clonable_modes[n] = MOCK_MODE_ID (k);
+                    break;
+                }
+            }
+            if (clonable_modes[n] == MOCK_MODE_NONE)
+                break;
+        }
+
+        if (n == n_outputs)
+            return clonable_modes;
+    }
+
+    g_free (clonable_modes);
+    return NULL;
+}
+
+
+
+static gboolean
+xfce_display_settings_mock_is_clonable (XfceDisplaySettings *settings)
+{
+    guint *clonable_modes = mock_clonable_modes (XFCE_DISPLAY_SETTINGS_MOCK (settings));
+    gboolean clonable = clonable_modes != NULL;
+    g_free (clonable_modes);
+    return clonable;
+}
+
+
+
+static void
+xfce_display_settings_mock_save (XfceDisplaySettings *settings,
+                                 DisplayProfileWriter *writer,
+                                 const gchar *scheme)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    gchar property[512];
+    gchar *str_value;
+
+    /* the same properties as xfce_randr_save_output(), edids are unique */
+    for (guint n = 0; n < msettings->mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (msettings->mock->outputs, n);
+        DisplayMockState *state = &msettings->state[n];
+        const DisplayMockMode *mode = mock_find_mode (msettings, n, state->mode_id);
+        gint degrees;
+
+        g_snprintf (property, sizeof (property), "/%s/%s", scheme, output->name);
+        display_profile_writer_set_string (writer, property, output->friendly_name);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/Active", scheme, output->name);
+        display_profile_writer_set_bool (writer, property, mode != NULL);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/EDID", scheme, output->name);
+        display_profile_writer_set_string (writer, property, output->edid);
+        g_snprintf (property, sizeof (property), "/%s/%s/DuplicateEDID", scheme, output->name);
+        display_profile_writer_set_bool (writer, property, FALSE);
+
+        if (mode == NULL)
+            continue;
+
+        str_value = g_strdup_printf ("%ux%u", mode->width, mode->height);
+        g_snprintf (property, sizeof (property), "/%s/%s/Resolution", scheme, output->name);
+        display_profile_writer_set_string (writer, property, str_value);
+        g_free (str_value);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/RefreshRate", scheme, output->name);
+        display_profile_writer_set_double (writer, property, mode->rate);
+
+        switch (state->rotation & ROTATION_MASK)
+        {
+            case ROTATION_FLAGS_90: degrees = 90; break;
+            case ROTATION_FLAGS_180: degrees = 180; break;
+            case ROTATION_FLAGS_270: degrees = 270; break;
+            default: degrees = 0; break;
+        }
+        g_snprintf (property, sizeof (property), "/%s/%s/Rotation", scheme, output->name);
+        display_profile_writer_set_int (writer, property, degrees);
+
+        switch (state->rotation & REFLECTION_MASK)
+        {
+            case ROTATION_FLAGS_REFLECT_X: str_value = "X"; break;
+            case ROTATION_FLAGS_REFLECT_Y: str_value = "Y"; break;
+            case ROTATION_FLAGS_REFLECT_X | ROTATION_FLAGS_REFLECT_Y: str_value = "XY"; break;
+            default: str_value = "0"; break;
+        }
+        g_snprintf (property, sizeof (property), "/%s/%s/Reflection", scheme, output->name);
+        display_profile_writer_set_string (writer, property, str_value);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/Primary", scheme, output->name);
+        display_profile_writer_set_bool (writer, property, state->primary);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/Scale", scheme, output->name);
+        display_profile_writer_set_double (writer, property, state->scale);
+
+        g_snprintf (property, sizeof (property), "/%s/%s/Position/X", scheme, output->name);
+        display_profile_writer_set_int (writer, property, state->x);
+        g_snprintf (property, sizeof (property), "/%s/%s/Position/Y", scheme, output->name);
+        display_profile_writer_set_int (writer, property, state->y);
+    }
+}
+
+
+
+static void
+xfce_display_settings_mock_mirror (XfceDisplaySettings *settings)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    guint *clonable_modes = mock_clonable_modes (msettings);
+    if (clonable_modes == NULL)
+    {
+        g_warn_if_reached ();
+        return;
+    }
+
+    for (guint n = 0; n < msettings->mock->outputs->len; n++)
+    {
+        msettings->state[n].mode_id = clonable_modes[n];
+        msettings->state[n].rotation = ROTATION_FLAGS_0;
+        msettings->state[n].scale = 1.0;
+        msettings->state[n].x = 0;
+        msettings->state[n].y = 0;
+    }
+
+    g_free (clonable_modes);
+}
+
+
+
+static void
+xfce_display_settings_mock_unmirror (XfceDisplaySettings *settings)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    gint x = 0;
+
+    for (guint n = 0; n < msettings->mock->outputs->len; n++)
+    {
+        msettings->state[n].mode_id = MOCK_MODE_ID (0);
+        msettings->state[n].rotation = ROTATION_FLAGS_0;
+        msettings->state[n].scale = 1.0;
+        msettings->state[n].x = x;
+        msettings->state[n].y = 0;
+        x += mock_find_mode (msettings, n, MOCK_MODE_ID (0))->width;
+    }
+}
+
+
+
+static void
+xfce_display_settings_mock_update_output_mirror (XfceDisplaySettings *settings,
+                                                 XfceOutput *output)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    DisplayMockState *state = &msettings->state[output->id];
+    const DisplayMockMode *mode = mock_find_mode (msettings, output->id, state->mode_id);
+
+    output->x = state->x;
+    output->y = state->y;
+    output_set_mode_and_tranformation (output, mode, state->mode_id, state);
+    output->active = (mode != NULL);
+}
+
+
+
+static void
+xfce_display_settings_mock_extend (XfceDisplaySettings *settings,
+                                   guint output_id_1,
+                                   guint output_id_2,
+                                   ExtendedMode mode)
+{
+    XfceDisplaySettingsMock *msettings = XFCE_DISPLAY_SETTINGS_MOCK (settings);
+    DisplayMockState *state_1 = &msettings->state[output_id_1];
+    DisplayMockState *state_2 = &msettings->state[output_id_2];
+    GdkRectangle geom_1, geom_2;
+
+    if (state_1->mode_id == MOCK_MODE_NONE || state_2->mode_id == MOCK_MODE_NONE)
+    {
+        g_warn_if_reached ();
+        return;
+    }
+
+    xfce_display_settings_mock_get_geometry (settings, output_id_1, &geom_1);
+    xfce_display_settings_mock_get_geometry (settings, output_id_2, &geom_2);
+
+    state_1->x = state_1->y = 0;
+    state_2->x = state_2->y = 0;
+    switch (mode)
+    {
+        case EXTENDED_MODE_RIGHT:
+            state_2->x = geom_1.width;
+            break;
+        case EXTENDED_MODE_LEFT:
+            state_1->x = geom_2.width;
+            break;
+        case EXTENDED_MODE_UP:
+            state_1->y = geom_2.height;
+            break;
+        case EXTENDED_MODE_DOWN:
+            state_2->y = geom_1.height;
+            break;
+        default:
+            break;
+    }
+}
+
+
+
+XfceDisplaySettings *
+xfce_display_settings_mock_new (GError **error)
+{
+    XfceDisplaySettingsMock *settings;
+    DisplayMock *mock;
+    gint x = 0;
+
+    mock = display_mock_new (error);
+    if (mock == NULL)
+        return NULL;
+
+    settings = g_object_new (XFCE_TYPE_DISPLAY_SETTINGS_MOCK, NULL);
+    settings->mock = mock;
+    settings->state = g_new0 (DisplayMockState, mock->outputs->len);
+
+    /* as many outputs as there are CRTCs start extended to the right */
+    for (guint n = 0; n < mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (mock->outputs, n);
+
+        settings->state[n].scale = 1.0;
+        if (n < mock->n_crtcs)
+        {
+            settings->state[n].mode_id = MOCK_MODE_ID (0);
+            settings->state[n].x = x;
+            settings->state[n].primary = n == 0;
+            x += output->modes[0].width;
+        }
+    }
+
+    return XFCE_DISPLAY_SETTINGS (settings);
+}
@@ -107,6 +107,7 @@ static gboolean
 xfce_display_settings_wayland_is_clonable (XfceDisplaySettings *settings);
 static void
 xfce_display_settings_wayland_save (XfceDisplaySettings *settings,
+                                    DisplayProfileWriter *writer,
                                     const gchar *scheme);
 static void
 xfce_display_settings_wayland_mirror (XfceDisplaySettings *settings);
@@ -120,6 +121,14 @@ xfce_display_settings_wayland_extend (XfceDisplaySettings *settings,
                                       guint output_id_1,
                                       guint output_id_2,
                                       ExtendedMode mode);
+static gboolean
+xfce_display_settings_wayland_wait_ready (XfceDisplaySettings *settings,
+                                          GError **error);
+
+static void
+manager_listener (XfceWlrOutputManager *manager,
+                  struct zwlr_output_manager_v1 *wl_manager,
+                  uint32_t serial);
 
 
 
@@ -173,6 +182,7 @@ xfce_display_settings_wayland_class_init (XfceDisplaySettingsWaylandClass *klass
     settings_class->unmirror = xfce_display_settings_wayland_unmirror;
     settings_class->update_output_mirror = xfce_display_settings_wayland_update_output_mirror;
     settings_class->extend = xfce_display_settings_wayland_extend;
+    settings_class->wait_ready = xfce_display_settings_wayland_wait_ready;
 }
 
 
@@ -185,6 +195,9 @@ xfce_display_settings_wayland_init (XfceDisplaySettingsWayland *settings)
     settings->dummy_mode = g_new0 (XfceWlrMode, 1);
     settings->dummy_mode->width = 640;
     settings->dummy_mode->height = 480;
+
+    /* the compositor answers while the profiles are migrated and the dialog is set up */
+    settings->manager = xfce_wlr_output_manager_new_async (manager_listener, settings);
 }
 
 
@@ -353,6 +366,7 @@ xfce_display_settings_wayland_get_friendly_name (XfceDisplaySettings *settings,
 {
     GPtrArray *outputs = xfce_wlr_output_manager_get_outputs (XFCE_DISPLAY_SETTINGS_WAYLAND (settings)->manager);
     XfceWlrOutput *output = g_ptr_array_index (outputs, output_id);
+    const EdidInfo *edid_info;
     const gchar *fallback;
 
     /* special case, a laptop */
@@ -363,6 +377,11 @@ xfce_display_settings_wayland_get_friendly_name (XfceDisplaySettings *settings,
     if (output->description != NULL)
         return output->description;
 
+    /* name the monitor from its EDID, like on X11 */
+    edid_info = xfce_wlr_output_get_edid_info (output);
+    if (edid_info != NULL && edid_info->display_name != NULL)
+        return edid_info->display_name;
+
     /* fallback */
     fallback = display_name_get_fallback (output->name);
     if (fallback != NULL)
@@ -765,7 +784,7 @@ static void
 output_save (XfceWlrOutput *output,
              XfceWlrMode *mode,
              const gchar *friendly_name,
-             XfconfChannel *channel,
+             DisplayProfileWriter *writer,
              const gchar *scheme,
              gboolean duplicate)
 {
@@ -776,19 +795,19 @@ output_save (XfceWlrOutput *output,
 
     /* save the device name */
     property = g_strdup_printf ("/%s/%s", scheme, output->name);
-    xfconf_channel_set_string (channel, property, friendly_name);
+    display_profile_writer_set_string (writer, property, friendly_name);
     g_free (property);
 
     property = g_strdup_printf ("/%s/%s/EDID", scheme, output->name);
-    xfconf_channel_set_string (channel, property, output->edid);
+    display_profile_writer_set_string (writer, property, output->edid);
     g_free (property);
     property = g_strdup_printf ("/%s/%s/DuplicateEDID", scheme, output->name);
-    xfconf_channel_set_bool (channel, property, duplicate);
+    display_profile_writer_set_bool (writer, property, duplicate);
     g_free (property);
 
     /* stop here if output is disabled */
     property = g_strdup_printf ("/%s/%s/Active", scheme, output->name);
-    xfconf_channel_set_bool (channel, property, output->enabled);
+    display_profile_writer_set_bool (writer, property, output->enabled);
     g_free (property);
     if (!output->enabled)
         return;
@@ -796,13 +815,13 @@ output_save (XfceWlrOutput *output,
     /* save the resolution */
     str_value = g_strdup_printf ("%dx%d", mode->width, mode->height);
     property = g_strdup_printf ("/%s/%s/Resolution", scheme, output->name);
-    xfconf_channel_set_string (channel, property, str_value);
+    display_profile_writer_set_string (writer, property, str_value);
     g_free (property);
     g_free (str_value);
 
     /* save the refresh rate */
     property = g_strdup_printf ("/%s/%s/RefreshRate", scheme, output->name);
-    xfconf_channel_set_double (channel, property, (gdouble) mode->refresh / 1000);
+    display_profile_writer_set_double (writer, property, (gdouble) mode->refresh / 1000);
     g_free (property);
 
     /* convert the rotation into degrees */
@@ -817,7 +836,7 @@ output_save (XfceWlrOutput *output,
 
     /* save the rotation in degrees */
     property = g_strdup_printf ("/%s/%s/Rotation", scheme, output->name);
-    xfconf_channel_set_int (channel, property, degrees);
+    display_profile_writer_set_int (writer, property, degrees);
     g_free (property);
 
     /* convert the reflection into a string */
@@ -831,21 +850,21 @@ output_save (XfceWlrOutput *output,
 
     /* save the reflection string */
     property = g_strdup_printf ("/%s/%s/Reflection", scheme, output->name);
-    xfconf_channel_set_string (channel, property, str_value);
+    display_profile_writer_set_string (writer, property, str_value);
     g_free (property);
 
     /* save the scale */
     scale = wl_fixed_to_double (output->scale);
     property = g_strdup_printf ("/%s/%s/Scale", scheme, output->name);
-    xfconf_channel_set_double (channel, property, scale);
+    display_profile_writer_set_double (writer, property, scale);
     g_free (property);
 
     /* save the position */
     property = g_strdup_printf ("/%s/%s/Position/X", scheme, output->name);
-    xfconf_channel_set_int (channel, property, MAX (output->x, 0));
+    display_profile_writer_set_int (writer, property, MAX (output->x, 0));
     g_free (property);
     property = g_strdup_printf ("/%s/%s/Position/Y", scheme, output->name);
-    xfconf_channel_set_int (channel, property, MAX (output->y, 0));
+    display_profile_writer_set_int (writer, property, MAX (output->y, 0));
     g_free (property);
 }
 
@@ -853,11 +872,11 @@ output_save (XfceWlrOutput *output,
 
 static void
 xfce_display_settings_wayland_save (XfceDisplaySettings *settings,
+                                    DisplayProfileWriter *writer,
                                     const gchar *scheme)
 {
     XfceDisplaySettingsWayland *wsettings = XFCE_DISPLAY_SETTINGS_WAYLAND (settings);
     GPtrArray *outputs = xfce_wlr_output_manager_get_outputs (wsettings->manager);
-    XfconfChannel *channel = xfce_display_settings_get_channel (settings);
     GHashTable *edids = g_hash_table_new (g_str_hash, g_str_equal);
     for (guint n = 0; n < outputs->len; n++)
     {
@@ -871,7 +890,7 @@ xfce_display_settings_wayland_save (XfceDisplaySettings *settings,
         XfceWlrMode *mode = get_current_mode (wsettings, output);
         const gchar *friendly_name = xfce_display_settings_wayland_get_friendly_name (settings, n);
         gboolean duplicate = GPOINTER_TO_INT (g_hash_table_lookup (edids, output->edid));
-        output_save (output, mode, friendly_name, channel, scheme, duplicate);
+        output_save (output, mode, friendly_name, writer, scheme, duplicate);
     }
     g_hash_table_destroy (edids);
 }
@@ -982,6 +1001,28 @@ xfce_display_settings_wayland_extend (XfceDisplaySettings *settings,
 
 
 
+static gboolean
+xfce_display_settings_wayland_wait_ready (XfceDisplaySettings *settings,
+                                          GError **error)
+{
+    XfceWlrOutputManager *manager = XFCE_DISPLAY_SETTINGS_WAYLAND (settings)->manager;
+
+    if (!xfce_wlr_output_manager_wait_ready (manager))
+    {
+        g_set_error (error, 0, 0, _("Your compositor did not report its outputs"));
+        return FALSE;
+    }
+    if (xfce_wlr_output_manager_get_outputs (manager) == NULL)
+    {
+        g_set_error (error, 0, 0, _("Your compositor does not seem to support the wlr-output-management protocol"));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+
 static void
 manager_listener (XfceWlrOutputManager *manager,
                   struct zwlr_output_manager_v1 *wl_manager,
@@ -1021,16 +1062,5 @@ manager_listener (XfceWlrOutputManager *manager,
 XfceDisplaySettings *
 xfce_display_settings_wayland_new (GError **error)
 {
-    XfceDisplaySettingsWayland *settings = g_object_new (XFCE_TYPE_DISPLAY_SETTINGS_WAYLAND, NULL);
-    XfceWlrOutputManager *manager = xfce_wlr_output_manager_new (manager_listener, settings);
-    settings->manager = manager;
-
-    if (xfce_wlr_output_manager_get_outputs (manager) == NULL)
-    {
-        g_object_unref (settings);
-        g_set_error (error, 0, 0, _("Your compositor does not seem to support the wlr-output-management protocol"));
-        return NULL;
-    }
-
-    return XFCE_DISPLAY_SETTINGS (settings);
+    return g_object_new (XFCE_TYPE_DISPLAY_SETTINGS_WAYLAND, NULL);
 }
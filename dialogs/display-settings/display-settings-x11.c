@@ -101,6 +101,7 @@ static gboolean
 xfce_display_settings_x11_is_clonable (XfceDisplaySettings *settings);
 static void
 xfce_display_settings_x11_save (XfceDisplaySettings *settings,
+                                DisplayProfileWriter *writer,
                                 const gchar *scheme);
 static void
 xfce_display_settings_x11_mirror (XfceDisplaySettings *settings);
@@ -114,6 +115,9 @@ xfce_display_settings_x11_extend (XfceDisplaySettings *settings,
                                   guint output_id_1,
                                   guint output_id_2,
                                   ExtendedMode mode);
+static gboolean
+xfce_display_settings_x11_wait_ready (XfceDisplaySettings *settings,
+                                      GError **error);
 
 
 
@@ -165,6 +169,7 @@ xfce_display_settings_x11_class_init (XfceDisplaySettingsX11Class *klass)
     settings_class->unmirror = xfce_display_settings_x11_unmirror;
     settings_class->update_output_mirror = xfce_display_settings_x11_update_output_mirror;
     settings_class->extend = xfce_display_settings_x11_extend;
+    settings_class->wait_ready = xfce_display_settings_x11_wait_ready;
 }
 
 
@@ -193,6 +198,10 @@ screen_on_event (GdkXEvent *gdk_xevent,
     if (xevent->type - xsettings->event_base != RRScreenChangeNotify)
         return GDK_FILTER_CONTINUE;
 
+    /* the outputs have not been queried yet, they will be up to date */
+    if (xsettings->randr == NULL)
+        return GDK_FILTER_CONTINUE;
+
     xfce_randr_reload (xsettings->randr);
     xfce_display_settings_reload (settings);
     g_signal_emit_by_name (G_OBJECT (settings), "outputs-changed");
@@ -207,7 +216,8 @@ xfce_display_settings_x11_finalize (GObject *object)
 {
     XfceDisplaySettingsX11 *settings = XFCE_DISPLAY_SETTINGS_X11 (object);
 
-    xfce_randr_free (settings->randr);
+    if (settings->randr != NULL)
+        xfce_randr_free (settings->randr);
     gdk_window_remove_filter (gdk_get_default_root_window (), screen_on_event, settings);
 
     G_OBJECT_CLASS (xfce_display_settings_x11_parent_class)->finalize (object);
@@ -568,10 +578,10 @@ xfce_display_settings_x11_is_clonable (XfceDisplaySettings *settings)
 
 static void
 xfce_display_settings_x11_save (XfceDisplaySettings *settings,
+                                DisplayProfileWriter *writer,
                                 const gchar *scheme)
 {
     XfceRandr *randr = XFCE_DISPLAY_SETTINGS_X11 (settings)->randr;
-    XfconfChannel *channel = xfce_display_settings_get_channel (settings);
     GHashTable *edids = g_hash_table_new (g_str_hash, g_str_equal);
     for (guint n = 0; n < randr->noutput; n++)
     {
@@ -583,7 +593,7 @@ xfce_display_settings_x11_save (XfceDisplaySettings *settings,
     {
         const gchar *edid = xfce_randr_get_edid (randr, n);
         gboolean duplicate = GPOINTER_TO_INT (g_hash_table_lookup (edids, edid));
-        xfce_randr_save_output (randr, scheme, channel, n, duplicate);
+        xfce_randr_save_output (randr, scheme, writer, n, duplicate);
     }
     g_hash_table_destroy (edids);
 }
@@ -696,11 +706,24 @@ xfce_display_settings_x11_extend (XfceDisplaySettings *settings,
 
 
 
+static gboolean
+xfce_display_settings_x11_wait_ready (XfceDisplaySettings *settings,
+                                      GError **error)
+{
+    XfceDisplaySettingsX11 *xsettings = XFCE_DISPLAY_SETTINGS_X11 (settings);
+
+    if (xsettings->randr == NULL)
+        xsettings->randr = xfce_randr_new (gdk_display_get_default (), error);
+
+    return xsettings->randr != NULL;
+}
+
+
+
 XfceDisplaySettings *
 xfce_display_settings_x11_new (GError **error)
 {
     XfceDisplaySettingsX11 *settings;
-    XfceRandr *randr;
     gint event_base, error_base;
 
     if (!XRRQueryExtension (gdk_x11_get_default_xdisplay (), &event_base, &error_base))
@@ -709,12 +732,8 @@ xfce_display_settings_x11_new (GError **error)
         return NULL;
     }
 
-    randr = xfce_randr_new (gdk_display_get_default (), error);
-    if (randr == NULL)
-        return NULL;
-
+    /* the outputs and their EDIDs are queried in wait_ready(), once the dialog is on screen */
     settings = g_object_new (XFCE_TYPE_DISPLAY_SETTINGS_X11, NULL);
-    settings->randr = randr;
     settings->event_base = event_base;
 
     /* set up notifications */
@@ -34,9 +34,17 @@
 #define WINDOWING_IS_X11() FALSE
 #endif
 
+#include "common/debug.h"
 #include "common/display-profiles.h"
 
+#ifdef ENABLE_DISPLAY_MOCK
+#include "display-settings-mock.h"
+
+#include "common/display-mock.h"
+#endif
+
 #include <libxfce4util/libxfce4util.h>
+#include <string.h>
 
 #ifdef HAVE_GTK_LAYER_SHELL
 #include <gtk-layer-shell.h>
@@ -64,6 +72,14 @@ typedef struct _XfceDisplaySettingsPrivate
     guint selected_output_id;
     gboolean supports_alpha;
     gboolean opt_minimal;
+
+    /* the profile list is filled once the profiles are fetched, and only
+     * the changed rows are updated afterwards */
+    gboolean profiles_requested;
+    gint64 profiles_request_time;
+    gulong profiles_changed_id;
+    GHashTable *changed_profiles;
+    guint changed_profiles_id;
 } XfceDisplaySettingsPrivate;
 
 
@@ -99,6 +115,22 @@ xfce_display_settings_init (XfceDisplaySettings *settings)
     priv->scroll_area = (GtkWidget *) foo_scroll_area_new ();
     g_signal_connect (priv->scroll_area, "destroy", G_CALLBACK (gtk_widget_destroyed), &priv->scroll_area);
     priv->popups = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) gtk_widget_destroy);
+    priv->changed_profiles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+}
+
+
+
+#define RESOLUTION_KEY(width, height) GUINT_TO_POINTER (((width) << 16) | (height))
+
+
+
+static void
+free_resolution (gpointer data)
+{
+    XfceResolution *resolution = data;
+    g_free (resolution->ratio_markup);
+    g_ptr_array_free (resolution->modes, TRUE);
+    g_free (resolution);
 }
 
 
@@ -107,6 +139,8 @@ static void
 free_output (gpointer data)
 {
     XfceOutput *output = data;
+    g_ptr_array_free (output->resolutions, TRUE);
+    g_hash_table_destroy (output->resolution_index);
     g_free (output->mode);
     for (guint n = 0; n < output->n_modes; n++)
         g_free (output->modes[n]);
@@ -126,6 +160,11 @@ xfce_display_settings_finalize (GObject *object)
         gtk_widget_destroy (priv->scroll_area);
     g_hash_table_destroy (priv->popups);
     g_list_free_full (priv->outputs, free_output);
+    if (priv->profiles_changed_id != 0)
+        g_signal_handler_disconnect (priv->channel, priv->profiles_changed_id);
+    if (priv->changed_profiles_id != 0)
+        g_source_remove (priv->changed_profiles_id);
+    g_hash_table_destroy (priv->changed_profiles);
 
     G_OBJECT_CLASS (xfce_display_settings_parent_class)->finalize (object);
 }
@@ -140,13 +179,23 @@ xfce_display_settings_new (gboolean opt_minimal,
 
     g_return_val_if_fail (error == NULL || *error == NULL, NULL);
 
+#ifdef ENABLE_DISPLAY_MOCK
+    /* replaces the backend of the windowing environment */
+    if (display_mock_enabled ())
+        settings = xfce_display_settings_mock_new (error);
+    else
+    {
+#endif
 #ifdef HAVE_XRANDR
-    if (GDK_IS_X11_DISPLAY (gdk_display_get_default ()))
-        settings = xfce_display_settings_x11_new (error);
+        if (GDK_IS_X11_DISPLAY (gdk_display_get_default ()))
+            settings = xfce_display_settings_x11_new (error);
 #endif
 #ifdef ENABLE_WAYLAND
-    if (GDK_IS_WAYLAND_DISPLAY (gdk_display_get_default ()))
-        settings = xfce_display_settings_wayland_new (error);
+        if (GDK_IS_WAYLAND_DISPLAY (gdk_display_get_default ()))
+            settings = xfce_display_settings_wayland_new (error);
+#endif
+#ifdef ENABLE_DISPLAY_MOCK
+    }
 #endif
 
     if (settings != NULL)
@@ -163,6 +212,35 @@ xfce_display_settings_new (gboolean opt_minimal,
 
 
 
+/**
+ * xfce_display_settings_wait_ready:
+ * @settings: a #XfceDisplaySettings.
+ * @error: return location for a #GError, or %NULL.
+ *
+ * Wait until the outputs of @settings are known. This must be called before
+ * using the outputs, preferably as late as possible so that other parts of
+ * the initialization can happen meanwhile.
+ *
+ * Returns: %FALSE if display settings are not supported after all.
+ **/
+gboolean
+xfce_display_settings_wait_ready (XfceDisplaySettings *settings,
+                                  GError **error)
+{
+    XfceDisplaySettingsClass *klass;
+
+    g_return_val_if_fail (XFCE_IS_DISPLAY_SETTINGS (settings), FALSE);
+    g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+    klass = XFCE_DISPLAY_SETTINGS_GET_CLASS (settings);
+    if (klass->wait_ready == NULL)
+        return TRUE;
+
+    return klass->wait_ready (settings, error);
+}
+
+
+
 gboolean
 xfce_display_settings_is_minimal (XfceDisplaySettings *settings)
 {
@@ -227,6 +305,56 @@ xfce_display_settings_get_outputs (XfceDisplaySettings *settings)
 
 
 
+static void
+output_index_resolutions (XfceOutput *output)
+{
+    XfceResolution *resolution;
+
+    output->resolutions = g_ptr_array_new_with_free_func (free_resolution);
+    output->resolution_index = g_hash_table_new (NULL, NULL);
+
+    for (guint n = 0; n < output->n_modes; n++)
+    {
+        XfceMode *mode = output->modes[n];
+
+        resolution = g_hash_table_lookup (output->resolution_index, RESOLUTION_KEY (mode->width, mode->height));
+        if (resolution == NULL)
+        {
+            resolution = g_new0 (XfceResolution, 1);
+            resolution->width = mode->width;
+            resolution->height = mode->height;
+            resolution->index = output->resolutions->len;
+            resolution->modes = g_ptr_array_new ();
+            g_ptr_array_add (output->resolutions, resolution);
+            g_hash_table_insert (output->resolution_index, RESOLUTION_KEY (mode->width, mode->height), resolution);
+        }
+        g_ptr_array_add (resolution->modes, mode);
+    }
+}
+
+
+
+/**
+ * xfce_output_get_resolution:
+ * @output: an #XfceOutput.
+ * @width: the width of the resolution.
+ * @height: the height of the resolution.
+ *
+ * Returns: (nullable) (transfer none): the modes of @output with the given
+ *          size, or %NULL if @output does not support it.
+ **/
+XfceResolution *
+xfce_output_get_resolution (XfceOutput *output,
+                            guint width,
+                            guint height)
+{
+    g_return_val_if_fail (output != NULL, NULL);
+
+    return g_hash_table_lookup (output->resolution_index, RESOLUTION_KEY (width, height));
+}
+
+
+
 void
 xfce_display_settings_set_outputs (XfceDisplaySettings *settings)
 {
@@ -242,6 +370,7 @@ xfce_display_settings_set_outputs (XfceDisplaySettings *settings)
     for (guint n = 0; n < n_outputs; n++)
     {
         XfceOutput *output = XFCE_DISPLAY_SETTINGS_GET_CLASS (settings)->get_output (settings, n);
+        output_index_resolutions (output);
         priv->outputs = g_list_prepend (priv->outputs, output);
     }
     priv->outputs = g_list_reverse (priv->outputs);
@@ -415,100 +544,303 @@ popup_draw (GtkWidget *popup,
 }
 
 static GtkWidget *
-popup_get (XfceDisplaySettings *settings,
-           gint output_id)
+popup_new (XfceDisplaySettings *settings)
 {
     XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
-    GtkWidget *popup = NULL;
-    GObject *label;
+    GtkWidget *popup;
+
+    if (gtk_builder_add_from_resource (priv->builder, "/org/xfce/settings/identity-popup.glade", NULL) == 0)
+        return NULL;
+
+    popup = GTK_WIDGET (gtk_builder_get_object (priv->builder, "popup"));
+    gtk_widget_set_name (popup, "XfceDisplayDialogPopup");
+
+    /* the builder only remembers the last popup, keep the labels around */
+    g_object_set_data (G_OBJECT (popup), "display-number", gtk_builder_get_object (priv->builder, "display_number"));
+    g_object_set_data (G_OBJECT (popup), "display-name", gtk_builder_get_object (priv->builder, "display_name"));
+    g_object_set_data (G_OBJECT (popup), "display-details", gtk_builder_get_object (priv->builder, "display_details"));
+
+    gtk_widget_set_app_paintable (popup, TRUE);
+    g_signal_connect (G_OBJECT (popup), "draw", G_CALLBACK (popup_draw), settings);
+    g_signal_connect (G_OBJECT (popup), "screen-changed", G_CALLBACK (popup_screen_changed), settings);
+    popup_screen_changed (popup, NULL, settings);
+
+#ifdef HAVE_GTK_LAYER_SHELL
+    if (gtk_layer_is_supported ())
+    {
+        gtk_layer_init_for_window (GTK_WINDOW (popup));
+        gtk_layer_set_layer (GTK_WINDOW (popup), GTK_LAYER_SHELL_LAYER_OVERLAY);
+        gtk_layer_set_exclusive_zone (GTK_WINDOW (popup), -1);
+        gtk_layer_set_anchor (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_LEFT, TRUE);
+        gtk_layer_set_anchor (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_TOP, TRUE);
+    }
+#endif
+
+    /* realize it now, so that toggling the popups only maps and unmaps them */
+    gtk_widget_realize (popup);
+
+    return popup;
+}
+
+
+
+static void
+popup_update (XfceDisplaySettings *settings,
+              GtkWidget *popup,
+              gint output_id)
+{
+    GtkLabel *label;
+    GtkRequisition size;
     GdkRectangle geom;
     const gchar *color_hex = "#FFFFFF";
     gchar *text;
-    gint window_width, window_height;
 
-    if (gtk_builder_add_from_resource (priv->builder, "/org/xfce/settings/identity-popup.glade", NULL) != 0)
+    label = g_object_get_data (G_OBJECT (popup), "display-number");
+    if (xfce_display_settings_get_n_outputs (settings) > 1)
+    {
+        text = g_markup_printf_escaped ("<span foreground='%s' font='Bold 28'>%d</span>",
+                                        color_hex, output_id + 1);
+        gtk_label_set_markup (label, text);
+        g_free (text);
+        gtk_widget_set_margin_start (GTK_WIDGET (label), 12);
+        gtk_widget_set_margin_end (GTK_WIDGET (label), 6);
+    }
+    else
     {
-        popup = GTK_WIDGET (gtk_builder_get_object (priv->builder, "popup"));
-        gtk_widget_set_name (popup, "XfceDisplayDialogPopup");
+        gtk_label_set_text (label, NULL);
+        gtk_widget_set_margin_start (GTK_WIDGET (label), 0);
+        gtk_widget_set_margin_end (GTK_WIDGET (label), 0);
+    }
 
-        gtk_widget_set_app_paintable (popup, TRUE);
-        g_signal_connect (G_OBJECT (popup), "draw", G_CALLBACK (popup_draw), settings);
-        g_signal_connect (G_OBJECT (popup), "screen-changed", G_CALLBACK (popup_screen_changed), settings);
+    label = g_object_get_data (G_OBJECT (popup), "display-name");
+    text = g_markup_printf_escaped ("<span foreground='%s' font='Bold 10'>%s %s</span>",
+                                    color_hex, _("Display:"),
+                                    xfce_display_settings_get_friendly_name (settings, output_id));
+    gtk_label_set_markup (label, text);
+    g_free (text);
+
+    xfce_display_settings_get_geometry (settings, output_id, &geom);
+    label = g_object_get_data (G_OBJECT (popup), "display-details");
+    text = g_markup_printf_escaped ("<span foreground='%s' font='Light 10'>%s %i x %i</span>", color_hex,
+                                    _("Resolution:"), geom.width, geom.height);
+    gtk_label_set_markup (label, text);
+    g_free (text);
+
+    /* the labels changed, so the window size from the last update is stale */
+    gtk_widget_get_preferred_size (popup, NULL, &size);
+    size.height = MAX (size.height, 64);
+    gtk_window_resize (GTK_WINDOW (popup), size.width, size.height);
 
-        label = gtk_builder_get_object (priv->builder, "display_number");
-        if (xfce_display_settings_get_n_outputs (settings) > 1)
-        {
-            text = g_markup_printf_escaped ("<span foreground='%s' font='Bold 28'>%d</span>",
-                                            color_hex, output_id + 1);
-            gtk_label_set_markup (GTK_LABEL (label), text);
-            g_free (text);
-        }
-        else
+#ifdef HAVE_GTK_LAYER_SHELL
+    if (gtk_layer_is_supported ())
+    {
+        GdkMonitor *monitor = xfce_display_settings_get_monitor (settings, output_id);
+        if (monitor != NULL)
         {
-            gtk_label_set_text (GTK_LABEL (label), NULL);
-            gtk_widget_set_margin_start (GTK_WIDGET (label), 0);
-            gtk_widget_set_margin_end (GTK_WIDGET (label), 0);
+            gtk_layer_set_margin (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_LEFT, (geom.width - size.width) / 2);
+            gtk_layer_set_margin (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_TOP, geom.height - size.height);
+            gtk_layer_set_monitor (GTK_WINDOW (popup), monitor);
+            gtk_widget_set_size_request (popup, size.width, size.height);
         }
+    }
+    else
+#endif
+    {
+        gtk_window_move (GTK_WINDOW (popup),
+                         geom.x + (geom.width - size.width) / 2,
+                         geom.y + geom.height - size.height);
+    }
+}
 
-        label = gtk_builder_get_object (priv->builder, "display_name");
-        text = g_markup_printf_escaped ("<span foreground='%s' font='Bold 10'>%s %s</span>",
-                                        color_hex, _("Display:"),
-                                        xfce_display_settings_get_friendly_name (settings, output_id));
-        gtk_label_set_markup (GTK_LABEL (label), text);
-        g_free (text);
 
-        xfce_display_settings_get_geometry (settings, output_id, &geom);
-        label = gtk_builder_get_object (priv->builder, "display_details");
-        text = g_markup_printf_escaped ("<span foreground='%s' font='Light 10'>%s %i x %i</span>", color_hex,
-                                        _("Resolution:"), geom.width, geom.height);
-        gtk_label_set_markup (GTK_LABEL (label), text);
-        g_free (text);
 
-        popup_screen_changed (GTK_WIDGET (popup), NULL, settings);
-        gtk_window_get_size (GTK_WINDOW (popup), &window_width, &window_height);
+static void
+profile_list_set_row (XfceDisplaySettings *settings,
+                      GtkListStore *store,
+                      GtkTreeIter *iter,
+                      const gchar *profile,
+                      gchar **display_infos,
+                      const gchar *active_profile)
+{
+    XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
+    gchar *profile_name, *markup;
+    GIcon *icon = NULL;
+    gboolean matches = display_settings_profile_matches (profile, display_infos, priv->channel);
+
+    /* use the display string value of the profile hash property */
+    profile_name = display_settings_profile_get_name (profile, priv->channel);
+    markup = matches ? g_strdup (profile_name) : g_strdup_printf ("<span alpha=\"50%%\">%s</span>", profile_name);
 
-#ifdef HAVE_GTK_LAYER_SHELL
-        if (gtk_layer_is_supported ())
+    /* highlight the currently active profile */
+    if (g_strcmp0 (profile, active_profile) == 0)
+    {
+        icon = g_themed_icon_new_with_default_fallbacks ("object-select-symbolic");
+    }
+
+    gtk_list_store_set (store, iter,
+                        COLUMN_ICON, icon,
+                        COLUMN_NAME, profile_name,
+                        COLUMN_HASH, profile,
+                        COLUMN_MARKUP, markup,
+                        COLUMN_MATCHES, matches,
+                        -1);
+
+    g_free (profile_name);
+    g_free (markup);
+    if (icon != NULL)
+        g_object_unref (icon);
+}
+
+
+
+static gboolean
+profile_list_update (gpointer data)
+{
+    XfceDisplaySettings *settings = data;
+    XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
+    GObject *treeview = gtk_builder_get_object (priv->builder, "randr-profile");
+    GtkListStore *store = GTK_LIST_STORE (gtk_tree_view_get_model (GTK_TREE_VIEW (treeview)));
+    gchar **display_infos = xfce_display_settings_get_display_infos (settings);
+    gchar *active_profile = xfconf_channel_get_string (priv->channel, "/ActiveProfile", "Default");
+    GHashTableIter hash_iter;
+    GtkTreeIter iter;
+    gpointer key;
+    gboolean valid;
+
+    priv->changed_profiles_id = 0;
+
+    /* update or remove the rows of the changed profiles, and move the
+     * highlight if the active profile changed */
+    valid = gtk_tree_model_get_iter_first (GTK_TREE_MODEL (store), &iter);
+    while (valid)
+    {
+        gchar *profile;
+
+        gtk_tree_model_get (GTK_TREE_MODEL (store), &iter, COLUMN_HASH, &profile, -1);
+        if (!g_hash_table_remove (priv->changed_profiles, profile))
         {
-            GdkMonitor *monitor = xfce_display_settings_get_monitor (settings, output_id);
-            if (monitor != NULL)
-            {
-                gtk_layer_init_for_window (GTK_WINDOW (popup));
-                gtk_layer_set_layer (GTK_WINDOW (popup), GTK_LAYER_SHELL_LAYER_OVERLAY);
-                gtk_layer_set_exclusive_zone (GTK_WINDOW (popup), -1);
-                gtk_layer_set_anchor (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_LEFT, TRUE);
-                gtk_layer_set_anchor (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_TOP, TRUE);
-                gtk_layer_set_margin (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_LEFT, (geom.width - window_width) / 2);
-                gtk_layer_set_margin (GTK_WINDOW (popup), GTK_LAYER_SHELL_EDGE_TOP, geom.height - window_height);
-                gtk_layer_set_monitor (GTK_WINDOW (popup), monitor);
-                gtk_widget_set_size_request (popup, window_width, window_height);
-                gtk_window_present (GTK_WINDOW (popup));
-            }
+            GIcon *icon = NULL;
+
+            if (g_strcmp0 (profile, active_profile) == 0)
+                icon = g_themed_icon_new_with_default_fallbacks ("object-select-symbolic");
+            gtk_list_store_set (store, &iter, COLUMN_ICON, icon, -1);
+            if (icon != NULL)
+                g_object_unref (icon);
+
+            valid = gtk_tree_model_iter_next (GTK_TREE_MODEL (store), &iter);
+        }
+        else if (display_settings_profile_exists (profile, priv->channel))
+        {
+            profile_list_set_row (settings, store, &iter, profile, display_infos, active_profile);
+            valid = gtk_tree_model_iter_next (GTK_TREE_MODEL (store), &iter);
         }
         else
-#endif
         {
-            gtk_window_move (GTK_WINDOW (popup),
-                             geom.x + (geom.width - window_width) / 2,
-                             geom.y + geom.height - window_height);
-            gtk_window_present (GTK_WINDOW (popup));
+            valid = gtk_list_store_remove (store, &iter);
         }
+        g_free (profile);
     }
 
-    return popup;
+    /* the remaining ones are new */
+    g_hash_table_iter_init (&hash_iter, priv->changed_profiles);
+    while (g_hash_table_iter_next (&hash_iter, &key, NULL))
+    {
+        if (display_settings_profile_exists (key, priv->channel))
+        {
+            gtk_list_store_append (store, &iter);
+            profile_list_set_row (settings, store, &iter, key, display_infos, active_profile);
+        }
+    }
+    g_hash_table_remove_all (priv->changed_profiles);
+
+    g_free (active_profile);
+    g_strfreev (display_infos);
+
+    return G_SOURCE_REMOVE;
+}
+
+
+
+static void
+profile_list_property_changed (XfconfChannel *channel,
+                               const gchar *property,
+                               const GValue *value,
+                               XfceDisplaySettings *settings)
+{
+    XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
+
+    if (g_strcmp0 (property, "/ActiveProfile") != 0)
+    {
+        const gchar *output;
+
+        if (property[0] != '/' || property[1] == '\0')
+            return;
+
+        output = strchr (property + 1, '/');
+        g_hash_table_add (priv->changed_profiles, output != NULL ? g_strndup (property + 1, output - property - 1)
+                                                                 : g_strdup (property + 1));
+    }
+
+    /* saving a profile changes many properties, update the list once */
+    if (priv->changed_profiles_id == 0)
+        priv->changed_profiles_id = g_idle_add (profile_list_update, settings);
 }
 
 
 
+static void
+profile_list_loaded (GObject *source,
+                     GAsyncResult *result,
+                     gpointer data)
+{
+    XfceDisplaySettings *settings = data;
+    XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
+
+    display_settings_profiles_load_finish (XFCONF_CHANNEL (source), result, NULL);
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "display dialog: profiles fetched after %.1f ms",
+                    (g_get_monotonic_time () - priv->profiles_request_time) / 1000.0);
+
+    xfce_display_settings_populate_profile_list (settings);
+    priv->profiles_changed_id = g_signal_connect (priv->channel, "property-changed",
+                                                  G_CALLBACK (profile_list_property_changed), settings);
+
+    g_object_unref (settings);
+}
+
+
+
+/**
+ * xfce_display_settings_populate_profile_list:
+ * @settings: a #XfceDisplaySettings.
+ *
+ * Fill the profile list from scratch. The first call only starts fetching
+ * the profiles and the list is filled once they are known; after that, the
+ * list follows profile changes on its own.
+ **/
 void
 xfce_display_settings_populate_profile_list (XfceDisplaySettings *settings)
 {
     XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
     GObject *treeview = gtk_builder_get_object (priv->builder, "randr-profile");
     GtkListStore *store = GTK_LIST_STORE (gtk_tree_view_get_model (GTK_TREE_VIEW (treeview)));
-    gchar **display_infos = xfce_display_settings_get_display_infos (settings);
-    GList *profiles = display_settings_get_profiles (display_infos, priv->channel, FALSE);
-    gchar *active_profile = xfconf_channel_get_string (priv->channel, "/ActiveProfile", "Default");
+    gchar **display_infos;
+    GList *profiles;
+    gchar *active_profile;
+
+    if (!display_settings_profiles_loaded (priv->channel))
+    {
+        if (!priv->profiles_requested)
+        {
+            priv->profiles_requested = TRUE;
+            priv->profiles_request_time = g_get_monotonic_time ();
+            display_settings_profiles_load_async (priv->channel, NULL, profile_list_loaded, g_object_ref (settings));
+        }
+        return;
+    }
+
+    display_infos = xfce_display_settings_get_display_infos (settings);
+    profiles = display_settings_get_profiles (display_infos, priv->channel, FALSE);
+    active_profile = xfconf_channel_get_string (priv->channel, "/ActiveProfile", "Default");
 
     gtk_list_store_clear (store);
 
@@ -516,37 +848,18 @@ xfce_display_settings_populate_profile_list (XfceDisplaySettings *settings)
     for (GList *lp = profiles; lp != NULL; lp = lp->next)
     {
         GtkTreeIter iter;
-        gchar *property, *profile_name, *markup;
-        const gchar *profile = lp->data;
-        GIcon *icon = NULL;
-        gboolean matches = display_settings_profile_matches (profile, display_infos, priv->channel);
-
-        /* use the display string value of the profile hash property */
-        property = g_strdup_printf ("/%s", profile);
-        profile_name = xfconf_channel_get_string (priv->channel, property, NULL);
-        markup = matches ? g_strdup (profile_name) : g_strdup_printf ("<span alpha=\"50%%\">%s</span>", profile_name);
-
-        /* highlight the currently active profile */
-        if (g_strcmp0 (profile, active_profile) == 0)
-        {
-            icon = g_themed_icon_new_with_default_fallbacks ("object-select-symbolic");
-        }
 
         gtk_list_store_append (store, &iter);
-        gtk_list_store_set (store, &iter,
-                            COLUMN_ICON, icon,
-                            COLUMN_NAME, profile_name,
-                            COLUMN_HASH, profile,
-                            COLUMN_MARKUP, markup,
-                            COLUMN_MATCHES, matches,
-                            -1);
-
-        g_free (property);
-        g_free (profile_name);
-        g_free (markup);
-        if (icon != NULL)
-            g_object_unref (icon);
+        profile_list_set_row (settings, store, &iter, lp->data, display_infos, active_profile);
+    }
+
+    /* the list is up to date */
+    if (priv->changed_profiles_id != 0)
+    {
+        g_source_remove (priv->changed_profiles_id);
+        priv->changed_profiles_id = 0;
     }
+    g_hash_table_remove_all (priv->changed_profiles);
 
     g_free (active_profile);
     g_strfreev (display_infos);
@@ -610,6 +923,15 @@ xfce_display_settings_populate_combobox (XfceDisplaySettings *settings)
 
 
 
+/**
+ * xfce_display_settings_populate_popups:
+ * @settings: a #XfceDisplaySettings.
+ *
+ * Update the identity popups to the current outputs. The popups of outputs
+ * that stay active are kept and only relabeled and moved, so this is cheap
+ * enough to call on every output change. The popups are not shown, use
+ * xfce_display_settings_set_popups_visible() for that.
+ **/
 void
 xfce_display_settings_populate_popups (XfceDisplaySettings *settings)
 {
@@ -619,12 +941,35 @@ xfce_display_settings_populate_popups (XfceDisplaySettings *settings)
     {
         XfceDisplaySettingsPrivate *priv = get_instance_private (settings);
         guint n_outputs = xfce_display_settings_get_n_outputs (settings);
+        GHashTableIter iter;
+        gpointer key;
+
+        /* drop the popups of outputs that went away or were disabled */
+        g_hash_table_iter_init (&iter, priv->popups);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
+        {
+            guint n = GPOINTER_TO_INT (key);
+            if (n >= n_outputs || !xfce_display_settings_is_active (settings, n))
+                g_hash_table_iter_remove (&iter);
+        }
 
-        g_hash_table_remove_all (priv->popups);
         for (guint n = 0; n < n_outputs; n++)
         {
-            if (xfce_display_settings_is_active (settings, n))
-                g_hash_table_insert (priv->popups, GINT_TO_POINTER (n), popup_get (settings, n));
+            GtkWidget *popup;
+
+            if (!xfce_display_settings_is_active (settings, n))
+                continue;
+
+            popup = g_hash_table_lookup (priv->popups, GINT_TO_POINTER (n));
+            if (popup == NULL)
+            {
+                popup = popup_new (settings);
+                if (popup == NULL)
+                    continue;
+                g_hash_table_insert (priv->popups, GINT_TO_POINTER (n), popup);
+            }
+
+            popup_update (settings, popup, n);
         }
     }
 }
@@ -1008,23 +1353,50 @@ xfce_display_settings_is_clonable (XfceDisplaySettings *settings)
 
 
 
+static DisplayProfileWriter *
+save_profile (XfceDisplaySettings *settings,
+              const gchar *scheme,
+              const gchar *profile_name)
+{
+    XfconfChannel *channel = get_instance_private (settings)->channel;
+    gchar *prop = g_strdup_printf ("/%s", scheme);
+    DisplayProfileWriter *writer = display_profile_writer_new (channel, prop, TRUE);
+
+    XFCE_DISPLAY_SETTINGS_GET_CLASS (settings)->save (settings, writer, scheme);
+    if (profile_name != NULL)
+        display_profile_writer_set_string (writer, prop, profile_name);
+
+    g_free (prop);
+
+    return writer;
+}
+
+
+
 void
 xfce_display_settings_save (XfceDisplaySettings *settings,
                             const gchar *scheme,
                             const gchar *profile_name)
 {
-    gchar *prop;
-
     g_return_if_fail (XFCE_IS_DISPLAY_SETTINGS (settings));
 
-    prop = g_strdup_printf ("/%s", scheme);
-    xfconf_channel_reset_property (get_instance_private (settings)->channel, prop, TRUE);
+    display_profile_writer_commit (save_profile (settings, scheme, profile_name));
+}
 
-    XFCE_DISPLAY_SETTINGS_GET_CLASS (settings)->save (settings, scheme);
-    if (profile_name != NULL)
-        xfconf_channel_set_string (get_instance_private (settings)->channel, prop, profile_name);
 
-    g_free (prop);
+
+/* save @scheme and have xfsettingsd apply it once it is completely written */
+void
+xfce_display_settings_save_and_apply (XfceDisplaySettings *settings,
+                                      const gchar *scheme)
+{
+    DisplayProfileWriter *writer;
+
+    g_return_if_fail (XFCE_IS_DISPLAY_SETTINGS (settings));
+
+    writer = save_profile (settings, scheme, NULL);
+    display_profile_writer_apply (writer, scheme);
+    display_profile_writer_commit (writer);
 }
 
 
@@ -19,6 +19,8 @@
 #ifndef __DISPLAY_SETTINGS_H__
 #define __DISPLAY_SETTINGS_H__
 
+#include "common/display-profiles.h"
+
 #include <glib-object.h>
 #include <gtk/gtk.h>
 #include <xfconf/xfconf.h>
@@ -83,6 +85,21 @@ typedef struct _XfceMode
     gdouble rate;
 } XfceMode;
 
+typedef struct _XfceResolution
+{
+    guint width;
+    guint height;
+
+    /* Position in XfceOutput.resolutions */
+    guint index;
+
+    /* Aspect ratio markup, filled in by the dialog on first use */
+    gchar *ratio_markup;
+
+    /* The modes of this resolution, one per refresh rate */
+    GPtrArray *modes;
+} XfceResolution;
+
 typedef struct _XfceOutput
 {
     /* Identifiers */
@@ -109,6 +126,10 @@ typedef struct _XfceOutput
     XfceMode **modes;
     guint n_modes;
 
+    /* Modes grouped by resolution, in the order of @modes */
+    GPtrArray *resolutions;
+    GHashTable *resolution_index;
+
     /* User Data (e.g. GrabInfo) */
     gpointer user_data;
 } XfceOutput;
@@ -166,6 +187,7 @@ struct _XfceDisplaySettingsClass
                          gboolean primary);
     gboolean (*is_clonable) (XfceDisplaySettings *settings);
     void (*save) (XfceDisplaySettings *settings,
+                  DisplayProfileWriter *writer,
                   const gchar *scheme);
     void (*mirror) (XfceDisplaySettings *settings);
     void (*unmirror) (XfceDisplaySettings *settings);
@@ -175,12 +197,19 @@ struct _XfceDisplaySettingsClass
                     guint output_id_1,
                     guint output_id_2,
                     ExtendedMode mode);
+
+    /* optional, for implementations that learn about outputs asynchronously */
+    gboolean (*wait_ready) (XfceDisplaySettings *settings,
+                            GError **error);
 };
 
 XfceDisplaySettings *
 xfce_display_settings_new (gboolean opt_minimal,
                            GError **error);
 gboolean
+xfce_display_settings_wait_ready (XfceDisplaySettings *settings,
+                                  GError **error);
+gboolean
 xfce_display_settings_is_minimal (XfceDisplaySettings *settings);
 void
 xfce_display_settings_set_minimal (XfceDisplaySettings *settings,
@@ -197,6 +226,10 @@ GList *
 xfce_display_settings_get_outputs (XfceDisplaySettings *settings);
 void
 xfce_display_settings_set_outputs (XfceDisplaySettings *settings);
+XfceResolution *
+xfce_output_get_resolution (XfceOutput *output,
+                            guint width,
+                            guint height);
 void
 xfce_display_settings_populate_profile_list (XfceDisplaySettings *settings);
 void
@@ -287,6 +320,9 @@ xfce_display_settings_save (XfceDisplaySettings *settings,
                             const gchar *scheme,
                             const gchar *profile_name);
 void
+xfce_display_settings_save_and_apply (XfceDisplaySettings *settings,
+                                      const gchar *scheme);
+void
 xfce_display_settings_mirror (XfceDisplaySettings *settings);
 void
 xfce_display_settings_unmirror (XfceDisplaySettings *settings);
@@ -24,12 +24,15 @@
 
 #include "display-settings.h"
 #include "scrollarea.h"
+#include "snapping.h"
 
+#include "common/debug.h"
 #include "common/display-profiles.h"
 
 #include <gtk/gtk.h>
 #include <libxfce4ui/libxfce4ui.h>
 #include <libxfce4util/libxfce4util.h>
+#include <string.h>
 #include <xfconf/xfconf.h>
 
 #ifdef HAVE_XRANDR
@@ -95,6 +98,12 @@ static const XfceRotation reflection_names[] = {
 
 
 
+/* For the startup timings in the debug output */
+static gint64 startup_time = 0;
+
+/* Set when the outputs turned out to be unavailable after the dialog was shown */
+static gboolean startup_failed = FALSE;
+
 /* Option entries */
 static gint opt_socket_id = 0;
 static gboolean opt_version = FALSE;
@@ -146,6 +155,14 @@ typedef struct _GrabInfo
     int grab_y;
     int output_x;
     int output_y;
+
+    /* the other outputs do not move during a grab */
+    SnapContext *snap;
+
+    /* motion is snapped once per frame */
+    FooScrollAreaEvent motion;
+    gint64 motion_time;
+    guint tick_id;
 } GrabInfo;
 
 static void
@@ -163,9 +180,13 @@ keep_output_snapped (XfceOutput *output,
                      GrabInfo *info,
                      XfceDisplaySettings *settings);
 static void
+invalidate_moved_outputs (XfceDisplaySettings *settings);
+static void
 display_settings_minimal_activated (GSimpleAction *action,
                                     GVariant *parameter,
                                     gpointer data);
+static void
+display_settings_show_startup_error (const GError *error);
 
 /* App actions */
 static const GActionEntry actions[] = {
@@ -601,6 +622,7 @@ display_setting_refresh_rates_populate (XfceDisplaySettings *settings,
     GtkTreeIter iter;
     gchar *name = NULL;
     XfceOutput *output;
+    XfceResolution *resolution;
 
     /* Get the combo box store and clear it */
     combobox = gtk_builder_get_object (builder, "randr-refresh-rate");
@@ -621,30 +643,28 @@ display_setting_refresh_rates_populate (XfceDisplaySettings *settings,
     /* Block the "changed" signal to avoid triggering the confirmation dialog */
     g_signal_handlers_block_by_func (combobox, display_setting_refresh_rates_changed, settings);
 
-    /* Walk all supported modes */
+    /* Walk the modes of the selected resolution */
     output = get_nth_xfce_output (settings, selected_id);
-    for (guint n = 0; n < output->n_modes; n++)
+    resolution = xfce_output_get_resolution (output, output->mode->width, output->mode->height);
+    for (guint n = 0; resolution != NULL && n < resolution->modes->len; n++)
     {
-        /* The mode resolution does not match the selected one */
-        if (output->modes[n]->width != output->mode->width
-            || output->modes[n]->height != output->mode->height)
-            continue;
+        XfceMode *mode = g_ptr_array_index (resolution->modes, n);
 
         /* Insert the mode */
-        name = g_strdup_printf (_("%.2f Hz"), output->modes[n]->rate);
+        name = g_strdup_printf (_("%.2f Hz"), mode->rate);
         gtk_list_store_append (GTK_LIST_STORE (model), &iter);
         gtk_list_store_set (GTK_LIST_STORE (model), &iter,
                             COLUMN_COMBO_NAME, name,
-                            COLUMN_COMBO_VALUE, output->modes[n]->id, -1);
+                            COLUMN_COMBO_VALUE, mode->id, -1);
         g_free (name);
 
         /* Select the active mode */
-        if (output->modes[n]->id == output->mode->id)
+        if (mode->id == output->mode->id)
             gtk_combo_box_set_active_iter (GTK_COMBO_BOX (combobox), &iter);
     }
 
     /* If a new resolution was selected, set a refresh rate */
-    if (gtk_combo_box_get_active (GTK_COMBO_BOX (combobox)) == -1)
+    if (resolution != NULL && gtk_combo_box_get_active (GTK_COMBO_BOX (combobox)) == -1)
         gtk_combo_box_set_active_iter (GTK_COMBO_BOX (combobox), &iter);
 
     /* Unblock the signal */
@@ -700,6 +720,65 @@ display_settings_aspect_ratios_populate (void)
     }
 }
 
+/* Describe the aspect ratio of a resolution */
+static gchar *
+display_setting_ratio_markup (guint width,
+                              guint height)
+{
+    gdouble ratio = (double) width / (double) height;
+    gdouble rough_ratio;
+    gchar *ratio_text = NULL;
+    gchar *rratio;
+    XfceRatio *ratio_info = g_hash_table_lookup (display_ratio, &ratio);
+
+    if (ratio_info)
+        ratio_text = g_strdup (ratio_info->desc);
+
+    if (!ratio_info)
+    {
+        rough_ratio = _TWO_DIGIT_PRECISION (ratio);
+        ratio_info = g_hash_table_lookup (display_ratio, &rough_ratio);
+        if (ratio_info)
+        {
+            /* if the lookup finds a precise ratio
+             * although we did round the current ratio
+             * we also mark this as not precise */
+            if (ratio_info->precise)
+                ratio_text = g_strdup_printf ("<span font_style='italic'>≈%s</span>", ratio_info->desc);
+            else
+                ratio_text = g_strdup (ratio_info->desc);
+        }
+    }
+
+    if (!ratio_info)
+    {
+        rough_ratio = _ONE_DIGIT_PRECISION (ratio);
+        ratio_info = g_hash_table_lookup (display_ratio, &rough_ratio);
+        if (ratio_info)
+        {
+            if (ratio_info->precise)
+                ratio_text = g_strdup_printf ("<span font_style='italic'>≈%s</span>", ratio_info->desc);
+            else
+                ratio_text = g_strdup (ratio_info->desc);
+        }
+    }
+
+    if (!ratio_info)
+    {
+        guint gcd_tmp = gcd (width, height);
+        guint format_x = width / gcd_tmp;
+        guint format_y = height / gcd_tmp;
+        rratio = g_strdup_printf ("<span fgalpha='50%%'>%u:%u</span>", format_x, format_y);
+    }
+    else
+    {
+        rratio = g_strdup_printf ("<span fgalpha='50%%'>%s</span>", ratio_text);
+    }
+    g_free (ratio_text);
+
+    return rratio;
+}
+
 static void
 display_setting_resolutions_populate (XfceDisplaySettings *settings,
                                       guint selected_id)
@@ -708,10 +787,9 @@ display_setting_resolutions_populate (XfceDisplaySettings *settings,
     GtkTreeModel *model;
     GObject *combobox, *label;
     gchar *name;
-    gchar *rratio;
     GtkTreeIter iter;
     XfceOutput *output;
-    XfceMode **modes;
+    XfceResolution *resolution;
 
     /* Get the combo box store and clear it */
     combobox = gtk_builder_get_object (builder, "randr-resolution");
@@ -736,89 +814,37 @@ display_setting_resolutions_populate (XfceDisplaySettings *settings,
     /* Block the "changed" signal to avoid triggering the confirmation dialog */
     g_signal_handlers_block_by_func (combobox, display_setting_resolutions_changed, settings);
 
-    /* Walk all supported modes */
-    modes = output->modes;
-    for (guint n = 0; n < output->n_modes; n++)
+    /* Walk the supported resolutions */
+    for (guint n = 0; n < output->resolutions->len; n++)
     {
-        /* Try to avoid duplicates */
-        if (n == 0
-            || modes[n]->width != modes[n - 1]->width
-            || modes[n]->height != modes[n - 1]->height)
-        {
-            /* Insert mode and ratio */
-            gdouble ratio = (double) modes[n]->width / (double) modes[n]->height;
-            gdouble rough_ratio;
-            gchar *ratio_text = NULL;
-            XfceRatio *ratio_info = g_hash_table_lookup (display_ratio, &ratio);
-
-            /* Highlight the preferred mode with an asterisk */
-            if (output->pref_width == modes[n]->width
-                && output->pref_height == modes[n]->height)
-                name = g_strdup_printf ("%ux%u*", modes[n]->width,
-                                        modes[n]->height);
-            else
-                name = g_strdup_printf ("%ux%u", modes[n]->width,
-                                        modes[n]->height);
-
-            if (ratio_info)
-                ratio_text = g_strdup (ratio_info->desc);
-
-            if (!ratio_info)
-            {
-                rough_ratio = _TWO_DIGIT_PRECISION (ratio);
-                ratio_info = g_hash_table_lookup (display_ratio, &rough_ratio);
-                if (ratio_info)
-                {
-                    /* if the lookup finds a precise ratio
-                     * although we did round the current ratio
-                     * we also mark this as not precise */
-                    if (ratio_info->precise)
-                        ratio_text = g_strdup_printf ("<span font_style='italic'>≈%s</span>", ratio_info->desc);
-                    else
-                        ratio_text = g_strdup (ratio_info->desc);
-                }
-            }
-
-            if (!ratio_info)
-            {
-                rough_ratio = _ONE_DIGIT_PRECISION (ratio);
-                ratio_info = g_hash_table_lookup (display_ratio, &rough_ratio);
-                if (ratio_info)
-                {
-                    if (ratio_info->precise)
-                        ratio_text = g_strdup_printf ("<span font_style='italic'>≈%s</span>", ratio_info->desc);
-                    else
-                        ratio_text = g_strdup (ratio_info->desc);
-                }
-            }
+        resolution = g_ptr_array_index (output->resolutions, n);
 
-            if (!ratio_info)
-            {
-                guint gcd_tmp = gcd (modes[n]->width, modes[n]->height);
-                guint format_x = modes[n]->width / gcd_tmp;
-                guint format_y = modes[n]->height / gcd_tmp;
-                rratio = g_strdup_printf ("<span fgalpha='50%%'>%u:%u</span>", format_x, format_y);
-            }
-            else
-            {
-                rratio = g_strdup_printf ("<span fgalpha='50%%'>%s</span>", ratio_text);
-            }
-            g_free (ratio_text);
-
-            gtk_list_store_append (GTK_LIST_STORE (model), &iter);
-            gtk_list_store_set (GTK_LIST_STORE (model), &iter,
-                                RESOLUTION_COLUMN_COMBO_NAME, name,
-                                RESOLUTION_COLUMN_COMBO_MARKUP, rratio,
-                                RESOLUTION_COLUMN_COMBO_VALUE, modes[n]->id, -1);
-            g_free (name);
-            g_free (rratio);
-        }
-
-        /* Select the active mode */
-        if (modes[n]->id == output->mode->id)
-            gtk_combo_box_set_active_iter (GTK_COMBO_BOX (combobox), &iter);
+        /* Highlight the preferred mode with an asterisk */
+        if (output->pref_width == resolution->width
+            && output->pref_height == resolution->height)
+            name = g_strdup_printf ("%ux%u*", resolution->width,
+                                    resolution->height);
+        else
+            name = g_strdup_printf ("%ux%u", resolution->width,
+                                    resolution->height);
+
+        /* The ratio only depends on the resolution, describe it once */
+        if (resolution->ratio_markup == NULL)
+            resolution->ratio_markup = display_setting_ratio_markup (resolution->width, resolution->height);
+
+        gtk_list_store_insert_with_values (GTK_LIST_STORE (model), &iter, -1,
+                                           RESOLUTION_COLUMN_COMBO_NAME, name,
+                                           RESOLUTION_COLUMN_COMBO_MARKUP, resolution->ratio_markup,
+                                           RESOLUTION_COLUMN_COMBO_VALUE,
+                                           ((XfceMode *) g_ptr_array_index (resolution->modes, 0))->id, -1);
+        g_free (name);
     }
 
+    /* Select the active mode */
+    resolution = xfce_output_get_resolution (output, output->mode->width, output->mode->height);
+    if (resolution != NULL)
+        gtk_combo_box_set_active (GTK_COMBO_BOX (combobox), resolution->index);
+
     /* Unblock the signal */
     g_signal_handlers_unblock_by_func (combobox, display_setting_resolutions_changed, settings);
 }
@@ -1119,9 +1145,12 @@ display_settings_minimal_profile_combobox_changed (GtkComboBox *box,
 }
 
 static void
-display_settings_minimal_profile_populate (XfceDisplaySettings *settings)
+display_settings_minimal_profiles_loaded (GObject *source,
+                                          GAsyncResult *result,
+                                          gpointer data)
 {
-    XfconfChannel *channel = xfce_display_settings_get_channel (settings);
+    XfceDisplaySettings *settings = data;
+    XfconfChannel *channel = XFCONF_CHANNEL (source);
     GtkBuilder *builder = xfce_display_settings_get_builder (settings);
     GObject *box = gtk_builder_get_object (builder, "box-profile");
     GObject *button = gtk_builder_get_object (builder, "profile");
@@ -1132,14 +1161,14 @@ display_settings_minimal_profile_populate (XfceDisplaySettings *settings)
     GList *profiles = display_settings_get_profiles (display_infos, channel, TRUE);
     gchar *active_profile = xfconf_channel_get_string (channel, "/ActiveProfile", NULL);
 
+    display_settings_profiles_load_finish (channel, result, NULL);
     g_signal_handlers_disconnect_by_func (combobox, display_settings_minimal_profile_combobox_changed, settings);
     gtk_list_store_clear (GTK_LIST_STORE (liststore));
 
     for (GList *lp = profiles; lp != NULL; lp = lp->next)
     {
         /* use the display string value of the profile hash property */
-        gchar *property = g_strdup_printf ("/%s", (gchar *) lp->data);
-        gchar *profile_name = xfconf_channel_get_string (channel, property, NULL);
+        gchar *profile_name = display_settings_profile_get_name (lp->data, channel);
 
         gtk_list_store_append (GTK_LIST_STORE (liststore), &iter);
         gtk_list_store_set (GTK_LIST_STORE (liststore), &iter, 0, profile_name, 1, lp->data, -1);
@@ -1151,7 +1180,6 @@ display_settings_minimal_profile_populate (XfceDisplaySettings *settings)
             g_object_set_data_full (button, "profile-hash", g_strdup (lp->data), g_free);
         }
 
-        g_free (property);
         g_free (profile_name);
     }
 
@@ -1165,6 +1193,18 @@ display_settings_minimal_profile_populate (XfceDisplaySettings *settings)
     g_list_free_full (profiles, g_free);
     g_strfreev (display_infos);
     g_free (active_profile);
+    g_object_unref (settings);
+}
+
+static void
+display_settings_minimal_profile_populate (XfceDisplaySettings *settings)
+{
+    XfconfChannel *channel = xfce_display_settings_get_channel (settings);
+    GtkBuilder *builder = xfce_display_settings_get_builder (settings);
+
+    /* shown once the matching profiles are known */
+    gtk_widget_set_visible (GTK_WIDGET (gtk_builder_get_object (builder, "box-profile")), FALSE);
+    display_settings_profiles_load_async (channel, NULL, display_settings_minimal_profiles_loaded, g_object_ref (settings));
 }
 
 static void
@@ -1306,8 +1346,8 @@ show_confirmation_dialog (gpointer data)
     }
     else
     {
-        /* Recover to Default */
-        xfconf_channel_set_string (channel, "/Schemes/Apply", "Default");
+        /* Recover the previous configuration, or Default if it is gone */
+        xfconf_channel_set_string (channel, "/Schemes/Revert", "Default");
         foo_scroll_area_invalidate (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)));
     }
 
@@ -1354,8 +1394,7 @@ display_setting_apply (GtkWidget *widget,
     foo_scroll_area_invalidate (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)));
 
     /* Apply changes via a temporary profile */
-    xfce_display_settings_save (settings, "Temp", NULL);
-    xfconf_channel_set_string (xfce_display_settings_get_channel (settings), "/Schemes/Apply", "Temp");
+    xfce_display_settings_save_and_apply (settings, "Temp");
 
     /* Run dialog after this signal handler to avoid random freeze */
     guint id = g_idle_add_once (show_confirmation_dialog, settings);
@@ -1434,7 +1473,6 @@ display_settings_profile_save (GtkWidget *widget,
         if (g_strcmp0 (active_profile, profile_hash) == 0)
             xfconf_channel_set_string (channel, "/ActiveProfile", "");
 
-        xfce_display_settings_populate_profile_list (settings);
         gtk_widget_set_sensitive (widget, FALSE);
 
         g_free (profile_hash);
@@ -1504,7 +1542,6 @@ display_settings_profile_create_cb (GtkWidget *widget,
             g_free (property);
         }
         xfce_display_settings_save (settings, profile_hash, profile_name);
-        xfce_display_settings_populate_profile_list (settings);
 
         g_free (property);
         g_free (profile_hash);
@@ -1561,12 +1598,11 @@ display_settings_profile_apply (GtkWidget *widget,
 
         if (!display_setting_timed_confirmation (settings))
         {
-            xfconf_channel_set_string (channel, "/Schemes/Apply", old_profile_hash);
+            xfconf_channel_set_string (channel, "/Schemes/Revert", old_profile_hash);
             xfconf_channel_set_string (channel, "/ActiveProfile", old_profile_hash);
 
             foo_scroll_area_invalidate (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)));
         }
-        xfce_display_settings_populate_profile_list (settings);
 
         g_free (profile_hash);
     }
@@ -1624,7 +1660,7 @@ display_settings_profile_delete (GtkWidget *widget,
             xfconf_channel_reset_property (channel, property, TRUE);
             if (g_strcmp0 (active_profile, profile_hash) == 0)
                 xfconf_channel_set_string (channel, "/ActiveProfile", "");
-            xfce_display_settings_populate_profile_list (settings);
+            gtk_list_store_remove (GTK_LIST_STORE (model), &iter);
 
             g_free (active_profile);
             g_free (property);
@@ -1735,7 +1771,7 @@ display_settings_dialog_new (XfceDisplaySettings *settings)
     GObject *treeview;
     GObject *combobox;
     GtkCellRenderer *renderer;
-    GObject *label, *check, *primary, *mirror, *identify, *primary_indicator;
+    GObject *label, *check, *primary, *mirror, *primary_indicator;
     GObject *spinbutton;
     GtkWidget *button;
     GtkTreeSelection *selection;
@@ -1749,22 +1785,6 @@ display_settings_dialog_new (XfceDisplaySettings *settings)
     gtk_cell_layout_set_attributes (GTK_CELL_LAYOUT (combobox), renderer, "text", COLUMN_OUTPUT_NAME, NULL);
     g_object_set (G_OBJECT (renderer), "ellipsize", PANGO_ELLIPSIZE_END, NULL);
 
-    /* Identification popups */
-    identify = gtk_builder_get_object (builder, "identify-displays");
-    if (WINDOWING_IS_X11 () || gtk_layer_is_supported ())
-    {
-        xfce_display_settings_populate_popups (settings);
-        g_signal_connect (G_OBJECT (identify), "state-set", G_CALLBACK (on_identify_displays_toggled), settings);
-        xfconf_g_property_bind (channel, "/IdentityPopups", G_TYPE_BOOLEAN, identify, "active");
-        xfce_display_settings_set_popups_visible (settings, gtk_switch_get_active (GTK_SWITCH (identify)));
-    }
-    else
-    {
-        gtk_widget_hide (GTK_WIDGET (identify));
-        gtk_widget_hide (GTK_WIDGET (gtk_builder_get_object (builder, "identify-displays-label")));
-        gtk_widget_hide (GTK_WIDGET (gtk_builder_get_object (builder, "label-profile2")));
-    }
-
     /* Display selection combobox */
     g_signal_connect (G_OBJECT (combobox), "changed", G_CALLBACK (display_settings_combobox_selection_changed), settings);
 
@@ -1773,16 +1793,6 @@ display_settings_dialog_new (XfceDisplaySettings *settings)
     mirror = gtk_builder_get_object (builder, "mirror-displays");
     g_signal_connect (G_OBJECT (check), "state-set", G_CALLBACK (display_setting_output_toggled), settings);
     g_signal_connect (G_OBJECT (mirror), "toggled", G_CALLBACK (display_setting_mirror_displays_toggled), settings);
-    if (xfce_display_settings_get_n_outputs (settings) > 1)
-    {
-        gtk_widget_show (GTK_WIDGET (check));
-        gtk_widget_show (GTK_WIDGET (mirror));
-    }
-    else
-    {
-        gtk_widget_hide (GTK_WIDGET (check));
-        gtk_widget_hide (GTK_WIDGET (mirror));
-    }
 
     /* Set up primary monitor widgets */
     primary = gtk_builder_get_object (builder, "primary");
@@ -1878,14 +1888,52 @@ display_settings_dialog_new (XfceDisplaySettings *settings)
     button = GTK_WIDGET (gtk_builder_get_object (builder, "button-profile-create"));
     g_signal_connect (G_OBJECT (button), "clicked", G_CALLBACK (display_settings_profile_create), settings);
 
-    /* Populate the combobox */
-    xfce_display_settings_populate_combobox (settings);
     display_settings_profile_list_init (settings);
-    xfce_display_settings_populate_profile_list (settings);
 
     return GTK_WIDGET (gtk_builder_get_object (builder, "display-dialog"));
 }
 
+/* Fill in the parts of the dialog that depend on the outputs */
+static void
+display_settings_dialog_populate (XfceDisplaySettings *settings)
+{
+    XfconfChannel *channel = xfce_display_settings_get_channel (settings);
+    GtkBuilder *builder = xfce_display_settings_get_builder (settings);
+    GObject *check, *mirror, *identify;
+
+    /* Identification popups */
+    identify = gtk_builder_get_object (builder, "identify-displays");
+    if (WINDOWING_IS_X11 () || gtk_layer_is_supported ())
+    {
+        xfce_display_settings_populate_popups (settings);
+        g_signal_connect (G_OBJECT (identify), "state-set", G_CALLBACK (on_identify_displays_toggled), settings);
+        xfconf_g_property_bind (channel, "/IdentityPopups", G_TYPE_BOOLEAN, identify, "active");
+        xfce_display_settings_set_popups_visible (settings, gtk_switch_get_active (GTK_SWITCH (identify)));
+    }
+    else
+    {
+        gtk_widget_hide (GTK_WIDGET (identify));
+        gtk_widget_hide (GTK_WIDGET (gtk_builder_get_object (builder, "identify-displays-label")));
+        gtk_widget_hide (GTK_WIDGET (gtk_builder_get_object (builder, "label-profile2")));
+    }
+
+    check = gtk_builder_get_object (builder, "output-on");
+    mirror = gtk_builder_get_object (builder, "mirror-displays");
+    if (xfce_display_settings_get_n_outputs (settings) > 1)
+    {
+        gtk_widget_show (GTK_WIDGET (check));
+        gtk_widget_show (GTK_WIDGET (mirror));
+    }
+    else
+    {
+        gtk_widget_hide (GTK_WIDGET (check));
+        gtk_widget_hide (GTK_WIDGET (mirror));
+    }
+
+    /* Populate the combobox */
+    xfce_display_settings_populate_combobox (settings);
+}
+
 static void
 display_settings_minimal_only_display_n_toggled (GtkToggleButton *button,
                                                  XfceDisplaySettings *settings)
@@ -1913,8 +1961,7 @@ display_settings_minimal_only_display_n_toggled (GtkToggleButton *button,
     }
 
     /* Apply the changes */
-    xfce_display_settings_save (settings, "Default", NULL);
-    xfconf_channel_set_string (xfce_display_settings_get_channel (settings), "/Schemes/Apply", "Default");
+    xfce_display_settings_save_and_apply (settings, "Default");
 }
 
 static void
@@ -1969,8 +2016,7 @@ display_settings_minimal_mirror_displays_toggled (GtkToggleButton *button,
         xfce_display_settings_mirror (settings);
 
         /* Apply all changes */
-        xfce_display_settings_save (settings, "Default", NULL);
-        xfconf_channel_set_string (xfce_display_settings_get_channel (settings), "/Schemes/Apply", "Default");
+        xfce_display_settings_save_and_apply (settings, "Default");
     }
     else
     {
@@ -2000,11 +2046,8 @@ display_settings_minimal_extend_displays_toggled (GtkToggleButton *button,
     mode = gtk_combo_box_get_active (GTK_COMBO_BOX (gtk_builder_get_object (builder, "combobox-extend")));
     xfce_display_settings_extend (settings, 0, 1, mode);
 
-    /* Save changes to both displays */
-    xfce_display_settings_save (settings, "Default", NULL);
-
-    /* Apply all changes */
-    xfconf_channel_set_string (xfce_display_settings_get_channel (settings), "/Schemes/Apply", "Default");
+    /* Save changes to both displays and apply them */
+    xfce_display_settings_save_and_apply (settings, "Default");
 }
 
 /* Xfce RANDR GUI **TODO** Place these functions in a sensible location */
@@ -2113,461 +2156,182 @@ compute_scale (XfceDisplaySettings *settings)
     return MIN ((double) available_w / (double) total_w, (double) available_h / (double) total_h);
 }
 
-typedef struct Edge
-{
-    XfceOutput *output;
-    int x1, y1;
-    int x2, y2;
-} Edge;
-
-typedef struct Snap
-{
-    Edge *snapper; /* Edge that should be snapped */
-    Edge *snappee;
-    int dy, dx;
-} Snap;
-
 static void
-add_edge (XfceOutput *output,
-          int x1,
-          int y1,
-          int x2,
-          int y2,
-          GArray *edges)
+get_output_rect (XfceOutput *output,
+                 GdkRectangle *rect)
 {
-    Edge e;
+    int w, h;
 
-    e.x1 = x1;
-    e.x2 = x2;
-    e.y1 = y1;
-    e.y2 = y2;
-    e.output = output;
+    get_geometry (output, &w, &h);
 
-    g_array_append_val (edges, e);
+    rect->width = w;
+    rect->height = h;
+    rect->x = output->x;
+    rect->y = output->y;
 }
 
-static void
-list_edges_for_output (XfceOutput *output,
-                       GArray *edges)
+/* the other outputs do not move while @output is dragged */
+static SnapContext *
+output_snap_context_new (XfceDisplaySettings *settings,
+                         XfceOutput *output)
 {
-    int x, y, w, h;
+    GArray *rects = g_array_new (FALSE, FALSE, sizeof (GdkRectangle));
+    SnapContext *ctx;
+    int w, h;
 
-    x = output->x;
-    y = output->y;
-    get_geometry (output, &w, &h);
+    for (GList *list = xfce_display_settings_get_outputs (settings); list != NULL; list = list->next)
+    {
+        GdkRectangle rect;
 
-    /* Top, Bottom, Left, Right */
-    add_edge (output, x, y, x + w, y, edges);
-    add_edge (output, x, y + h, x + w, y + h, edges);
-    add_edge (output, x, y, x, y + h, edges);
-    add_edge (output, x + w, y, x + w, y + h, edges);
-}
+        if (list->data == output)
+            continue;
 
-static void
-list_edges (GList *outputs,
-            GArray *edges)
-{
-    for (GList *list = outputs; list != NULL; list = list->next)
-    {
-        list_edges_for_output (list->data, edges);
+        get_output_rect (list->data, &rect);
+        g_array_append_val (rects, rect);
     }
-}
 
-static gboolean
-overlap (int s1,
-         int e1,
-         int s2,
-         int e2)
-{
-    return (!(e1 < s2 || s1 >= e2));
+    get_geometry (output, &w, &h);
+    ctx = snap_context_new ((GdkRectangle *) rects->data, rects->len, w, h);
+    g_array_free (rects, TRUE);
+
+    return ctx;
 }
 
-static gboolean
-horizontal_overlap (Edge *snapper,
-                    Edge *snappee)
+/* Sets a mouse cursor for a widget's window.  As a hack, you can pass
+ * GDK_BLANK_CURSOR to mean "set the cursor to NULL" (i.e. reset the widget's
+ * window's cursor to its default).
+ */
+static void
+set_cursor (GtkWidget *widget,
+            const gchar *name)
 {
-    if (snapper->y1 != snapper->y2 || snappee->y1 != snappee->y2)
-        return FALSE;
+    GdkCursor *cursor;
+    GdkWindow *window;
 
-    return overlap (snapper->x1, snapper->x2, snappee->x1, snappee->x2);
-}
+    if (name == NULL)
+        cursor = NULL;
+    else
+        cursor = gdk_cursor_new_from_name (gtk_widget_get_display (widget), name);
 
-static gboolean
-vertical_overlap (Edge *snapper,
-                  Edge *snappee)
-{
-    if (snapper->x1 != snapper->x2 || snappee->x1 != snappee->x2)
-        return FALSE;
+    window = gtk_widget_get_window (widget);
 
-    return overlap (snapper->y1, snapper->y2, snappee->y1, snappee->y2);
+    if (window)
+        gdk_window_set_cursor (window, cursor);
+
+    if (cursor)
+        g_object_unref (cursor);
 }
 
 static void
-add_snap (GArray *snaps,
-          Snap snap)
+set_monitors_tooltip (XfceDisplaySettings *settings,
+                      gchar *tooltip_text)
 {
-    if (ABS (snap.dx) <= 200 || ABS (snap.dy) <= 200)
-        g_array_append_val (snaps, snap);
+    const char *text;
+
+    if (tooltip_text)
+        text = tooltip_text;
+    else
+        text = _("Select a monitor to change its properties; drag it to rearrange its placement.");
+
+    gtk_widget_set_tooltip_text (xfce_display_settings_get_scroll_area (settings), text);
 }
 
 static void
-add_edge_snaps (Edge *snapper,
-                Edge *snappee,
-                GArray *snaps)
+keep_output_snapped (XfceOutput *output,
+                     FooScrollAreaEvent *event,
+                     GrabInfo *info,
+                     XfceDisplaySettings *settings)
 {
-    Snap snap;
+    double scale = compute_scale (settings);
+    SnapContext *ctx = info->snap;
+    int new_x, new_y, x, y;
 
-    snap.snapper = snapper;
-    snap.snappee = snappee;
+    if (ctx == NULL)
+        ctx = output_snap_context_new (settings, output);
 
-    if (horizontal_overlap (snapper, snappee))
-    {
-        snap.dx = 0;
-        snap.dy = snappee->y1 - snapper->y1;
+    new_x = info->output_x + (event->x - info->grab_x) / scale;
+    new_y = info->output_y + (event->y - info->grab_y) / scale;
 
-        add_snap (snaps, snap);
+    if (snap_context_snap (ctx, new_x, new_y, &x, &y))
+    {
+        output->x = x;
+        output->y = y;
     }
-    else if (vertical_overlap (snapper, snappee))
+    else
     {
-        snap.dy = 0;
-        snap.dx = snappee->x1 - snapper->x1;
-
-        add_snap (snaps, snap);
+        output->x = info->output_x;
+        output->y = info->output_y;
     }
 
-    /* Corner snaps */
-    /* 1->1 */
-    snap.dx = snappee->x1 - snapper->x1;
-    snap.dy = snappee->y1 - snapper->y1;
+    if (ctx != info->snap)
+        snap_context_free (ctx);
+}
+
+static void
+grab_info_free (GrabInfo *info)
+{
+    if (info->snap != NULL)
+        snap_context_free (info->snap);
+    g_free (info);
+}
 
-    add_snap (snaps, snap);
+static gboolean
+on_output_motion_tick (GtkWidget *widget,
+                       GdkFrameClock *frame_clock,
+                       gpointer data)
+{
+    XfceDisplaySettings *settings = g_object_get_data (G_OBJECT (widget), "settings");
+    XfsdDebugHistogram *histogram = g_object_get_data (G_OBJECT (widget), "motion-histogram");
+    XfceOutput *output = get_nth_xfce_output (settings, GPOINTER_TO_UINT (data));
+    GrabInfo *info;
+    gchar *tooltip_text;
 
-    /* 1->2 */
-    snap.dx = snappee->x2 - snapper->x1;
-    snap.dy = snappee->y2 - snapper->y1;
+    /* the output list was rebuilt since the motion, the grab is gone */
+    if (output == NULL || output->user_data == NULL)
+        return G_SOURCE_REMOVE;
 
-    add_snap (snaps, snap);
+    info = output->user_data;
+    info->tick_id = 0;
+    keep_output_snapped (output, &info->motion, info, settings);
 
-    /* 2->2 */
-    snap.dx = snappee->x2 - snapper->x2;
-    snap.dy = snappee->y2 - snapper->y2;
+    xfsettings_dbg_histogram_add (histogram, g_get_monotonic_time () - info->motion_time);
 
-    add_snap (snaps, snap);
+    tooltip_text = g_strdup_printf (_("(%i, %i)"), output->x, output->y);
+    set_monitors_tooltip (settings, tooltip_text);
+    g_free (tooltip_text);
 
-    /* 2->1 */
-    snap.dx = snappee->x1 - snapper->x2;
-    snap.dy = snappee->y1 - snapper->y2;
+    invalidate_moved_outputs (settings);
 
-    add_snap (snaps, snap);
+    return G_SOURCE_REMOVE;
 }
 
 static void
-list_snaps (XfceOutput *output,
-            GArray *edges,
-            GArray *snaps)
+on_output_event (FooScrollArea *area,
+                 FooScrollAreaEvent *event,
+                 gpointer data)
 {
-    guint i;
+    XfceOutput *output = data;
+    XfceDisplaySettings *settings = g_object_get_data (G_OBJECT (area), "settings");
+    MirroredState state = xfce_display_settings_get_mirrored_state (settings);
+    gchar *tooltip_text;
 
-    for (i = 0; i < edges->len; ++i)
-    {
-        Edge *output_edge = &(g_array_index (edges, Edge, i));
+    /* If the mouse is inside the outputs, set the cursor to "you can move me".  See
+     * on_canvas_event() for where we reset the cursor to the default if it
+     * exits the outputs' area.
+     */
+    if (event->type == FOO_MOTION_OUTSIDE)
+        return;
 
-        if (output_edge->output == output)
-        {
-            guint j;
+    if (state == MIRRORED_STATE_NONE && xfce_display_settings_get_n_outputs (settings) > 1)
+        set_cursor (GTK_WIDGET (area), "move");
 
-            for (j = 0; j < edges->len; ++j)
-            {
-                Edge *edge = &(g_array_index (edges, Edge, j));
+    if (event->type == FOO_BUTTON_PRESS)
+    {
+        GrabInfo *info;
+        GtkBuilder *builder = xfce_display_settings_get_builder (settings);
+        GtkWidget *combobox = GTK_WIDGET (gtk_builder_get_object (builder, "randr-outputs"));
 
-                if (edge->output != output)
-                    add_edge_snaps (output_edge, edge, snaps);
-            }
-        }
-    }
-}
-
-static gboolean
-corner_on_edge (int x,
-                int y,
-                Edge *e)
-{
-    if (x == e->x1 && x == e->x2 && y >= e->y1 && y <= e->y2)
-        return TRUE;
-
-    if (y == e->y1 && y == e->y2 && x >= e->x1 && x <= e->x2)
-        return TRUE;
-
-    return FALSE;
-}
-
-static gboolean
-edges_align (Edge *e1,
-             Edge *e2)
-{
-    if (corner_on_edge (e1->x1, e1->y1, e2))
-        return TRUE;
-
-    if (corner_on_edge (e2->x1, e2->y1, e1))
-        return TRUE;
-
-    return FALSE;
-}
-
-static gboolean
-output_is_aligned (XfceOutput *output,
-                   GArray *edges)
-{
-    gboolean result = FALSE;
-    guint i;
-
-    for (i = 0; i < edges->len; ++i)
-    {
-        Edge *output_edge = &(g_array_index (edges, Edge, i));
-
-        if (output_edge->output == output)
-        {
-            guint j;
-
-            for (j = 0; j < edges->len; ++j)
-            {
-                Edge *edge = &(g_array_index (edges, Edge, j));
-
-                /* We are aligned if an output edge matches
-                 * an edge of another output
-                 */
-                if (edge->output != output_edge->output)
-                {
-                    if (edges_align (output_edge, edge))
-                    {
-                        result = TRUE;
-                        goto done;
-                    }
-                }
-            }
-        }
-    }
-done:
-    return result;
-}
-
-static void
-get_output_rect (XfceOutput *output,
-                 GdkRectangle *rect)
-{
-    int w, h;
-
-    get_geometry (output, &w, &h);
-
-    rect->width = w;
-    rect->height = h;
-    rect->x = output->x;
-    rect->y = output->y;
-}
-
-static gboolean
-output_overlaps (GList *outputs,
-                 XfceOutput *output)
-{
-    GdkRectangle output_rect;
-
-    get_output_rect (output, &output_rect);
-
-    for (GList *list = outputs; list != NULL; list = list->next)
-    {
-        XfceOutput *other = list->data;
-        if (other != output)
-        {
-            GdkRectangle other_rect;
-            get_output_rect (other, &other_rect);
-            if (gdk_rectangle_intersect (&output_rect, &other_rect, NULL))
-                return TRUE;
-        }
-    }
-
-    return FALSE;
-}
-
-static gboolean
-xfce_rr_config_is_aligned (GList *outputs,
-                           GArray *edges)
-{
-    for (GList *list = outputs; list != NULL; list = list->next)
-    {
-        XfceOutput *output = list->data;
-        if (!output_is_aligned (output, edges) || output_overlaps (outputs, output))
-            return FALSE;
-    }
-
-    return TRUE;
-}
-
-static gboolean
-is_corner_snap (const Snap *s)
-{
-    return s->dx != 0 && s->dy != 0;
-}
-
-static int
-compare_snaps (gconstpointer v1,
-               gconstpointer v2)
-{
-    const Snap *s1 = v1;
-    const Snap *s2 = v2;
-    int sv1 = MAX (ABS (s1->dx), ABS (s1->dy));
-    int sv2 = MAX (ABS (s2->dx), ABS (s2->dy));
-    int d;
-
-    d = sv1 - sv2;
-
-    /* This snapping algorithm is good enough for rock'n'roll, but
-     * this is probably a better:
-     *
-     *    First do a horizontal/vertical snap, then
-     *    with the new coordinates from that snap,
-     *    do a corner snap.
-     *
-     * Right now, it's confusing that corner snapping
-     * depends on the distance in an axis that you can't actually see.
-     *
-     */
-    if (d == 0)
-    {
-        if (is_corner_snap (s1) && !is_corner_snap (s2))
-            return -1;
-        else if (is_corner_snap (s2) && !is_corner_snap (s1))
-            return 1;
-        else
-            return 0;
-    }
-    else
-    {
-        return d;
-    }
-}
-
-/* Sets a mouse cursor for a widget's window.  As a hack, you can pass
- * GDK_BLANK_CURSOR to mean "set the cursor to NULL" (i.e. reset the widget's
- * window's cursor to its default).
- */
-static void
-set_cursor (GtkWidget *widget,
-            const gchar *name)
-{
-    GdkCursor *cursor;
-    GdkWindow *window;
-
-    if (name == NULL)
-        cursor = NULL;
-    else
-        cursor = gdk_cursor_new_from_name (gtk_widget_get_display (widget), name);
-
-    window = gtk_widget_get_window (widget);
-
-    if (window)
-        gdk_window_set_cursor (window, cursor);
-
-    if (cursor)
-        g_object_unref (cursor);
-}
-
-static void
-set_monitors_tooltip (XfceDisplaySettings *settings,
-                      gchar *tooltip_text)
-{
-    const char *text;
-
-    if (tooltip_text)
-        text = tooltip_text;
-    else
-        text = _("Select a monitor to change its properties; drag it to rearrange its placement.");
-
-    gtk_widget_set_tooltip_text (xfce_display_settings_get_scroll_area (settings), text);
-}
-
-static void
-keep_output_snapped (XfceOutput *output,
-                     FooScrollAreaEvent *event,
-                     GrabInfo *info,
-                     XfceDisplaySettings *settings)
-{
-    GList *outputs = xfce_display_settings_get_outputs (settings);
-    double scale = compute_scale (settings);
-    int new_x, new_y;
-    GArray *edges, *snaps;
-
-    new_x = info->output_x + (event->x - info->grab_x) / scale;
-    new_y = info->output_y + (event->y - info->grab_y) / scale;
-
-    output->x = new_x;
-    output->y = new_y;
-
-    edges = g_array_new (TRUE, TRUE, sizeof (Edge));
-    snaps = g_array_new (TRUE, TRUE, sizeof (Snap));
-
-    list_edges (outputs, edges);
-    list_snaps (output, edges, snaps);
-
-    g_array_sort (snaps, compare_snaps);
-
-    output->x = info->output_x;
-    output->y = info->output_y;
-
-    for (guint i = 0; i < snaps->len; ++i)
-    {
-        Snap *snap = &(g_array_index (snaps, Snap, i));
-        GArray *new_edges = g_array_new (TRUE, TRUE, sizeof (Edge));
-
-        output->x = new_x + snap->dx;
-        output->y = new_y + snap->dy;
-
-        g_array_set_size (new_edges, 0);
-        list_edges (outputs, new_edges);
-
-        if (xfce_rr_config_is_aligned (outputs, new_edges))
-        {
-            g_array_free (new_edges, TRUE);
-            break;
-        }
-        else
-        {
-            output->x = info->output_x;
-            output->y = info->output_y;
-            g_array_free (new_edges, TRUE);
-        }
-    }
-
-    g_array_free (snaps, TRUE);
-    g_array_free (edges, TRUE);
-}
-
-static void
-on_output_event (FooScrollArea *area,
-                 FooScrollAreaEvent *event,
-                 gpointer data)
-{
-    XfceOutput *output = data;
-    XfceDisplaySettings *settings = g_object_get_data (G_OBJECT (area), "settings");
-    MirroredState state = xfce_display_settings_get_mirrored_state (settings);
-    gchar *tooltip_text;
-
-    /* If the mouse is inside the outputs, set the cursor to "you can move me".  See
-     * on_canvas_event() for where we reset the cursor to the default if it
-     * exits the outputs' area.
-     */
-    if (event->type == FOO_MOTION_OUTSIDE)
-        return;
-
-    if (state == MIRRORED_STATE_NONE && xfce_display_settings_get_n_outputs (settings) > 1)
-        set_cursor (GTK_WIDGET (area), "move");
-
-    if (event->type == FOO_BUTTON_PRESS)
-    {
-        GrabInfo *info;
-        GtkBuilder *builder = xfce_display_settings_get_builder (settings);
-        GtkWidget *combobox = GTK_WIDGET (gtk_builder_get_object (builder, "randr-outputs"));
-
-        gtk_combo_box_set_active (GTK_COMBO_BOX (combobox), output->id);
+        gtk_combo_box_set_active (GTK_COMBO_BOX (combobox), output->id);
 
         if (state == MIRRORED_STATE_NONE && xfce_display_settings_get_n_outputs (settings) > 1)
         {
@@ -2578,6 +2342,7 @@ on_output_event (FooScrollArea *area,
             info->grab_y = event->y;
             info->output_x = output->x;
             info->output_y = output->y;
+            info->snap = output_snap_context_new (settings, output);
 
             tooltip_text = g_strdup_printf (_("(%i, %i)"), output->x, output->y);
             set_monitors_tooltip (settings, tooltip_text);
@@ -2592,28 +2357,36 @@ on_output_event (FooScrollArea *area,
     {
         if (foo_scroll_area_is_grabbed (area))
         {
-            keep_output_snapped (output, event, output->user_data, settings);
+            GrabInfo *info = output->user_data;
+            GtkAllocation alloc;
 
-            if (event->type == FOO_BUTTON_RELEASE)
+            if (event->type != FOO_BUTTON_RELEASE)
             {
-                GtkAllocation alloc;
-                gtk_widget_get_allocation (GTK_WIDGET (area), &alloc);
-                if (event->x <= 0 || event->y <= 0 || event->x >= alloc.width || event->y >= alloc.height)
-                    set_cursor (GTK_WIDGET (area), NULL);
-
-                foo_scroll_area_end_grab (area);
-                set_monitors_tooltip (settings, NULL);
-                g_clear_pointer (&output->user_data, g_free);
-                initialize_connected_outputs_at_zero (settings);
-                display_settings_changed (settings);
-            }
-            else
-            {
-                tooltip_text = g_strdup_printf (_("(%i, %i)"), output->x, output->y);
-                set_monitors_tooltip (settings, tooltip_text);
-                g_free (tooltip_text);
+                /* snap to the last pointer position once per frame */
+                info->motion = *event;
+                if (info->tick_id == 0)
+                {
+                    info->motion_time = g_get_monotonic_time ();
+                    info->tick_id = gtk_widget_add_tick_callback (GTK_WIDGET (area), on_output_motion_tick,
+                                                                  GUINT_TO_POINTER (output->id), NULL);
+                }
+                return;
             }
 
+            if (info->tick_id != 0)
+                gtk_widget_remove_tick_callback (GTK_WIDGET (area), info->tick_id);
+            keep_output_snapped (output, event, info, settings);
+
+            gtk_widget_get_allocation (GTK_WIDGET (area), &alloc);
+            if (event->x <= 0 || event->y <= 0 || event->x >= alloc.width || event->y >= alloc.height)
+                set_cursor (GTK_WIDGET (area), NULL);
+
+            foo_scroll_area_end_grab (area);
+            set_monitors_tooltip (settings, NULL);
+            g_clear_pointer (&output->user_data, grab_info_free);
+            initialize_connected_outputs_at_zero (settings);
+            display_settings_changed (settings);
+
             foo_scroll_area_invalidate (area);
         }
     }
@@ -2648,100 +2421,152 @@ paint_background (FooScrollArea *area,
     foo_scroll_area_add_input_from_fill (area, cr, on_canvas_event, NULL);
 }
 
-static void
-paint_output (XfceDisplaySettings *settings,
-              cairo_t *cr,
-              int i,
-              gint scale_factor,
-              double *snap_x,
-              double *snap_y)
+/* The canvas geometry shared by all outputs of a frame */
+typedef struct _CanvasGeometry
 {
-    int w, h;
-    double x, y, end_x, end_y;
-    gint total_w, total_h;
-    GList *outputs = xfce_display_settings_get_outputs (settings);
-    double scale = compute_scale (settings);
-    XfceOutput *output = NULL;
-    GList *entry = NULL;
-    PangoLayout *layout;
-    PangoRectangle ink_extent, log_extent;
     GdkRectangle viewport;
-    cairo_pattern_t *pat_lin = NULL, *pat_radial = NULL;
-    double alpha = 1.0;
-    double available_w;
-    double factor = 1.0;
-    const char *text;
-    MirroredState state = xfce_display_settings_get_mirrored_state (settings);
-    guint selected_id = xfce_display_settings_get_selected_output_id (settings);
+    gint total_w, total_h;
+    double scale;
+} CanvasGeometry;
 
-    get_total_size (outputs, &total_w, &total_h);
+/* Everything an output tile is rendered from */
+typedef struct _OutputTileKey
+{
+    int w, h;
+    int width, height;
+    double scale;
+    gint scale_factor;
+    gint index;
+    gboolean numbered;
+    gboolean active;
+    gboolean primary;
+    gboolean highlighted;
+    RotationFlags rotation;
+    double alpha;
+} OutputTileKey;
 
-    cairo_save (cr);
+/* An output as painted on the canvas, rendered again only when its key or
+ * label changes */
+typedef struct _OutputTile
+{
+    OutputTileKey key;
+    gchar *text;
+    cairo_surface_t *surface;
 
-    foo_scroll_area_get_viewport (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)), &viewport);
+    /* the canvas area covered by the output at the last paint */
+    GdkRectangle area;
+} OutputTile;
 
-    entry = g_list_nth (outputs, i);
-    if (entry)
-        output = entry->data;
-    if (output)
-        get_geometry (output, &w, &h);
-    else
-        return;
+static void
+output_tile_free (gpointer data)
+{
+    OutputTile *tile = data;
 
-    viewport.height -= 2 * MARGIN;
-    viewport.width -= 2 * MARGIN;
+    if (tile->surface != NULL)
+        cairo_surface_destroy (tile->surface);
+    g_free (tile->text);
+    g_free (tile);
+}
 
-    /* Center the displayed outputs in the viewport */
-    x = ceil (output->x * scale + MARGIN + (viewport.width - total_w * scale) / 2.0);
-    y = ceil (output->y * scale + MARGIN + (viewport.height - total_h * scale) / 2.0);
+static OutputTile *
+get_output_tile (GtkWidget *area,
+                 guint index)
+{
+    GPtrArray *tiles = g_object_get_data (G_OBJECT (area), "output-tiles");
 
-    /* Align endpoints */
-    end_x = x + ceil (w * scale);
-    end_y = y + ceil (h * scale);
-    if (abs ((int) end_x - (int) *snap_x) <= 1)
+    if (tiles == NULL)
     {
-        end_x = *snap_x;
+        tiles = g_ptr_array_new_with_free_func (output_tile_free);
+        g_object_set_data_full (G_OBJECT (area), "output-tiles", tiles, (GDestroyNotify) g_ptr_array_unref);
     }
-    if (abs ((int) end_y - (int) *snap_y) <= 1)
-    {
-        end_y = *snap_y;
-    }
-    *snap_x = end_x;
-    *snap_y = end_y;
+
+    while (tiles->len <= index)
+        g_ptr_array_add (tiles, g_new0 (OutputTile, 1));
+
+    return g_ptr_array_index (tiles, index);
+}
+
+static void
+canvas_geometry_init (XfceDisplaySettings *settings,
+                      CanvasGeometry *geom)
+{
+    foo_scroll_area_get_viewport (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)), &geom->viewport);
+    geom->viewport.height -= 2 * MARGIN;
+    geom->viewport.width -= 2 * MARGIN;
+
+    get_total_size (xfce_display_settings_get_outputs (settings), &geom->total_w, &geom->total_h);
+    geom->scale = compute_scale (settings);
+}
+
+static void
+get_output_origin (const CanvasGeometry *geom,
+                   XfceOutput *output,
+                   double *x,
+                   double *y)
+{
+    /* Center the displayed outputs in the viewport */
+    *x = ceil (output->x * geom->scale + MARGIN + (geom->viewport.width - geom->total_w * geom->scale) / 2.0);
+    *y = ceil (output->y * geom->scale + MARGIN + (geom->viewport.height - geom->total_h * geom->scale) / 2.0);
+}
+
+static void
+get_output_area (const CanvasGeometry *geom,
+                 XfceOutput *output,
+                 GdkRectangle *area)
+{
+    double x, y;
+    int w, h;
+
+    get_output_origin (geom, output, &x, &y);
+    get_geometry (output, &w, &h);
+
+    /* one more pixel for the endpoint alignment in paint_output() */
+    area->x = x;
+    area->y = y;
+    area->width = ceil (w * geom->scale) + 1;
+    area->height = ceil (h * geom->scale) + 1;
+}
+
+static void
+render_output_tile (GtkWidget *widget,
+                    OutputTile *tile)
+{
+    int w = tile->key.w, h = tile->key.h;
+    double x = 0.0, y = 0.0;
+    double end_x = tile->key.width, end_y = tile->key.height;
+    double scale = tile->key.scale;
+    double alpha = tile->key.alpha;
+    PangoLayout *layout;
+    PangoRectangle ink_extent, log_extent;
+    cairo_pattern_t *pat_lin = NULL, *pat_radial = NULL;
+    double available_w;
+    double factor = 1.0;
+    cairo_t *cr;
+
+    if (tile->surface != NULL)
+        cairo_surface_destroy (tile->surface);
+    tile->surface = gdk_window_create_similar_image_surface (gtk_widget_get_window (widget), CAIRO_FORMAT_ARGB32,
+                                                             MAX (tile->key.width, 1), MAX (tile->key.height, 1),
+                                                             tile->key.scale_factor);
+    cr = cairo_create (tile->surface);
 
     cairo_translate (cr, x + (w * scale) / 2, y + (h * scale) / 2);
 
     /* rotation is already applied in get_geometry */
 
-    if (output->rotation == ROTATION_FLAGS_REFLECT_X)
+    if (tile->key.rotation == ROTATION_FLAGS_REFLECT_X)
         cairo_scale (cr, -1, 1);
 
-    if (output->rotation == ROTATION_FLAGS_REFLECT_Y)
+    if (tile->key.rotation == ROTATION_FLAGS_REFLECT_Y)
         cairo_scale (cr, 1, -1);
 
     cairo_translate (cr, -x - (w * scale) / 2, -y - (h * scale) / 2);
     cairo_rectangle (cr, x, y, end_x - x, end_y - y);
     cairo_clip_preserve (cr);
 
-    foo_scroll_area_add_input_from_fill (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)),
-                                         cr, on_output_event, output);
-
     cairo_set_line_width (cr, 1.0);
 
-    /* Make overlapping displays ('mirrored') more transparent so both displays can
-       be recognized more easily */
-    if (output->id != selected_id && state == MIRRORED_STATE_MIRRORED)
-        alpha = 0.5;
-    /* When displays are cloned it makes no sense to make them semi-transparent
-       because they overlay each other completely */
-    else if (state == MIRRORED_STATE_CLONED)
-        alpha = 1.0;
-    /* the inactive display should be more transparent and the overlapping one as
-       well */
-    else if (output->id != selected_id || state == MIRRORED_STATE_MIRRORED)
-        alpha = 0.7;
-
-    if (output->active)
+    if (tile->key.active)
     {
         /* Background gradient for active display */
         pat_lin = cairo_pattern_create_linear (x, y, x, y + (h * scale));
@@ -2790,7 +2615,7 @@ paint_output (XfceDisplaySettings *settings,
     cairo_fill (cr);
 
     /* Draw a panel type rectangle to show which monitor is primary */
-    if (xfce_display_settings_is_primary (settings, output->id))
+    if (tile->key.primary)
     {
         GdkPixbuf *pixbuf;
         GtkIconInfo *icon_info;
@@ -2801,7 +2626,7 @@ paint_output (XfceDisplaySettings *settings,
         icon_info = gtk_icon_theme_lookup_icon_for_scale (gtk_icon_theme_get_default (),
                                                           "help-about-symbolic",
                                                           icon_size,
-                                                          scale_factor,
+                                                          tile->key.scale_factor,
                                                           GTK_ICON_LOOKUP_GENERIC_FALLBACK
                                                               | GTK_ICON_LOOKUP_FORCE_SIZE);
 
@@ -2810,8 +2635,8 @@ paint_output (XfceDisplaySettings *settings,
         if (G_LIKELY (pixbuf != NULL))
         {
             cairo_save (cr);
-            cairo_translate (cr, x + scale_factor, y + scale_factor);
-            cairo_scale (cr, 1.0 / scale_factor, 1.0 / scale_factor);
+            cairo_translate (cr, x + tile->key.scale_factor, y + tile->key.scale_factor);
+            cairo_scale (cr, 1.0 / tile->key.scale_factor, 1.0 / tile->key.scale_factor);
             gdk_cairo_set_source_pixbuf (cr, pixbuf, 0, 0);
             cairo_paint (cr);
             cairo_restore (cr);
@@ -2821,20 +2646,7 @@ paint_output (XfceDisplaySettings *settings,
     }
 
     /* Display name label*/
-    if (state == MIRRORED_STATE_CLONED)
-    {
-        /* Translators:  this is the feature where what you see on your laptop's
-         * screen is the same as your external monitor.  Here, "Mirror" is being
-         * used as an adjective, not as a verb.  For example, the Spanish
-         * translation could be "Pantallas en Espejo", *not* "Espejar Pantallas".
-         */
-        text = _("Mirror Screens");
-    }
-    else
-    {
-        text = output->friendly_name;
-    }
-    layout = gtk_widget_create_pango_layout (xfce_display_settings_get_scroll_area (settings), text);
+    layout = gtk_widget_create_pango_layout (widget, tile->text);
     layout_set_font (layout, "Sans Bold 12");
     pango_layout_get_pixel_extents (layout, &ink_extent, &log_extent);
 
@@ -2853,7 +2665,7 @@ paint_output (XfceDisplaySettings *settings,
                    x + ((w * scale + 0.5) - factor * log_extent.width) / 2,
                    y + ((h * scale + 0.5) - factor * log_extent.height) / 2 - 1);
     /* Try to make the text as readable as possible for overlapping displays */
-    if (output->id == selected_id && state == MIRRORED_STATE_MIRRORED)
+    if (tile->key.highlighted)
         cairo_set_source_rgba (cr, 0.0, 0.0, 0.0, alpha);
     else
         cairo_set_source_rgba (cr, 0.0, 0.0, 0.0, alpha - 0.6);
@@ -2866,7 +2678,7 @@ paint_output (XfceDisplaySettings *settings,
 
     /* Try to make the text as readable as possible for overlapping displays - the
        currently selected one could be painted below the other display*/
-    if (output->id == selected_id && state == MIRRORED_STATE_MIRRORED)
+    if (tile->key.highlighted)
         cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
     else
         cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, alpha);
@@ -2874,11 +2686,11 @@ paint_output (XfceDisplaySettings *settings,
     pango_cairo_show_layout (cr, layout);
 
     /* Display state label */
-    if (!output->active)
+    if (!tile->key.active)
     {
         PangoLayout *display_state;
 
-        display_state = gtk_widget_create_pango_layout (xfce_display_settings_get_scroll_area (settings), _("(Disabled)"));
+        display_state = gtk_widget_create_pango_layout (widget, _("(Disabled)"));
         layout_set_font (display_state, "Sans 8");
         pango_layout_get_pixel_extents (display_state, &ink_extent, &log_extent);
 
@@ -2896,14 +2708,14 @@ paint_output (XfceDisplaySettings *settings,
     }
 
     /* Show display number in the left bottom corner if there's more than 1*/
-    if (xfce_display_settings_get_n_outputs (settings) > 1)
+    if (tile->key.numbered)
     {
         PangoLayout *display_number;
         gchar *display_num;
 
 
-        display_num = g_strdup_printf ("%d", i + 1);
-        display_number = gtk_widget_create_pango_layout (xfce_display_settings_get_scroll_area (settings), display_num);
+        display_num = g_strdup_printf ("%d", tile->key.index + 1);
+        display_number = gtk_widget_create_pango_layout (widget, display_num);
         layout_set_font (display_number, "Mono Bold 9");
         pango_layout_get_pixel_extents (display_number, &ink_extent, &log_extent);
 
@@ -2928,7 +2740,8 @@ paint_output (XfceDisplaySettings *settings,
         g_free (display_num);
     }
 
-    cairo_restore (cr);
+
+    cairo_destroy (cr);
 
     if (pat_lin)
         cairo_pattern_destroy (pat_lin);
@@ -2938,6 +2751,109 @@ paint_output (XfceDisplaySettings *settings,
     g_object_unref (layout);
 }
 
+static void
+paint_output (XfceDisplaySettings *settings,
+              cairo_t *cr,
+              const CanvasGeometry *geom,
+              XfceOutput *output,
+              guint i,
+              gint scale_factor,
+              const GdkRectangle *clip,
+              double *snap_x,
+              double *snap_y)
+{
+    GtkWidget *area = xfce_display_settings_get_scroll_area (settings);
+    OutputTile *tile = get_output_tile (area, i);
+    OutputTileKey key;
+    GdkRectangle output_area;
+    int w, h;
+    double x, y, end_x, end_y;
+    double alpha = 1.0;
+    const char *text;
+    MirroredState state = xfce_display_settings_get_mirrored_state (settings);
+    guint selected_id = xfce_display_settings_get_selected_output_id (settings);
+
+    get_geometry (output, &w, &h);
+    get_output_origin (geom, output, &x, &y);
+
+    /* Align endpoints */
+    end_x = x + ceil (w * geom->scale);
+    end_y = y + ceil (h * geom->scale);
+    if (abs ((int) end_x - (int) *snap_x) <= 1)
+    {
+        end_x = *snap_x;
+    }
+    if (abs ((int) end_y - (int) *snap_y) <= 1)
+    {
+        end_y = *snap_y;
+    }
+    *snap_x = end_x;
+    *snap_y = end_y;
+
+    /* nothing to do outside of the damaged area */
+    get_output_area (geom, output, &output_area);
+    if (clip != NULL && !gdk_rectangle_intersect (clip, &output_area, NULL))
+        return;
+    tile->area = output_area;
+
+    /* Make overlapping displays ('mirrored') more transparent so both displays can
+       be recognized more easily */
+    if (output->id != selected_id && state == MIRRORED_STATE_MIRRORED)
+        alpha = 0.5;
+    /* When displays are cloned it makes no sense to make them semi-transparent
+       because they overlay each other completely */
+    else if (state == MIRRORED_STATE_CLONED)
+        alpha = 1.0;
+    /* the inactive display should be more transparent and the overlapping one as
+       well */
+    else if (output->id != selected_id || state == MIRRORED_STATE_MIRRORED)
+        alpha = 0.7;
+
+    if (state == MIRRORED_STATE_CLONED)
+    {
+        /* Translators:  this is the feature where what you see on your laptop's
+         * screen is the same as your external monitor.  Here, "Mirror" is being
+         * used as an adjective, not as a verb.  For example, the Spanish
+         * translation could be "Pantallas en Espejo", *not* "Espejar Pantallas".
+         */
+        text = _("Mirror Screens");
+    }
+    else
+    {
+        text = output->friendly_name;
+    }
+
+    memset (&key, 0, sizeof (key));
+    key.w = w;
+    key.h = h;
+    key.width = end_x - x;
+    key.height = end_y - y;
+    key.scale = geom->scale;
+    key.scale_factor = scale_factor;
+    key.index = i;
+    key.numbered = xfce_display_settings_get_n_outputs (settings) > 1;
+    key.active = output->active;
+    key.primary = xfce_display_settings_is_primary (settings, output->id);
+    key.highlighted = output->id == selected_id && state == MIRRORED_STATE_MIRRORED;
+    key.rotation = output->rotation;
+    key.alpha = alpha;
+
+    if (tile->surface == NULL || memcmp (&key, &tile->key, sizeof (key)) != 0 || g_strcmp0 (text, tile->text) != 0)
+    {
+        memcpy (&tile->key, &key, sizeof (key));
+        g_free (tile->text);
+        tile->text = g_strdup (text);
+        render_output_tile (area, tile);
+    }
+
+    cairo_save (cr);
+    cairo_rectangle (cr, x, y, end_x - x, end_y - y);
+    foo_scroll_area_add_input_from_fill (FOO_SCROLL_AREA (area), cr, on_output_event, output);
+    cairo_set_source_surface (cr, tile->surface, x, y);
+    cairo_fill (cr);
+    cairo_restore (cr);
+}
+
 static void
 on_area_paint (FooScrollArea *area,
                cairo_t *cr,
@@ -2948,27 +2864,88 @@ on_area_paint (FooScrollArea *area,
     double x = 0.0, y = 0.0;
     gint scale_factor = gtk_widget_get_scale_factor (GTK_WIDGET (area));
     guint selected_id = xfce_display_settings_get_selected_output_id (settings);
+    XfceOutput *selected = NULL;
+    CanvasGeometry geom;
+    GdkRectangle clip;
+    gboolean clipped;
+    guint i;
 
     paint_background (area, cr);
 
-    for (list = outputs; list != NULL; list = list->next)
-    {
-        gint i;
+    canvas_geometry_init (settings, &geom);
+    clipped = gdk_cairo_get_clip_rectangle (cr, &clip);
 
-        i = g_list_position (outputs, list);
+    for (list = outputs, i = 0; list != NULL; list = list->next, i++)
+    {
         /* Always paint the currently selected display last, i.e. on top, so it's
            visible and the name is readable */
-        if (i >= 0 && (guint) i == selected_id)
+        if (i == selected_id)
         {
+            selected = list->data;
             continue;
         }
-        paint_output (settings, cr, i, scale_factor, &x, &y);
+        paint_output (settings, cr, &geom, list->data, i, scale_factor, clipped ? &clip : NULL, &x, &y);
 
         if (xfce_display_settings_get_mirrored_state (settings) == MIRRORED_STATE_CLONED)
             break;
     }
     /* Finally also paint the active output */
-    paint_output (settings, cr, selected_id, scale_factor, &x, &y);
+    if (selected == NULL)
+        selected = get_nth_xfce_output (settings, selected_id);
+    if (selected != NULL)
+        paint_output (settings, cr, &geom, selected, selected_id, scale_factor, clipped ? &clip : NULL, &x, &y);
+}
+
+static void
+on_area_style_updated (GtkWidget *area)
+{
+    /* fonts or icons may have changed */
+    g_object_set_data (G_OBJECT (area), "output-tiles", NULL);
+}
+
+/* Invalidate what changed since the last paint, i.e. the old and new areas
+ * of the outputs that moved, instead of the whole canvas */
+static void
+invalidate_moved_outputs (XfceDisplaySettings *settings)
+{
+    GtkWidget *area = xfce_display_settings_get_scroll_area (settings);
+    GPtrArray *tiles = g_object_get_data (G_OBJECT (area), "output-tiles");
+    CanvasGeometry geom;
+    cairo_region_t *region;
+    guint i = 0;
+
+    if (tiles == NULL)
+    {
+        foo_scroll_area_invalidate (FOO_SCROLL_AREA (area));
+        return;
+    }
+
+    canvas_geometry_init (settings, &geom);
+    region = cairo_region_create ();
+
+    for (GList *list = xfce_display_settings_get_outputs (settings); list != NULL; list = list->next, i++)
+    {
+        OutputTile *tile = i < tiles->len ? g_ptr_array_index (tiles, i) : NULL;
+        GdkRectangle output_area;
+
+        if (tile == NULL || tile->surface == NULL)
+        {
+            foo_scroll_area_invalidate (FOO_SCROLL_AREA (area));
+            cairo_region_destroy (region);
+            return;
+        }
+
+        get_output_area (&geom, list->data, &output_area);
+        if (!gdk_rectangle_equal (&tile->area, &output_area))
+        {
+            cairo_region_union_rectangle (region, &tile->area);
+            cairo_region_union_rectangle (region, &output_area);
+        }
+    }
+
+    if (!cairo_region_is_empty (region))
+        foo_scroll_area_invalidate_region (FOO_SCROLL_AREA (area), region);
+    cairo_region_destroy (region);
 }
 /* Xfce RANDR GUI */
 
@@ -2976,12 +2953,86 @@ static void
 display_settings_quit (XfceDisplaySettings *settings)
 {
     guint id = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (settings), "show-confirmation-dialog-id"));
+    if (id != 0)
+        g_source_remove (id);
+    id = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (settings), "populate-dialog-id"));
     if (id != 0)
         g_source_remove (id);
     g_object_unref (settings);
     gtk_main_quit ();
 }
 
+static gboolean
+display_settings_dialog_populate_profiles (gpointer data)
+{
+    XfceDisplaySettings *settings = data;
+
+    g_object_set_data (G_OBJECT (settings), "populate-dialog-id", NULL);
+
+    xfce_display_settings_populate_profile_list (settings);
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "display dialog: profiles requested after %.1f ms",
+                    (g_get_monotonic_time () - startup_time) / 1000.0);
+
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+display_settings_dialog_populate_outputs (gpointer data)
+{
+    XfceDisplaySettings *settings = data;
+    GtkBuilder *builder = xfce_display_settings_get_builder (settings);
+    GError *error = NULL;
+    guint id;
+
+    g_object_set_data (G_OBJECT (settings), "populate-dialog-id", NULL);
+
+    /* the backend queries the outputs and their EDIDs while the skeleton is drawn */
+    if (!xfce_display_settings_wait_ready (settings, &error))
+    {
+        display_settings_show_startup_error (error);
+        g_error_free (error);
+        startup_failed = TRUE;
+        gtk_main_quit ();
+        return G_SOURCE_REMOVE;
+    }
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "display dialog: outputs known after %.1f ms",
+                    (g_get_monotonic_time () - startup_time) / 1000.0);
+
+    xfce_display_settings_set_outputs (settings);
+    display_settings_dialog_populate (settings);
+    foo_scroll_area_invalidate (FOO_SCROLL_AREA (xfce_display_settings_get_scroll_area (settings)));
+    gtk_widget_set_sensitive (GTK_WIDGET (gtk_builder_get_object (builder, "plug-child")), TRUE);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "display dialog: interactive after %.1f ms",
+                    (g_get_monotonic_time () - startup_time) / 1000.0);
+
+    /* the profiles come last, they are not needed to use the dialog */
+    id = g_idle_add (display_settings_dialog_populate_profiles, settings);
+    g_object_set_data (G_OBJECT (settings), "populate-dialog-id", GUINT_TO_POINTER (id));
+
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean
+display_settings_dialog_drawn (GtkWidget *widget,
+                               cairo_t *cr,
+                               XfceDisplaySettings *settings)
+{
+    guint id;
+
+    g_signal_handlers_disconnect_by_func (widget, display_settings_dialog_drawn, settings);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "display dialog: first frame after %.1f ms",
+                    (g_get_monotonic_time () - startup_time) / 1000.0);
+
+    /* the skeleton is on screen, now fill in the outputs */
+    id = g_idle_add (display_settings_dialog_populate_outputs, settings);
+    g_object_set_data (G_OBJECT (settings), "populate-dialog-id", GUINT_TO_POINTER (id));
+
+    return FALSE;
+}
+
 static void
 display_settings_show_main_dialog (XfceDisplaySettings *settings)
 {
@@ -2990,18 +3041,21 @@ display_settings_show_main_dialog (XfceDisplaySettings *settings)
     GError *error = NULL;
     GtkWidget *gui_container;
     GtkWidget *scroll_area;
+    GtkWidget *toplevel;
 
     /* Load the Gtk user-interface file */
     if (gtk_builder_add_from_resource (builder, "/org/xfce/settings/display-dialog.glade", &error) != 0)
     {
-        xfce_display_settings_set_outputs (settings);
-
-        /* Build the dialog */
+        /* Build the dialog skeleton, the outputs are filled in once it is on screen */
         dialog = display_settings_dialog_new (settings);
+        gtk_widget_set_sensitive (GTK_WIDGET (gtk_builder_get_object (builder, "plug-child")), FALSE);
 
         /* Scroll Area */
         scroll_area = xfce_display_settings_get_scroll_area (settings);
         g_object_set_data (G_OBJECT (scroll_area), "settings", settings);
+        g_object_set_data_full (G_OBJECT (scroll_area), "motion-histogram",
+                                xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Output drag, motion to snap"),
+                                (GDestroyNotify) xfsettings_dbg_histogram_free);
 
         set_monitors_tooltip (settings, NULL);
 
@@ -3009,6 +3063,7 @@ display_settings_show_main_dialog (XfceDisplaySettings *settings)
         foo_scroll_area_set_min_size (FOO_SCROLL_AREA (scroll_area), -1, 200);
         gtk_widget_show (scroll_area);
         g_signal_connect (scroll_area, "paint", G_CALLBACK (on_area_paint), settings);
+        g_signal_connect (scroll_area, "style-updated", G_CALLBACK (on_area_style_updated), NULL);
         g_signal_connect (scroll_area, "viewport-changed", G_CALLBACK (on_viewport_changed), NULL);
         g_signal_connect (scroll_area, "leave-notify-event", G_CALLBACK (on_canvas_event), NULL);
 
@@ -3031,6 +3086,7 @@ display_settings_show_main_dialog (XfceDisplaySettings *settings)
             plug_child = gtk_builder_get_object (builder, "plug-child");
             xfce_widget_reparent (GTK_WIDGET (plug_child), plug);
             gtk_widget_show (GTK_WIDGET (plug_child));
+            toplevel = plug;
         }
         else
 #endif
@@ -3041,8 +3097,11 @@ display_settings_show_main_dialog (XfceDisplaySettings *settings)
                                       G_CALLBACK (display_settings_quit), settings);
             /* Show the dialog */
             gtk_window_present (GTK_WINDOW (dialog));
+            toplevel = dialog;
         }
 
+        g_signal_connect_after (toplevel, "draw", G_CALLBACK (display_settings_dialog_drawn), settings);
+
         /* Enter the main loop */
         gtk_main ();
     }
@@ -3315,6 +3374,35 @@ display_settings_show_minimal_dialog (XfceDisplaySettings *settings)
     }
 }
 
+static void
+display_settings_show_startup_error (const GError *error)
+{
+    const gchar *alternative = NULL, *alternative_icon = NULL;
+    gchar *command = g_find_program_in_path ("amdcccle");
+    GError *spawn_error = NULL;
+    gint response;
+
+    if (command != NULL)
+    {
+        alternative = _("ATI Settings");
+        alternative_icon = "ccc_small";
+    }
+
+    response = xfce_message_dialog (NULL, NULL, "dialog-error",
+                                    _("Unable to start the Xfce Display Settings"),
+                                    error->message, _("_Close"), GTK_RESPONSE_CLOSE,
+                                    alternative != NULL ? XFCE_BUTTON_TYPE_MIXED : NULL,
+                                    alternative_icon, alternative, GTK_RESPONSE_OK, NULL);
+
+    if (response == GTK_RESPONSE_OK && !g_spawn_command_line_async (command, &spawn_error))
+    {
+        xfce_dialog_show_error (NULL, spawn_error, _("Unable to launch the proprietary driver settings"));
+        g_error_free (spawn_error);
+    }
+
+    g_free (command);
+}
+
 static gint
 handle_local_options (GApplication *app,
                       GVariantDict *options,
@@ -3325,19 +3413,33 @@ handle_local_options (GApplication *app,
     if (!g_application_register (app, NULL, &error))
     {
         g_warning ("Unable to register GApplication: %s", error->message);
-        g_error_free (error);
+        g_clear_error (&error);
     }
 
     if (!g_application_get_is_remote (app))
     {
-        if (xfce_display_settings_get_n_outputs (settings) <= 1 || !xfce_display_settings_is_minimal (settings))
+        /* the main dialog is shown before the outputs are known, it waits for them once on screen */
+        if (!xfce_display_settings_is_minimal (settings))
         {
             display_settings_show_main_dialog (settings);
+            return startup_failed ? EXIT_FAILURE : EXIT_SUCCESS;
         }
-        else
+
+        /* outputs may still be coming in, registering did not have to wait for them */
+        if (!xfce_display_settings_wait_ready (settings, &error))
         {
-            display_settings_show_minimal_dialog (settings);
+            display_settings_show_startup_error (error);
+            g_error_free (error);
+            return EXIT_FAILURE;
+        }
+
+        if (xfce_display_settings_get_n_outputs (settings) <= 1)
+        {
+            display_settings_show_main_dialog (settings);
+            return startup_failed ? EXIT_FAILURE : EXIT_SUCCESS;
         }
+
+        display_settings_show_minimal_dialog (settings);
         return EXIT_SUCCESS;
     }
 
@@ -3358,6 +3460,8 @@ main (gint argc,
     XfceDisplaySettings *settings;
     GError *error = NULL;
 
+    startup_time = g_get_monotonic_time ();
+
     /* Setup translation domain */
     xfce_textdomain (GETTEXT_PACKAGE, LOCALEDIR, "UTF-8");
 
@@ -3408,30 +3512,8 @@ main (gint argc,
     settings = xfce_display_settings_new (opt_minimal, &error);
     if (settings == NULL)
     {
-        const gchar *alternative = NULL, *alternative_icon = NULL;
-        gchar *command = g_find_program_in_path ("amdcccle");
-        gint response;
-
-        if (command != NULL)
-        {
-            alternative = _("ATI Settings");
-            alternative_icon = "ccc_small";
-        }
-
-        response = xfce_message_dialog (NULL, NULL, "dialog-error",
-                                        _("Unable to start the Xfce Display Settings"),
-                                        error->message, _("_Close"), GTK_RESPONSE_CLOSE,
-                                        alternative != NULL ? XFCE_BUTTON_TYPE_MIXED : NULL,
-                                        alternative_icon, alternative, GTK_RESPONSE_OK, NULL);
-        g_clear_error (&error);
-
-        if (response == GTK_RESPONSE_OK && !g_spawn_command_line_async (command, &error))
-        {
-            xfce_dialog_show_error (NULL, error, _("Unable to launch the proprietary driver settings"));
-            g_error_free (error);
-        }
-
-        g_free (command);
+        display_settings_show_startup_error (error);
+        g_error_free (error);
         xfconf_shutdown ();
 
         return EXIT_FAILURE;
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Moves the pointer over a scroll area painted like the canvas of the dialog,
+ * a background and 2 to 32 outputs, and times how many motion events the
+ * scroll area hit-tests per second. The scroll area lives in an offscreen
+ * window, but GTK still needs a display; without one the benchmark is
+ * skipped. Run it with
+ *
+ *   meson test -C build --benchmark --verbose scrollarea
+ */
+
+#include "scrollarea.h"
+
+#include <stdlib.h>
+
+/* what meson expects from a skipped test or benchmark */
+#define EXIT_SKIP 77
+
+#define N_MOTIONS 20000
+
+/* outputs per row of the layout */
+#define ROW_LENGTH 8
+
+/* the dialog shows the layout scaled down, about that much */
+#define CANVAS_SCALE 8
+
+static const guint bench_n_outputs[] = { 2, 4, 8, 16, 32 };
+
+typedef struct
+{
+    GdkRectangle *rects;
+    guint n_rects;
+    GdkRectangle bounds;
+    gboolean painted;
+    guint n_hits;
+} BenchCanvas;
+
+/* Rows of 1920x1080 and 2560x1440 outputs side by side, each row below the
+ * previous one, scaled down to the canvas. */
+static void
+bench_canvas_init (BenchCanvas *canvas,
+                   guint n_outputs)
+{
+    int x = 0, y = 0, row_height = 0;
+
+    canvas->rects = g_new0 (GdkRectangle, n_outputs);
+    canvas->n_rects = n_outputs;
+    canvas->painted = FALSE;
+    canvas->n_hits = 0;
+
+    for (guint n = 0; n < n_outputs; n++)
+    {
+        if (n > 0 && n % ROW_LENGTH == 0)
+        {
+            y += row_height;
+            x = 0;
+            row_height = 0;
+        }
+
+        canvas->rects[n].x = x;
+        canvas->rects[n].y = y;
+        canvas->rects[n].width = (n % 3 == 1 ? 2560 : 1920) / CANVAS_SCALE;
+        canvas->rects[n].height = (n % 3 == 1 ? 1440 : 1080) / CANVAS_SCALE;
+
+        x += canvas->rects[n].width;
+        row_height = MAX (row_height, canvas->rects[n].height);
+        if (n == 0)
+            canvas->bounds = canvas->rects[n];
+        else
+            gdk_rectangle_union (&canvas->bounds, &canvas->rects[n], &canvas->bounds);
+    }
+}
+
+static void
+on_output_event (FooScrollArea *area,
+                 FooScrollAreaEvent *event,
+                 gpointer data)
+{
+    BenchCanvas *canvas = data;
+
+    if (event->type == FOO_MOTION)
+        canvas->n_hits++;
+}
+
+static void
+on_canvas_event (FooScrollArea *area,
+                 FooScrollAreaEvent *event,
+                 gpointer data)
+{
+}
+
+/* the same input paths as on_area_paint() in the dialog, the background
+ * first and the outputs on top of it */
+static void
+on_area_paint (FooScrollArea *area,
+               cairo_t *cr,
+               BenchCanvas *canvas)
+{
+    cairo_rectangle (cr, 0, 0, canvas->bounds.width, canvas->bounds.height);
+    foo_scroll_area_add_input_from_fill (area, cr, on_canvas_event, NULL);
+    cairo_new_path (cr);
+
+    for (guint n = 0; n < canvas->n_rects; n++)
+    {
+        cairo_rectangle (cr, canvas->rects[n].x, canvas->rects[n].y, canvas->rects[n].width, canvas->rects[n].height);
+        foo_scroll_area_add_input_from_fill (area, cr, on_output_event, canvas);
+        cairo_set_source_rgb (cr, 0.5, 0.5, 0.5);
+        cairo_fill (cr);
+    }
+
+    canvas->painted = TRUE;
+}
+
+static gint
+compare_times (gconstpointer a,
+               gconstpointer b)
+{
+    gint64 t1 = *(const gint64 *) a;
+    gint64 t2 = *(const gint64 *) b;
+
+    return (t1 > t2) - (t1 < t2);
+}
+
+gint
+main (gint argc,
+      gchar **argv)
+{
+    if (!gtk_init_check (&argc, &argv))
+    {
+        g_print ("Skipped, no display to run GTK on\n");
+        return EXIT_SKIP;
+    }
+
+    for (guint i = 0; i < G_N_ELEMENTS (bench_n_outputs); i++)
+    {
+        guint n_outputs = bench_n_outputs[i];
+        BenchCanvas canvas;
+        GtkWidget *window, *area;
+        GdkEventMotion event = { 0 };
+        gint64 *times;
+        GRand *rand;
+        gint64 start, deadline, total = 0;
+        int x, y;
+
+        bench_canvas_init (&canvas, n_outputs);
+
+        window = gtk_offscreen_window_new ();
+        area = GTK_WIDGET (foo_scroll_area_new ());
+        foo_scroll_area_set_min_size (FOO_SCROLL_AREA (area), canvas.bounds.width, canvas.bounds.height);
+        foo_scroll_area_set_size (FOO_SCROLL_AREA (area), canvas.bounds.width, canvas.bounds.height);
+        g_signal_connect (area, "paint", G_CALLBACK (on_area_paint), &canvas);
+        gtk_container_add (GTK_CONTAINER (window), area);
+        gtk_widget_show_all (window);
+
+        /* the input paths are only known once the area has been painted */
+        foo_scroll_area_invalidate (FOO_SCROLL_AREA (area));
+        deadline = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+        while (!canvas.painted && g_get_monotonic_time () < deadline)
+            gtk_main_iteration_do (FALSE);
+
+        if (!canvas.painted)
+        {
+            g_printerr ("The scroll area for %u outputs was never painted\n", n_outputs);
+            return EXIT_FAILURE;
+        }
+
+        event.type = GDK_MOTION_NOTIFY;
+        event.window = gtk_widget_get_window (area);
+        event.send_event = TRUE;
+        times = g_new (gint64, N_MOTIONS);
+        rand = g_rand_new_with_seed (n_outputs);
+        x = canvas.bounds.width / 2;
+        y = canvas.bounds.height / 2;
+
+        /* the pointer mostly moves a few pixels per event and now and then
+         * enters from somewhere else */
+        for (guint n = 0; n < N_MOTIONS; n++)
+        {
+            if (g_rand_int_range (rand, 0, 100) == 0)
+            {
+                x = g_rand_int_range (rand, 0, canvas.bounds.width);
+                y = g_rand_int_range (rand, 0, canvas.bounds.height);
+            }
+            else
+            {
+                x = CLAMP (x + g_rand_int_range (rand, -4, 5), 0, canvas.bounds.width - 1);
+                y = CLAMP (y + g_rand_int_range (rand, -4, 5), 0, canvas.bounds.height - 1);
+            }
+
+            event.x = x;
+            event.y = y;
+            event.time = n;
+
+            /* straight to the handler, not through the event queue, so
+             * only the scroll area is timed */
+            start = g_get_monotonic_time ();
+            GTK_WIDGET_GET_CLASS (area)->motion_notify_event (area, &event);
+            times[n] = g_get_monotonic_time () - start;
+            total += times[n];
+        }
+
+        qsort (times, N_MOTIONS, sizeof (gint64), compare_times);
+        g_print ("hit-test %2u outputs  %10.0f events/s  mean %8.2f us  p99 %6" G_GINT64_FORMAT
+                 " us  max %6" G_GINT64_FORMAT " us  %5.1f%% on an output\n",
+                 n_outputs, total > 0 ? N_MOTIONS * (gdouble) G_USEC_PER_SEC / total : 0.0,
+                 (gdouble) total / N_MOTIONS, times[N_MOTIONS * 99 / 100], times[N_MOTIONS - 1],
+                 100.0 * canvas.n_hits / N_MOTIONS);
+
+        g_rand_free (rand);
+        g_free (times);
+        gtk_widget_destroy (window);
+        g_free (canvas.rects);
+    }
+
+    return EXIT_SUCCESS;
+}
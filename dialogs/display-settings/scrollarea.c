@@ -19,6 +19,10 @@
 #include "foo-marshal.h"
 #include "scrollarea.h"
 
+#include "common/debug.h"
+
+#include <math.h>
+
 G_DEFINE_TYPE_WITH_CODE (FooScrollArea, foo_scroll_area, GTK_TYPE_CONTAINER, G_IMPLEMENT_INTERFACE (GTK_TYPE_SCROLLABLE, NULL));
 
 static GtkWidgetClass *parent_class;
@@ -27,6 +31,9 @@ typedef struct BackingStore BackingStore;
 
 typedef void (*ExposeFunc) (cairo_t *cr, GdkRegion *region, gpointer data);
 
+/* side of the cells of the grid indexing the input paths of a region */
+#define INPUT_GRID_CELL_SIZE 32
+
 typedef struct InputPath InputPath;
 typedef struct InputRegion InputRegion;
 typedef struct AutoScrollInfo AutoScrollInfo;
@@ -37,6 +44,7 @@ struct InputPath
     cairo_fill_rule_t fill_rule;
     double line_width;
     cairo_path_t *path; /* In canvas coordinates */
+    cairo_rectangle_int_t extents; /* In canvas coordinates */
 
     FooScrollAreaEventFunc func;
     gpointer data;
@@ -49,6 +57,17 @@ struct InputRegion
 {
     GdkRegion *region; /* the boundary of this area in canvas coordinates */
     InputPath *paths;
+
+    /* Built once the region has been painted: the paths in list order,
+     * and for every grid cell the indices of the paths whose extents
+     * overlap it, in ascending order.
+     */
+    GPtrArray *path_array;
+    cairo_rectangle_int_t grid_bounds;
+    int grid_columns;
+    int grid_rows;
+    guint *cell_start; /* grid_columns * grid_rows + 1 entries */
+    guint *cell_paths;
 };
 
 struct AutoScrollInfo
@@ -97,6 +116,10 @@ struct FooScrollAreaPrivate
 
     cairo_surface_t *surface;
     GdkRegion *update_region; /* In canvas coordinates */
+
+    /* scratch context for hit-testing input paths */
+    cairo_t *hit_cr;
+    XfsdDebugHistogram *hit_histogram;
 };
 
 enum
@@ -191,6 +214,9 @@ foo_scroll_area_finalize (GObject *object)
 
     g_ptr_array_free (scroll_area->priv->input_regions, TRUE);
     gdk_region_destroy (scroll_area->priv->update_region);
+    if (scroll_area->priv->hit_cr)
+        cairo_destroy (scroll_area->priv->hit_cr);
+    xfsettings_dbg_histogram_free (scroll_area->priv->hit_histogram);
 
     g_free (scroll_area->priv);
 
@@ -333,6 +359,7 @@ foo_scroll_area_init (FooScrollArea *scroll_area)
     scroll_area->priv->input_regions = g_ptr_array_new_with_free_func ((GDestroyNotify) input_region_free);
     scroll_area->priv->surface = NULL;
     scroll_area->priv->update_region = gdk_region_new ();
+    scroll_area->priv->hit_histogram = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Scroll area hit-test");
 }
 
 typedef void (*PathForeachFunc) (double *x,
@@ -356,9 +383,103 @@ input_region_free (InputRegion *region)
     input_path_free_list (region->paths);
     gdk_region_destroy (region->region);
 
+    if (region->path_array)
+        g_ptr_array_free (region->path_array, TRUE);
+    g_free (region->cell_start);
+    g_free (region->cell_paths);
+
     g_free (region);
 }
 
+static void
+input_region_get_cells (InputRegion *region,
+                        const cairo_rectangle_int_t *rect,
+                        int *first_column,
+                        int *last_column,
+                        int *first_row,
+                        int *last_row)
+{
+    *first_column = (rect->x - region->grid_bounds.x) / INPUT_GRID_CELL_SIZE;
+    *last_column = (rect->x + rect->width - region->grid_bounds.x) / INPUT_GRID_CELL_SIZE;
+    *first_row = (rect->y - region->grid_bounds.y) / INPUT_GRID_CELL_SIZE;
+    *last_row = (rect->y + rect->height - region->grid_bounds.y) / INPUT_GRID_CELL_SIZE;
+}
+
+static void
+input_region_build_index (InputRegion *region)
+{
+    InputPath *path;
+    guint *cell_fill;
+    guint i, n_cells;
+    int c0, c1, r0, r1, c, r;
+
+    if (!region->paths)
+        return;
+
+    region->path_array = g_ptr_array_new ();
+    for (path = region->paths; path; path = path->next)
+    {
+        if (region->path_array->len == 0)
+            region->grid_bounds = path->extents;
+        else
+            gdk_rectangle_union (&region->grid_bounds, &path->extents, &region->grid_bounds);
+        g_ptr_array_add (region->path_array, path);
+    }
+
+    /* extents are inclusive of their right and bottom edges */
+    region->grid_columns = region->grid_bounds.width / INPUT_GRID_CELL_SIZE + 1;
+    region->grid_rows = region->grid_bounds.height / INPUT_GRID_CELL_SIZE + 1;
+    n_cells = region->grid_columns * region->grid_rows;
+
+    /* count the paths per cell, then fill the cells in path order */
+    region->cell_start = g_new0 (guint, n_cells + 1);
+    for (i = 0; i < region->path_array->len; i++)
+    {
+        path = region->path_array->pdata[i];
+        input_region_get_cells (region, &path->extents, &c0, &c1, &r0, &r1);
+        for (r = r0; r <= r1; r++)
+            for (c = c0; c <= c1; c++)
+                region->cell_start[r * region->grid_columns + c + 1]++;
+    }
+    for (i = 0; i < n_cells; i++)
+        region->cell_start[i + 1] += region->cell_start[i];
+
+    region->cell_paths = g_new (guint, region->cell_start[n_cells]);
+    cell_fill = g_memdup2 (region->cell_start, n_cells * sizeof (guint));
+    for (i = 0; i < region->path_array->len; i++)
+    {
+        path = region->path_array->pdata[i];
+        input_region_get_cells (region, &path->extents, &c0, &c1, &r0, &r1);
+        for (r = r0; r <= r1; r++)
+            for (c = c0; c <= c1; c++)
+                region->cell_paths[cell_fill[r * region->grid_columns + c]++] = i;
+    }
+    g_free (cell_fill);
+}
+
+/* returns the indices of the paths that may contain (x, y) */
+static const guint *
+input_region_lookup (InputRegion *region,
+                     int x,
+                     int y,
+                     guint *n_paths)
+{
+    guint cell;
+
+    *n_paths = 0;
+
+    if (!region->cell_start
+        || x < region->grid_bounds.x || x > region->grid_bounds.x + region->grid_bounds.width
+        || y < region->grid_bounds.y || y > region->grid_bounds.y + region->grid_bounds.height)
+        return NULL;
+
+    cell = MIN ((y - region->grid_bounds.y) / INPUT_GRID_CELL_SIZE, region->grid_rows - 1) * region->grid_columns
+           + MIN ((x - region->grid_bounds.x) / INPUT_GRID_CELL_SIZE, region->grid_columns - 1);
+    *n_paths = region->cell_start[cell + 1] - region->cell_start[cell];
+
+    return region->cell_paths + region->cell_start[cell];
+}
+
 static void
 get_viewport (FooScrollArea *scroll_area,
               GdkRectangle *viewport)
@@ -456,6 +577,7 @@ foo_scroll_area_draw (GtkWidget *widget,
 
     g_signal_emit (widget, scrollarea_signals[PAINT], 0, widget_cr);
 
+    input_region_build_index (scroll_area->priv->current_input);
     scroll_area->priv->current_input = NULL;
 
     gtk_widget_get_allocation (widget, &widget_allocation);
@@ -739,14 +861,46 @@ emit_input (FooScrollArea *scroll_area,
     func (scroll_area, &event, data);
 }
 
+static gboolean
+input_path_contains (FooScrollArea *scroll_area,
+                     InputPath *path,
+                     int x,
+                     int y)
+{
+    cairo_t *cr;
+    cairo_surface_t *surface;
+
+    if (x < path->extents.x || x > path->extents.x + path->extents.width
+        || y < path->extents.y || y > path->extents.y + path->extents.height)
+        return FALSE;
+
+    if (!scroll_area->priv->hit_cr)
+    {
+        /* hit-testing does not draw anything, any target will do */
+        surface = cairo_image_surface_create (CAIRO_FORMAT_A8, 1, 1);
+        scroll_area->priv->hit_cr = cairo_create (surface);
+        cairo_surface_destroy (surface);
+    }
+
+    cr = scroll_area->priv->hit_cr;
+    cairo_new_path (cr);
+    cairo_set_fill_rule (cr, path->fill_rule);
+    cairo_set_line_width (cr, path->line_width);
+    cairo_append_path (cr, path->path);
+
+    if (path->is_stroke)
+        return cairo_in_stroke (cr, x, y);
+    else
+        return cairo_in_fill (cr, x, y);
+}
+
 static void
 process_event (FooScrollArea *scroll_area,
                FooScrollAreaEventType input_type,
                int x,
                int y)
 {
-    GtkWidget *widget = GTK_WIDGET (scroll_area);
-    guint i;
+    guint i, j;
 
     allocation_to_canvas (scroll_area, &x, &y);
 
@@ -765,44 +919,48 @@ process_event (FooScrollArea *scroll_area,
         if (gdk_region_point_in (region->region, x, y))
         {
             InputPath *path;
+            const guint *candidates;
+            guint n_candidates, n_outside;
+            gint64 start_time = g_get_monotonic_time ();
 
-            path = region->paths;
-            while (path)
+            /* only the paths whose extents share the grid cell of the
+             * point can contain it, the first one in list order wins
+             */
+            candidates = input_region_lookup (region, x, y, &n_candidates);
+            n_outside = region->path_array ? region->path_array->len : 0;
+            path = NULL;
+            for (j = 0; j < n_candidates; j++)
             {
-                cairo_t *cr;
-                gboolean inside;
-
-                G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-                cr = gdk_cairo_create (gtk_widget_get_window (widget));
-                G_GNUC_END_IGNORE_DEPRECATIONS
-                cairo_set_fill_rule (cr, path->fill_rule);
-                cairo_set_line_width (cr, path->line_width);
-                cairo_append_path (cr, path->path);
-
-                if (path->is_stroke)
-                    inside = cairo_in_stroke (cr, x, y);
-                else
-                    inside = cairo_in_fill (cr, x, y);
-
-                cairo_destroy (cr);
-
-                if (inside)
+                if (input_path_contains (scroll_area, region->path_array->pdata[candidates[j]], x, y))
                 {
-                    emit_input (scroll_area, input_type,
-                                x, y,
-                                path->func,
-                                path->data);
-                    return;
+                    path = region->path_array->pdata[candidates[j]];
+                    n_outside = candidates[j];
+                    break;
                 }
-                else if (input_type == FOO_MOTION)
+            }
+
+            xfsettings_dbg_histogram_add (scroll_area->priv->hit_histogram, g_get_monotonic_time () - start_time);
+
+            /* the paths before the match did not contain the point */
+            if (input_type == FOO_MOTION)
+            {
+                for (j = 0; j < n_outside; j++)
                 {
+                    InputPath *outside = region->path_array->pdata[j];
+
                     emit_input (scroll_area, FOO_MOTION_OUTSIDE,
                                 x, y,
-                                path->func,
-                                path->data);
+                                outside->func,
+                                outside->data);
                 }
+            }
 
-                path = path->next;
+            if (path)
+            {
+                emit_input (scroll_area, input_type,
+                            x, y,
+                            path->func,
+                            path->data);
             }
 
             /* Since the regions are all disjoint, no other region
@@ -1124,7 +1282,17 @@ make_path (FooScrollArea *area,
            gpointer data)
 {
     InputPath *path = g_new0 (InputPath, 1);
+    double x1, y1, x2, y2;
+
+    if (is_stroke)
+        cairo_stroke_extents (cr, &x1, &y1, &x2, &y2);
+    else
+        cairo_fill_extents (cr, &x1, &y1, &x2, &y2);
 
+    path->extents.x = floor (x1);
+    path->extents.y = floor (y1);
+    path->extents.width = ceil (x2) - path->extents.x;
+    path->extents.height = ceil (y2) - path->extents.y;
     path->is_stroke = is_stroke;
     path->fill_rule = cairo_get_fill_rule (cr);
     path->line_width = cairo_get_line_width (cr);
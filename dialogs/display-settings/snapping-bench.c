@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Drags an output over synthetic layouts of 2 to 32 outputs and times
+ * snap_context_snap(), which the dialog calls once per frame during a drag.
+ * The pointer mostly moves a few pixels per frame and now and then jumps,
+ * like a real drag. Run it with
+ *
+ *   meson test -C build --benchmark --verbose snapping
+ */
+
+#include "snapping.h"
+
+#include <stdlib.h>
+
+#define N_MOTIONS 20000
+
+/* outputs per row of the layout */
+#define ROW_LENGTH 8
+
+static const guint bench_n_outputs[] = { 2, 4, 8, 16, 32 };
+
+/* Rows of 1920x1080 and 2560x1440 outputs side by side, each row below the
+ * previous one, so that every output is aligned with another. */
+static GdkRectangle *
+bench_layout_new (guint n_outputs,
+                  GdkRectangle *bounds)
+{
+    GdkRectangle *rects = g_new0 (GdkRectangle, n_outputs);
+    int x = 0, y = 0, row_height = 0;
+
+    for (guint n = 0; n < n_outputs; n++)
+    {
+        if (n > 0 && n % ROW_LENGTH == 0)
+        {
+            y += row_height;
+            x = 0;
+            row_height = 0;
+        }
+
+        rects[n].x = x;
+        rects[n].y = y;
+        rects[n].width = n % 3 == 1 ? 2560 : 1920;
+        rects[n].height = n % 3 == 1 ? 1440 : 1080;
+
+        x += rects[n].width;
+        row_height = MAX (row_height, rects[n].height);
+        if (n == 0)
+            *bounds = rects[n];
+        else
+            gdk_rectangle_union (bounds, &rects[n], bounds);
+    }
+
+    return rects;
+}
+
+static gint
+compare_times (gconstpointer a,
+               gconstpointer b)
+{
+    gint64 t1 = *(const gint64 *) a;
+    gint64 t2 = *(const gint64 *) b;
+
+    return (t1 > t2) - (t1 < t2);
+}
+
+gint
+main (gint argc,
+      gchar **argv)
+{
+    for (guint i = 0; i < G_N_ELEMENTS (bench_n_outputs); i++)
+    {
+        guint n_outputs = bench_n_outputs[i];
+        GdkRectangle bounds = { 0 };
+        GdkRectangle *rects = bench_layout_new (n_outputs, &bounds);
+        gint64 *times = g_new (gint64, N_MOTIONS);
+        GRand *rand = g_rand_new_with_seed (n_outputs);
+        SnapContext *ctx;
+        gint64 start, setup_time, total = 0;
+        guint n_snapped = 0;
+        int x = bounds.x, y = bounds.y;
+
+        /* the first output is dragged, the others stay */
+        start = g_get_monotonic_time ();
+        ctx = snap_context_new (rects + 1, n_outputs - 1, rects[0].width, rects[0].height);
+        setup_time = g_get_monotonic_time () - start;
+
+        for (guint n = 0; n < N_MOTIONS; n++)
+        {
+            int snapped_x, snapped_y;
+
+            if (g_rand_int_range (rand, 0, 100) == 0)
+            {
+                x = g_rand_int_range (rand, bounds.x - rects[0].width, bounds.x + bounds.width);
+                y = g_rand_int_range (rand, bounds.y - rects[0].height, bounds.y + bounds.height);
+            }
+            else
+            {
+                x += g_rand_int_range (rand, -20, 21);
+                y += g_rand_int_range (rand, -20, 21);
+            }
+
+            start = g_get_monotonic_time ();
+            if (snap_context_snap (ctx, x, y, &snapped_x, &snapped_y))
+                n_snapped++;
+            times[n] = g_get_monotonic_time () - start;
+            total += times[n];
+        }
+
+        qsort (times, N_MOTIONS, sizeof (gint64), compare_times);
+        g_print ("snap %2u outputs  setup %6" G_GINT64_FORMAT " us  mean %8.2f us  p99 %6" G_GINT64_FORMAT
+                 " us  max %6" G_GINT64_FORMAT " us  %5.1f%% snapped\n",
+                 n_outputs, setup_time, (gdouble) total / N_MOTIONS, times[N_MOTIONS * 99 / 100],
+                 times[N_MOTIONS - 1], 100.0 * n_snapped / N_MOTIONS);
+
+        snap_context_free (ctx);
+        g_rand_free (rand);
+        g_free (times);
+        g_free (rects);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,583 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Snapping of a dragged output against the other outputs of the layout, in
+ * layout coordinates. Everything that does not depend on the pointer is
+ * built when the drag starts, so a motion only walks sorted lists.
+ */
+
+#include "snapping.h"
+
+typedef struct Edge
+{
+    int x1, y1;
+    int x2, y2;
+} Edge;
+
+/* A position the dragged output can snap to with one of its corners */
+typedef struct SnapTarget
+{
+    int x, y;
+    int distance;
+    gboolean corner; /* moves along both axes, wins ties */
+} SnapTarget;
+
+/* A row (or column) the dragged output can snap to with one of its edges,
+ * as long as the other coordinate stays within [start, end) */
+typedef struct SnapLine
+{
+    int position;
+    int start, end;
+} SnapLine;
+
+typedef struct SnapLineCursor
+{
+    GArray *lines;
+    int position;
+    int other;
+    guint below; /* lines[below - 1] is the next line before position */
+    guint above; /* lines[above] is the next line at or after it */
+} SnapLineCursor;
+
+static void
+add_edge (int x1,
+          int y1,
+          int x2,
+          int y2,
+          GArray *edges)
+{
+    Edge e;
+
+    e.x1 = x1;
+    e.x2 = x2;
+    e.y1 = y1;
+    e.y2 = y2;
+
+    g_array_append_val (edges, e);
+}
+
+static void
+list_edges_for_rect (const GdkRectangle *rect,
+                     GArray *edges)
+{
+    int x = rect->x;
+    int y = rect->y;
+    int w = rect->width;
+    int h = rect->height;
+
+    /* Top, Bottom, Left, Right */
+    add_edge (x, y, x + w, y, edges);
+    add_edge (x, y + h, x + w, y + h, edges);
+    add_edge (x, y, x, y + h, edges);
+    add_edge (x + w, y, x + w, y + h, edges);
+}
+
+static void
+add_snap_line (GArray *lines,
+               int position,
+               int start,
+               int end)
+{
+    SnapLine line = { position, start, end };
+
+    g_array_append_val (lines, line);
+}
+
+static int
+compare_snap_lines (gconstpointer v1,
+                    gconstpointer v2)
+{
+    const SnapLine *l1 = v1;
+    const SnapLine *l2 = v2;
+
+    return (l1->position > l2->position) - (l1->position < l2->position);
+}
+
+static int
+compare_snap_target_positions (gconstpointer v1,
+                               gconstpointer v2)
+{
+    const SnapTarget *t1 = v1;
+    const SnapTarget *t2 = v2;
+
+    if (t1->x != t2->x)
+        return (t1->x > t2->x) - (t1->x < t2->x);
+
+    return (t1->y > t2->y) - (t1->y < t2->y);
+}
+
+static int
+compare_snap_targets (gconstpointer v1,
+                      gconstpointer v2)
+{
+    const SnapTarget *t1 = v1;
+    const SnapTarget *t2 = v2;
+
+    /* This snapping algorithm is good enough for rock'n'roll, but
+     * this is probably a better:
+     *
+     *    First do a horizontal/vertical snap, then
+     *    with the new coordinates from that snap,
+     *    do a corner snap.
+     *
+     * Right now, it's confusing that corner snapping
+     * depends on the distance in an axis that you can't actually see.
+     *
+     */
+    if (t1->distance != t2->distance)
+        return (t1->distance > t2->distance) - (t1->distance < t2->distance);
+
+    return t2->corner - t1->corner;
+}
+
+static void
+snap_line_cursor_init (SnapLineCursor *cursor,
+                       GArray *lines,
+                       int position,
+                       int other)
+{
+    guint lo = 0, hi = lines->len;
+
+    while (lo < hi)
+    {
+        guint mid = lo + (hi - lo) / 2;
+
+        if (g_array_index (lines, SnapLine, mid).position < position)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    cursor->lines = lines;
+    cursor->position = position;
+    cursor->other = other;
+    cursor->below = lo;
+    cursor->above = lo;
+}
+
+static gboolean
+snap_line_contains (const SnapLine *line,
+                    int other)
+{
+    return other >= line->start && other < line->end;
+}
+
+/* Sets @line to the closest line not returned yet that can be snapped to,
+ * and returns its distance, or G_MAXINT if there is none left */
+static int
+snap_line_cursor_peek (SnapLineCursor *cursor,
+                       const SnapLine **line)
+{
+    GArray *lines = cursor->lines;
+    const SnapLine *below = NULL;
+    const SnapLine *above = NULL;
+
+    while (cursor->below > 0
+           && !snap_line_contains (&g_array_index (lines, SnapLine, cursor->below - 1), cursor->other))
+        cursor->below--;
+    while (cursor->above < lines->len
+           && !snap_line_contains (&g_array_index (lines, SnapLine, cursor->above), cursor->other))
+        cursor->above++;
+
+    if (cursor->below > 0)
+        below = &g_array_index (lines, SnapLine, cursor->below - 1);
+    if (cursor->above < lines->len)
+        above = &g_array_index (lines, SnapLine, cursor->above);
+
+    if (below != NULL
+        && (above == NULL || cursor->position - below->position <= above->position - cursor->position))
+    {
+        *line = below;
+        return cursor->position - below->position;
+    }
+
+    *line = above;
+
+    return above != NULL ? above->position - cursor->position : G_MAXINT;
+}
+
+static void
+snap_line_cursor_pop (SnapLineCursor *cursor,
+                      const SnapLine *line)
+{
+    if (cursor->below > 0 && line == &g_array_index (cursor->lines, SnapLine, cursor->below - 1))
+        cursor->below--;
+    else
+        cursor->above++;
+}
+
+static gboolean
+corner_on_edge (int x,
+                int y,
+                Edge *e)
+{
+    if (x == e->x1 && x == e->x2 && y >= e->y1 && y <= e->y2)
+        return TRUE;
+
+    if (y == e->y1 && y == e->y2 && x >= e->x1 && x <= e->x2)
+        return TRUE;
+
+    return FALSE;
+}
+
+static gboolean
+edges_align (Edge *e1,
+             Edge *e2)
+{
+    if (corner_on_edge (e1->x1, e1->y1, e2))
+        return TRUE;
+
+    if (corner_on_edge (e2->x1, e2->y1, e1))
+        return TRUE;
+
+    return FALSE;
+}
+
+/* What does not change while an output is dragged: the edges and rectangles
+ * of the other outputs, which of them are aligned with each other, and where
+ * the dragged output could snap to, so a motion only has to order the
+ * candidates by distance and check them against the dragged output. */
+struct _SnapContext
+{
+    int width, height;
+
+    /* four edges per other output, in the order of the rectangles */
+    GArray *edges;
+    GArray *rects;
+
+    /* other outputs that can only be aligned with the dragged one */
+    GArray *unaligned;
+
+    /* other outputs overlap each other, no position can fix that */
+    gboolean overlapping;
+
+    /* corner targets, kept sorted by distance between motions */
+    GArray *corners;
+    gboolean corners_sorted;
+
+    /* edge targets, sorted by position */
+    GArray *rows;
+    GArray *columns;
+
+    /* the current motion and how far its candidates were walked */
+    int x, y;
+    guint corner;
+    SnapLineCursor row_cursor;
+    SnapLineCursor column_cursor;
+};
+
+static void
+snap_context_add_targets (SnapContext *ctx,
+                          Edge *snappee)
+{
+    int w = ctx->width;
+    int h = ctx->height;
+    /* Top, Bottom, Left, Right of the dragged output at 0, 0 */
+    Edge snappers[4] = {
+        { 0, 0, w, 0 },
+        { 0, h, w, h },
+        { 0, 0, 0, h },
+        { w, 0, w, h },
+    };
+
+    for (guint i = 0; i < G_N_ELEMENTS (snappers); i++)
+    {
+        Edge *snapper = &snappers[i];
+        SnapTarget targets[4] = {
+            /* 1->1, 1->2, 2->2, 2->1 */
+            { snappee->x1 - snapper->x1, snappee->y1 - snapper->y1 },
+            { snappee->x2 - snapper->x1, snappee->y2 - snapper->y1 },
+            { snappee->x2 - snapper->x2, snappee->y2 - snapper->y2 },
+            { snappee->x1 - snapper->x2, snappee->y1 - snapper->y2 },
+        };
+
+        g_array_append_vals (ctx->corners, targets, G_N_ELEMENTS (targets));
+    }
+
+    /* the top and bottom edges snap to horizontal edges they overlap,
+     * the left and right edges to vertical ones */
+    if (snappee->y1 == snappee->y2)
+    {
+        add_snap_line (ctx->rows, snappee->y1, snappee->x1 - w, snappee->x2);
+        add_snap_line (ctx->rows, snappee->y1 - h, snappee->x1 - w, snappee->x2);
+    }
+    else if (snappee->x1 == snappee->x2)
+    {
+        add_snap_line (ctx->columns, snappee->x1, snappee->y1 - h, snappee->y2);
+        add_snap_line (ctx->columns, snappee->x1 - w, snappee->y1 - h, snappee->y2);
+    }
+}
+
+/**
+ * snap_context_new:
+ * @rects: the other outputs.
+ * @n_rects: the number of @rects.
+ * @width: the width of the dragged output.
+ * @height: the height of the dragged output.
+ *
+ * Prepare snapping an output of @width by @height against @rects, for the
+ * duration of a drag.
+ *
+ * Returns: a new context, free it with snap_context_free().
+ **/
+SnapContext *
+snap_context_new (const GdkRectangle *rects,
+                  guint n_rects,
+                  int width,
+                  int height)
+{
+    SnapContext *ctx = g_new0 (SnapContext, 1);
+    guint n = 0;
+
+    ctx->width = width;
+    ctx->height = height;
+    ctx->edges = g_array_new (FALSE, FALSE, sizeof (Edge));
+    ctx->rects = g_array_new (FALSE, FALSE, sizeof (GdkRectangle));
+    ctx->unaligned = g_array_new (FALSE, FALSE, sizeof (guint));
+    ctx->corners = g_array_new (FALSE, FALSE, sizeof (SnapTarget));
+    ctx->rows = g_array_new (FALSE, FALSE, sizeof (SnapLine));
+    ctx->columns = g_array_new (FALSE, FALSE, sizeof (SnapLine));
+
+    for (guint k = 0; k < n_rects; k++)
+    {
+        list_edges_for_rect (&rects[k], ctx->edges);
+        g_array_append_val (ctx->rects, rects[k]);
+    }
+
+    for (guint k = 0; k < ctx->rects->len; k++)
+    {
+        gboolean aligned = FALSE;
+
+        for (guint i = 4 * k; i < 4 * k + 4 && !aligned; i++)
+            for (guint j = 0; j < ctx->edges->len && !aligned; j++)
+                if (j / 4 != k)
+                    aligned = edges_align (&g_array_index (ctx->edges, Edge, i), &g_array_index (ctx->edges, Edge, j));
+        if (!aligned)
+            g_array_append_val (ctx->unaligned, k);
+
+        for (guint l = k + 1; l < ctx->rects->len; l++)
+            if (gdk_rectangle_intersect (&g_array_index (ctx->rects, GdkRectangle, k),
+                                         &g_array_index (ctx->rects, GdkRectangle, l), NULL))
+                ctx->overlapping = TRUE;
+    }
+
+    for (guint j = 0; j < ctx->edges->len; j++)
+        snap_context_add_targets (ctx, &g_array_index (ctx->edges, Edge, j));
+
+    /* outputs sharing a corner produce the same target several times */
+    g_array_sort (ctx->corners, compare_snap_target_positions);
+    for (guint i = 0; i < ctx->corners->len; i++)
+    {
+        SnapTarget *target = &g_array_index (ctx->corners, SnapTarget, i);
+
+        if (n > 0 && compare_snap_target_positions (&g_array_index (ctx->corners, SnapTarget, n - 1), target) == 0)
+            continue;
+        g_array_index (ctx->corners, SnapTarget, n++) = *target;
+    }
+    g_array_set_size (ctx->corners, n);
+
+    g_array_sort (ctx->rows, compare_snap_lines);
+    g_array_sort (ctx->columns, compare_snap_lines);
+
+    return ctx;
+}
+
+void
+snap_context_free (SnapContext *ctx)
+{
+    g_array_free (ctx->edges, TRUE);
+    g_array_free (ctx->rects, TRUE);
+    g_array_free (ctx->unaligned, TRUE);
+    g_array_free (ctx->corners, TRUE);
+    g_array_free (ctx->rows, TRUE);
+    g_array_free (ctx->columns, TRUE);
+    g_free (ctx);
+}
+
+static gboolean
+snap_context_edges_align (SnapContext *ctx,
+                          Edge *edges,
+                          guint first,
+                          guint last)
+{
+    for (guint i = 0; i < 4; i++)
+        for (guint j = first; j < last; j++)
+            if (edges_align (&edges[i], &g_array_index (ctx->edges, Edge, j)))
+                return TRUE;
+
+    return FALSE;
+}
+
+/* Whether the layout is aligned with the dragged output at x, y: every
+ * output has an edge aligned with another output and none overlap */
+static gboolean
+snap_context_is_aligned (SnapContext *ctx,
+                         int x,
+                         int y)
+{
+    GdkRectangle rect = { x, y, ctx->width, ctx->height };
+    Edge edges[4] = {
+        { x, y, x + ctx->width, y },
+        { x, y + ctx->height, x + ctx->width, y + ctx->height },
+        { x, y, x, y + ctx->height },
+        { x + ctx->width, y, x + ctx->width, y + ctx->height },
+    };
+
+    if (ctx->overlapping)
+        return FALSE;
+
+    for (guint k = 0; k < ctx->rects->len; k++)
+        if (gdk_rectangle_intersect (&rect, &g_array_index (ctx->rects, GdkRectangle, k), NULL))
+            return FALSE;
+
+    if (!snap_context_edges_align (ctx, edges, 0, ctx->edges->len))
+        return FALSE;
+
+    for (guint n = 0; n < ctx->unaligned->len; n++)
+    {
+        guint k = g_array_index (ctx->unaligned, guint, n);
+        if (!snap_context_edges_align (ctx, edges, 4 * k, 4 * k + 4))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Starts walking the snap candidates for the dragged output at x, y */
+static void
+snap_context_begin (SnapContext *ctx,
+                    int x,
+                    int y)
+{
+    SnapTarget *targets = (SnapTarget *) ctx->corners->data;
+
+    ctx->x = x;
+    ctx->y = y;
+    ctx->corner = 0;
+
+    for (guint i = 0; i < ctx->corners->len; i++)
+    {
+        targets[i].distance = MAX (ABS (targets[i].x - x), ABS (targets[i].y - y));
+        targets[i].corner = targets[i].x != x && targets[i].y != y;
+    }
+
+    /* a motion barely changes the order, so the insertion sort only moves
+     * a few targets instead of sorting them all again */
+    if (!ctx->corners_sorted)
+    {
+        g_array_sort (ctx->corners, compare_snap_targets);
+        ctx->corners_sorted = TRUE;
+    }
+    else
+    {
+        for (guint i = 1; i < ctx->corners->len; i++)
+        {
+            SnapTarget target = targets[i];
+            guint j = i;
+
+            for (; j > 0 && compare_snap_targets (&target, &targets[j - 1]) < 0; j--)
+                targets[j] = targets[j - 1];
+            targets[j] = target;
+        }
+    }
+
+    snap_line_cursor_init (&ctx->row_cursor, ctx->rows, y, x);
+    snap_line_cursor_init (&ctx->column_cursor, ctx->columns, x, y);
+}
+
+/* Returns the closest candidate not returned yet in @x, @y, the same order
+ * as sorting all of them by distance, corners first on ties */
+static gboolean
+snap_context_next (SnapContext *ctx,
+                   int *x,
+                   int *y)
+{
+    const SnapTarget *corner = NULL;
+    const SnapLine *row;
+    const SnapLine *column;
+    int row_distance, column_distance, line_distance;
+
+    /* corners further than 200 pixels on both axes are not snapped to */
+    for (; ctx->corner < ctx->corners->len; ctx->corner++)
+    {
+        corner = &g_array_index (ctx->corners, SnapTarget, ctx->corner);
+        if (ABS (corner->x - ctx->x) <= 200 || ABS (corner->y - ctx->y) <= 200)
+            break;
+        corner = NULL;
+    }
+
+    row_distance = snap_line_cursor_peek (&ctx->row_cursor, &row);
+    column_distance = snap_line_cursor_peek (&ctx->column_cursor, &column);
+    line_distance = MIN (row_distance, column_distance);
+
+    if (corner != NULL
+        && (corner->distance < line_distance || (corner->distance == line_distance && corner->corner)))
+    {
+        *x = corner->x;
+        *y = corner->y;
+        ctx->corner++;
+        return TRUE;
+    }
+
+    if (row != NULL && row_distance <= column_distance)
+    {
+        *x = ctx->x;
+        *y = row->position;
+        snap_line_cursor_pop (&ctx->row_cursor, row);
+        return TRUE;
+    }
+
+    if (column != NULL)
+    {
+        *x = column->position;
+        *y = ctx->y;
+        snap_line_cursor_pop (&ctx->column_cursor, column);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ * snap_context_snap:
+ * @ctx: a #SnapContext.
+ * @x: where the dragged output would go.
+ * @y: where the dragged output would go.
+ * @snapped_x: return location for the snapped position.
+ * @snapped_y: return location for the snapped position.
+ *
+ * Find the closest position to @x, @y where the dragged output is aligned
+ * with the others, preferring corners.
+ *
+ * Returns: %TRUE if there is one, %FALSE to leave the output where it was.
+ **/
+gboolean
+snap_context_snap (SnapContext *ctx,
+                   int x,
+                   int y,
+                   int *snapped_x,
+                   int *snapped_y)
+{
+    snap_context_begin (ctx, x, y);
+    while (snap_context_next (ctx, snapped_x, snapped_y))
+        if (snap_context_is_aligned (ctx, *snapped_x, *snapped_y))
+            return TRUE;
+
+    return FALSE;
+}
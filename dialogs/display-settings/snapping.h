@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __SNAPPING_H__
+#define __SNAPPING_H__
+
+#include <gdk/gdk.h>
+
+G_BEGIN_DECLS
+
+typedef struct _SnapContext SnapContext;
+
+SnapContext *
+snap_context_new (const GdkRectangle *rects,
+                  guint n_rects,
+                  int width,
+                  int height);
+void
+snap_context_free (SnapContext *ctx);
+
+gboolean
+snap_context_snap (SnapContext *ctx,
+                   int x,
+                   int y,
+                   int *snapped_x,
+                   int *snapped_y);
+
+G_END_DECLS
+
+#endif /* !__SNAPPING_H__ */
@@ -22,6 +22,7 @@
 
 #include "command-dialog.h"
 #include "xfce-keyboard-settings.h"
+#include "xkb-registry-cache.h"
 
 #include <libxfce4kbd-private/xfce-shortcut-dialog.h>
 #include <libxfce4kbd-private/xfce-shortcuts-provider.h>
@@ -29,7 +30,6 @@
 #include <libxfce4ui/libxfce4ui.h>
 #include <libxfce4util/libxfce4util.h>
 #include <xfconf/xfconf.h>
-#include <xkbcommon/xkbregistry.h>
 
 #ifdef ENABLE_X11
 #include <X11/XKBlib.h>
@@ -92,19 +92,6 @@ typedef enum
   MOVE_LAYOUT_DOWN
 } MOVE_LAYOUT_DIRECTION;
 
-typedef struct
-{
-  gchar *name;
-  gchar *description;
-  GList *variants; /* LayoutVariant */
-} Layout;
-
-typedef struct
-{
-  gchar *name;
-  gchar *description;
-} LayoutVariant;
-
 
 typedef struct _XfceKeyboardShortcutInfo XfceKeyboardShortcutInfo;
 
@@ -145,6 +132,16 @@ xfce_keyboard_settings_get_shortcut_info (XfceKeyboardSettings *settings,
 static void
 xfce_keyboard_settings_free_shortcut_info (XfceKeyboardShortcutInfo *info);
 static void
+xfce_keyboard_settings_build_shortcut_index (XfceKeyboardSettings *settings);
+static void
+xfce_keyboard_settings_index_shortcut_added (XfceShortcutsProvider *provider,
+                                             const gchar *shortcut,
+                                             XfceKeyboardSettings *settings);
+static void
+xfce_keyboard_settings_index_shortcut_removed (XfceShortcutsProvider *provider,
+                                               const gchar *shortcut,
+                                               XfceKeyboardSettings *settings);
+static void
 xfce_keyboard_settings_shortcut_added (XfceShortcutsProvider *provider,
                                        const gchar *shortcut,
                                        XfceKeyboardSettings *settings);
@@ -244,19 +241,12 @@ static void
 xfce_keyboard_settings_down_layout_button_cb (GtkWidget *widget,
                                               XfceKeyboardSettings *settings);
 static void
-xfce_keyboard_settings_build_layout_list (XfceKeyboardSettings *settings);
-static void
 xfce_keyboard_settings_populate_layouts_treeview (XfceKeyboardSettings *settings);
 static gchar **
 xfce_keyboard_settings_layout_selection (XfceKeyboardSettings *settings,
                                          const gchar *layout,
                                          const gchar *variant);
 
-static void
-layout_free (Layout *layout);
-static void
-layout_variant_free (LayoutVariant *variant);
-
 #ifdef ENABLE_X11
 static gchar **
 xfce_keyboard_settings_read_xkb_rules_names (GdkDisplay *display);
@@ -269,9 +259,12 @@ struct _XfceKeyboardSettingsPrivate
 {
   XfceShortcutsProvider *provider;
 
-  struct rxkb_context *xkb_registry;
-  GHashTable *layouts;
-  GList *layout_entries; /* Layout; owned by 'layouts' hashtable */
+  /* all shortcut providers and an index of their shortcuts, so
+   * validating a shortcut does not need any xfconf round-trip */
+  GList *providers;
+  GHashTable *shortcut_index; /* shortcut => GList of XfceKeyboardShortcutInfo */
+
+  XkbRegistryCache *xkb_registry;
 
   GtkTreeStore *layout_selection_treestore;
 
@@ -285,7 +278,7 @@ struct _XfceKeyboardSettingsPrivate
 struct _XfceKeyboardShortcutInfo
 {
   XfceShortcutsProvider *provider;
-  XfceShortcut *shortcut;
+  gchar *command;
 };
 
 
@@ -323,6 +316,8 @@ xfce_keyboard_settings_init (XfceKeyboardSettings *settings)
   g_signal_connect (settings->priv->provider, "shortcut-removed",
                     G_CALLBACK (xfce_keyboard_settings_shortcut_removed), settings);
 
+  xfce_keyboard_settings_build_shortcut_index (settings);
+
   if (gtk_builder_add_from_resource (GTK_BUILDER (settings), "/org/xfce/settings/keyboard-dialog.glade", &error) == 0)
     {
       g_critical ("Failed to load the UI file: %s.", error->message);
@@ -354,13 +349,12 @@ xfce_keyboard_settings_layouts_combo_populate (XfceKeyboardSettings *settings,
 
   if (combo_name == COMBO_MODELS)
     {
-      for (struct rxkb_model *model = rxkb_model_first (settings->priv->xkb_registry);
-           model != NULL;
-           model = rxkb_model_next (model))
+      guint n_models = xkb_registry_cache_get_n_models (settings->priv->xkb_registry);
+      for (guint n = 0; n < n_models; n++)
         {
-          xfce_keyboard_settings_layouts_combo_add (list_store,
-                                                    rxkb_model_get_name (model),
-                                                    rxkb_model_get_description (model));
+          const gchar *model_name, *model_description;
+          xkb_registry_cache_get_model (settings->priv->xkb_registry, n, &model_name, &model_description);
+          xfce_keyboard_settings_layouts_combo_add (list_store, model_name, model_description);
         }
     }
   else
@@ -373,24 +367,14 @@ xfce_keyboard_settings_layouts_combo_populate (XfceKeyboardSettings *settings,
       else
         g_assert_not_reached ();
 
-      struct rxkb_option_group *group = NULL;
-      for (group = rxkb_option_group_first (settings->priv->xkb_registry);
-           group != NULL;
-           group = rxkb_option_group_next (group))
-        {
-          if (g_strcmp0 (rxkb_option_group_get_name (group), name) == 0)
-            break;
-        }
-
-      if (group != NULL)
+      guint first_option, n_options;
+      if (xkb_registry_cache_get_option_group (settings->priv->xkb_registry, name, &first_option, &n_options))
         {
-          for (struct rxkb_option *option = rxkb_option_first (group);
-               option != NULL;
-               option = rxkb_option_next (option))
+          for (guint n = first_option; n < first_option + n_options; n++)
             {
-              xfce_keyboard_settings_layouts_combo_add (list_store,
-                                                        rxkb_option_get_name (option),
-                                                        rxkb_option_get_description (option));
+              const gchar *option_name, *option_description;
+              xkb_registry_cache_get_option (settings->priv->xkb_registry, n, &option_name, &option_description);
+              xfce_keyboard_settings_layouts_combo_add (list_store, option_name, option_description);
             }
         }
     }
@@ -439,9 +423,7 @@ xfce_keyboard_settings_constructed (GObject *object)
   gchar *cur_layouts = NULL;
   gchar *cur_variants = NULL;
 
-  settings->priv->xkb_registry = rxkb_context_new (RXKB_CONTEXT_NO_FLAGS);
-  rxkb_context_parse_default_ruleset (settings->priv->xkb_registry);
-  xfce_keyboard_settings_build_layout_list (settings);
+  settings->priv->xkb_registry = xkb_registry_cache_load ();
 
   /* XKB settings */
   xkb_key_repeat_check = gtk_builder_get_object (GTK_BUILDER (settings), "xkb_key_repeat_check");
@@ -626,13 +608,17 @@ static void
 xfce_keyboard_settings_finalize (GObject *object)
 {
   XfceKeyboardSettings *settings = XFCE_KEYBOARD_SETTINGS (object);
+  GList *lp;
 
   g_free (settings->priv->cur_kb_model);
-  g_list_free (settings->priv->layout_entries);
-  g_hash_table_destroy (settings->priv->layouts);
-  rxkb_context_unref (settings->priv->xkb_registry);
+  xkb_registry_cache_free (settings->priv->xkb_registry);
   g_object_unref (G_OBJECT (settings->priv->provider));
 
+  for (lp = settings->priv->providers; lp != NULL; lp = lp->next)
+    g_signal_handlers_disconnect_by_data (lp->data, settings);
+  g_hash_table_destroy (settings->priv->shortcut_index);
+  xfce_shortcuts_provider_free_providers (settings->priv->providers);
+
   (*G_OBJECT_CLASS (xfce_keyboard_settings_parent_class)->finalize) (object);
 }
 
@@ -947,7 +933,7 @@ xfce_keyboard_settings_validate_shortcut (XfceShortcutDialog *dialog,
                                                 xfce_shortcuts_provider_get_name (info->provider),
                                                 shortcut,
                                                 xfce_shortcut_dialog_get_action_name (dialog),
-                                                info->shortcut->command,
+                                                info->command,
                                                 FALSE);
 
       if (G_UNLIKELY (response == GTK_RESPONSE_ACCEPT))
@@ -965,7 +951,7 @@ xfce_keyboard_settings_validate_shortcut (XfceShortcutDialog *dialog,
       else
         {
           /* We want to keep the old owner */
-          DBG ("We want to keep using %s with %s", shortcut, info->shortcut->command);
+          DBG ("We want to keep using %s with %s", shortcut, info->command);
           accepted = FALSE;
         }
 
@@ -981,49 +967,190 @@ static XfceKeyboardShortcutInfo *
 xfce_keyboard_settings_get_shortcut_info (XfceKeyboardSettings *settings,
                                           const gchar *shortcut)
 {
-  XfceKeyboardShortcutInfo *info = NULL;
-  GList *iter;
-  XfceShortcut *sc;
-  GList *providers;
+  XfceKeyboardShortcutInfo *info;
+  XfceKeyboardShortcutInfo *owner;
+  GList *owners;
 
   g_return_val_if_fail (XFCE_IS_KEYBOARD_SETTINGS (settings), FALSE);
   g_return_val_if_fail (shortcut != NULL, FALSE);
 
   DBG ("Looking for shortcut info for %s", shortcut);
 
-  providers = xfce_shortcuts_provider_get_providers ();
+  owners = g_hash_table_lookup (settings->priv->shortcut_index, shortcut);
 
-  if (G_UNLIKELY (providers == NULL))
+  if (G_LIKELY (owners == NULL))
     return NULL;
 
-  for (iter = providers; iter != NULL && info == NULL; iter = g_list_next (iter))
+  /* The first owner in provider order wins, like before the index existed */
+  owner = owners->data;
+
+  info = g_new0 (XfceKeyboardShortcutInfo, 1);
+  info->provider = g_object_ref (owner->provider);
+  info->command = g_strdup (owner->command);
+
+  return info;
+}
+
+
+
+static void
+xfce_keyboard_settings_free_shortcut_info (XfceKeyboardShortcutInfo *info)
+{
+  g_object_unref (info->provider);
+  g_free (info->command);
+  g_free (info);
+}
+
+
+
+static void
+xfce_keyboard_settings_free_shortcut_owners (gpointer data)
+{
+  g_list_free_full (data, (GDestroyNotify) xfce_keyboard_settings_free_shortcut_info);
+}
+
+
+
+static gint
+xfce_keyboard_settings_compare_shortcut_owners (gconstpointer a,
+                                                gconstpointer b,
+                                                gpointer user_data)
+{
+  const XfceKeyboardShortcutInfo *info_a = a;
+  const XfceKeyboardShortcutInfo *info_b = b;
+  GList *providers = user_data;
+
+  return g_list_index (providers, info_a->provider) - g_list_index (providers, info_b->provider);
+}
+
+
+
+static void
+xfce_keyboard_settings_index_remove (XfceKeyboardSettings *settings,
+                                     XfceShortcutsProvider *provider,
+                                     const gchar *shortcut)
+{
+  gchar *key;
+  GList *owners;
+  GList *lp;
+
+  if (!g_hash_table_steal_extended (settings->priv->shortcut_index, shortcut,
+                                    (gpointer *) &key, (gpointer *) &owners))
+    return;
+
+  for (lp = owners; lp != NULL; lp = lp->next)
     {
-      if (G_UNLIKELY (xfce_shortcuts_provider_has_shortcut (iter->data, shortcut)))
+      if (((XfceKeyboardShortcutInfo *) lp->data)->provider == provider)
         {
-          sc = xfce_shortcuts_provider_get_shortcut (iter->data, shortcut);
+          xfce_keyboard_settings_free_shortcut_info (lp->data);
+          owners = g_list_delete_link (owners, lp);
+          break;
+        }
+    }
 
-          if (G_LIKELY (sc != NULL))
-            {
-              info = g_new0 (XfceKeyboardShortcutInfo, 1);
-              info->provider = g_object_ref (iter->data);
-              info->shortcut = sc;
-            }
+  if (owners != NULL)
+    g_hash_table_insert (settings->priv->shortcut_index, key, owners);
+  else
+    g_free (key);
+}
+
+
+
+static void
+xfce_keyboard_settings_index_add (XfceKeyboardSettings *settings,
+                                  XfceShortcutsProvider *provider,
+                                  const gchar *shortcut,
+                                  const gchar *command)
+{
+  XfceKeyboardShortcutInfo *info;
+  gchar *key;
+  GList *owners;
+
+  /* Replace the previous entry of this provider, if any */
+  xfce_keyboard_settings_index_remove (settings, provider, shortcut);
+
+  info = g_new0 (XfceKeyboardShortcutInfo, 1);
+  info->provider = g_object_ref (provider);
+  info->command = g_strdup (command);
+
+  if (!g_hash_table_steal_extended (settings->priv->shortcut_index, shortcut,
+                                    (gpointer *) &key, (gpointer *) &owners))
+    {
+      key = g_strdup (shortcut);
+      owners = NULL;
+    }
+
+  owners = g_list_insert_sorted_with_data (owners, info,
+                                           xfce_keyboard_settings_compare_shortcut_owners,
+                                           settings->priv->providers);
+  g_hash_table_insert (settings->priv->shortcut_index, key, owners);
+}
+
+
+
+static void
+xfce_keyboard_settings_build_shortcut_index (XfceKeyboardSettings *settings)
+{
+  XfceShortcut *sc;
+  GList *shortcuts;
+  GList *lp, *li;
+
+  settings->priv->shortcut_index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                                          xfce_keyboard_settings_free_shortcut_owners);
+  settings->priv->providers = xfce_shortcuts_provider_get_providers ();
+
+  for (lp = settings->priv->providers; lp != NULL; lp = lp->next)
+    {
+      shortcuts = xfce_shortcuts_provider_get_shortcuts (lp->data);
+      for (li = shortcuts; li != NULL; li = li->next)
+        {
+          sc = li->data;
+          if (G_LIKELY (sc->shortcut != NULL))
+            xfce_keyboard_settings_index_add (settings, lp->data, sc->shortcut, sc->command);
         }
+      xfce_shortcuts_free (shortcuts);
+
+      /* Keep the index up to date */
+      g_signal_connect (lp->data, "shortcut-added",
+                        G_CALLBACK (xfce_keyboard_settings_index_shortcut_added), settings);
+      g_signal_connect (lp->data, "shortcut-removed",
+                        G_CALLBACK (xfce_keyboard_settings_index_shortcut_removed), settings);
     }
 
-  xfce_shortcuts_provider_free_providers (providers);
+  DBG ("Indexed %u shortcuts from %u providers",
+       g_hash_table_size (settings->priv->shortcut_index),
+       g_list_length (settings->priv->providers));
+}
 
-  return info;
+
+
+static void
+xfce_keyboard_settings_index_shortcut_added (XfceShortcutsProvider *provider,
+                                             const gchar *shortcut,
+                                             XfceKeyboardSettings *settings)
+{
+  XfceShortcut *sc;
+
+  g_return_if_fail (XFCE_IS_KEYBOARD_SETTINGS (settings));
+
+  sc = xfce_shortcuts_provider_get_shortcut (provider, shortcut);
+  if (G_LIKELY (sc != NULL))
+    {
+      xfce_keyboard_settings_index_add (settings, provider, shortcut, sc->command);
+      xfce_shortcut_free (sc);
+    }
 }
 
 
 
 static void
-xfce_keyboard_settings_free_shortcut_info (XfceKeyboardShortcutInfo *info)
+xfce_keyboard_settings_index_shortcut_removed (XfceShortcutsProvider *provider,
+                                               const gchar *shortcut,
+                                               XfceKeyboardSettings *settings)
 {
-  g_object_unref (info->provider);
-  xfce_shortcut_free (info->shortcut);
-  g_free (info);
+  g_return_if_fail (XFCE_IS_KEYBOARD_SETTINGS (settings));
+
+  xfce_keyboard_settings_index_remove (settings, provider, shortcut);
 }
 
 
@@ -1574,17 +1701,21 @@ xfce_keyboard_settings_init_layout (XfceKeyboardSettings *settings,
       const gchar *layout_desc = NULL;
       const gchar *variant_desc = NULL;
 
-      Layout *layout = g_hash_table_lookup (settings->priv->layouts, *layout_id);
-      if (layout != NULL)
+      gint layout = xkb_registry_cache_find_layout (settings->priv->xkb_registry, *layout_id);
+      if (layout != -1)
         {
-          layout_desc = layout->description;
+          guint first_variant, n_variants;
+
+          xkb_registry_cache_get_layout (settings->priv->xkb_registry, layout, NULL, &layout_desc,
+                                         &first_variant, &n_variants);
 
-          for (GList *vp = layout->variants; vp != NULL; vp = vp->next)
+          for (guint n = first_variant; n < first_variant + n_variants; n++)
             {
-              LayoutVariant *variant = vp->data;
-              if (g_strcmp0 (*variant_id, variant->name) == 0)
+              const gchar *name, *description;
+              xkb_registry_cache_get_variant (settings->priv->xkb_registry, n, &name, &description);
+              if (g_strcmp0 (*variant_id, name) == 0)
                 {
-                  variant_desc = variant->description;
+                  variant_desc = description;
                   break;
                 }
             }
@@ -1978,38 +2109,102 @@ xfce_keyboard_settings_populate_layouts_treeview (XfceKeyboardSettings *settings
 {
   GObject *treeview = gtk_builder_get_object (GTK_BUILDER (settings), "layout_selection_view");
   GtkTreeStore *treestore = GTK_TREE_STORE (gtk_tree_view_get_model (GTK_TREE_VIEW (treeview)));
+  guint n_layouts = xkb_registry_cache_get_n_layouts (settings->priv->xkb_registry);
 
-  for (GList *lp = settings->priv->layout_entries; lp != NULL; lp = lp->next)
+  for (guint n = 0; n < n_layouts; n++)
     {
-      Layout *layout = lp->data;
+      const gchar *name, *description;
+      guint first_variant, n_variants;
       GtkTreeIter root_iter;
+      GtkTreeIter iter;
+
+      xkb_registry_cache_get_layout (settings->priv->xkb_registry, n, &name, &description,
+                                     &first_variant, &n_variants);
 
       gtk_tree_store_append (treestore, &root_iter, NULL);
       gtk_tree_store_set (treestore, &root_iter,
-                          XKB_AVAIL_LAYOUTS_TREE_DESCRIPTION, layout->description,
-                          XKB_AVAIL_LAYOUTS_TREE_ID, layout->name,
+                          XKB_AVAIL_LAYOUTS_TREE_DESCRIPTION, description,
+                          XKB_AVAIL_LAYOUTS_TREE_ID, name,
                           -1);
 
-      for (GList *vp = layout->variants; vp != NULL; vp = vp->next)
+      /* Variants are added when the row is expanded, until then a
+       * placeholder without an id makes the row expandable */
+      if (n_variants > 0)
+        gtk_tree_store_append (treestore, &iter, &root_iter);
+    }
+}
+
+
+
+static void
+xfce_keyboard_settings_layouts_treeview_fill_variants (XfceKeyboardSettings *settings,
+                                                       GtkTreeStore *treestore,
+                                                       GtkTreeIter *root_iter)
+{
+  GtkTreeModel *model = GTK_TREE_MODEL (treestore);
+  GtkTreeIter iter;
+  gchar *layout_name;
+  gchar *id;
+  gint layout;
+  guint first_variant, n_variants;
+
+  if (!gtk_tree_model_iter_children (model, &iter, root_iter))
+    return;
+
+  gtk_tree_model_get (model, &iter, XKB_AVAIL_LAYOUTS_TREE_ID, &id, -1);
+  if (id != NULL)
+    {
+      /* Already filled */
+      g_free (id);
+      return;
+    }
+
+  gtk_tree_store_remove (treestore, &iter);
+
+  gtk_tree_model_get (model, root_iter, XKB_AVAIL_LAYOUTS_TREE_ID, &layout_name, -1);
+  layout = xkb_registry_cache_find_layout (settings->priv->xkb_registry, layout_name);
+
+  if (layout != -1)
+    {
+      xkb_registry_cache_get_layout (settings->priv->xkb_registry, layout, NULL, NULL,
+                                     &first_variant, &n_variants);
+
+      for (guint n = first_variant; n < first_variant + n_variants; n++)
         {
-          LayoutVariant *variant = vp->data;
-          GtkTreeIter iter;
-          gchar *description;
+          const gchar *name, *description;
+          gchar *fallback = NULL;
 
-          if (variant->description == NULL)
-            description = g_strdup_printf ("%s (%s)", layout->name, variant->name);
-          else
-            description = NULL;
+          xkb_registry_cache_get_variant (settings->priv->xkb_registry, n, &name, &description);
+          if (description == NULL)
+            description = fallback = g_strdup_printf ("%s (%s)", layout_name, name);
 
-          gtk_tree_store_append (treestore, &iter, &root_iter);
+          gtk_tree_store_append (treestore, &iter, root_iter);
           gtk_tree_store_set (treestore, &iter,
-                              XKB_AVAIL_LAYOUTS_TREE_DESCRIPTION, variant->description != NULL ? variant->description : description,
-                              XKB_AVAIL_LAYOUTS_TREE_ID, variant->name,
+                              XKB_AVAIL_LAYOUTS_TREE_DESCRIPTION, description,
+                              XKB_AVAIL_LAYOUTS_TREE_ID, name,
                               -1);
 
-          g_free (description);
+          g_free (fallback);
         }
     }
+
+  g_free (layout_name);
+}
+
+
+
+static gboolean
+xfce_keyboard_settings_layouts_treeview_test_expand_cb (GtkTreeView *tree_view,
+                                                        GtkTreeIter *iter,
+                                                        GtkTreePath *path,
+                                                        XfceKeyboardSettings *settings)
+{
+  xfce_keyboard_settings_layouts_treeview_fill_variants (settings,
+                                                         GTK_TREE_STORE (gtk_tree_view_get_model (tree_view)),
+                                                         iter);
+
+  /* Allow the row to expand */
+  return FALSE;
 }
 
 
@@ -2061,6 +2256,8 @@ xfce_keyboard_settings_layout_selection (XfceKeyboardSettings *settings,
       xfce_keyboard_settings_populate_layouts_treeview (settings);
       g_signal_connect (GTK_TREE_VIEW (layout_selection_view), "row-activated",
                         G_CALLBACK (xfce_keyboard_settings_layout_activate_cb), keyboard_layout_selection_dialog);
+      g_signal_connect (GTK_TREE_VIEW (layout_selection_view), "test-expand-row",
+                        G_CALLBACK (xfce_keyboard_settings_layouts_treeview_test_expand_cb), settings);
       gtk_dialog_set_default_response (GTK_DIALOG (keyboard_layout_selection_dialog), GTK_RESPONSE_OK);
     }
 
@@ -2092,6 +2289,9 @@ xfce_keyboard_settings_layout_selection (XfceKeyboardSettings *settings,
                       GtkTreeIter iter2;
                       gint n, i;
 
+                      xfce_keyboard_settings_layouts_treeview_fill_variants (settings,
+                                                                             settings->priv->layout_selection_treestore,
+                                                                             &iter);
                       n = gtk_tree_model_iter_n_children (model, &iter);
 
                       for (i = 0; i < n; i++)
@@ -2220,97 +2420,6 @@ xfce_keyboard_settings_layout_selection (XfceKeyboardSettings *settings,
 
 
 
-static gint
-layout_cmp (gconstpointer a,
-            gconstpointer b)
-{
-  const Layout *la = a;
-  const Layout *lb = b;
-  return g_utf8_collate (la->description, lb->description);
-}
-
-
-
-static void
-layout_free (Layout *layout)
-{
-  if (layout != NULL)
-    {
-      g_free (layout->name);
-      g_free (layout->description);
-      g_list_free_full (layout->variants, (GDestroyNotify) layout_variant_free);
-      g_free (layout);
-    }
-}
-
-
-
-static gint
-layout_variant_cmp (gconstpointer a,
-                    gconstpointer b)
-{
-  const LayoutVariant *va = a;
-  const LayoutVariant *vb = b;
-  return g_utf8_collate (va->description, vb->description);
-}
-
-
-
-static void
-layout_variant_free (LayoutVariant *variant)
-{
-  if (variant != NULL)
-    {
-      g_free (variant->name);
-      g_free (variant->description);
-      g_free (variant);
-    }
-}
-
-
-static void
-xfce_keyboard_settings_build_layout_list (XfceKeyboardSettings *settings)
-{
-  GHashTable *layouts = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) layout_free);
-
-  for (struct rxkb_layout *layout = rxkb_layout_first (settings->priv->xkb_registry);
-       layout != NULL;
-       layout = rxkb_layout_next (layout))
-    {
-      const char *layout_name = rxkb_layout_get_name (layout);
-      const char *variant_name = rxkb_layout_get_variant (layout);
-      const char *raw_description = rxkb_layout_get_description (layout);
-      gchar *description = raw_description != NULL ? g_utf8_make_valid (raw_description, -1) : NULL;
-
-      Layout *entry = g_hash_table_lookup (layouts, layout_name);
-      if (entry == NULL)
-        {
-          entry = g_new0 (Layout, 1);
-          entry->name = g_strdup (layout_name);
-          g_hash_table_insert (layouts, g_strdup (layout_name), entry);
-        }
-
-      if (xfce_str_is_empty (variant_name))
-        {
-          g_free (entry->description);
-          entry->description = description;
-        }
-      else
-        {
-          LayoutVariant *variant = g_new0 (LayoutVariant, 1);
-          variant->name = g_strdup (variant_name);
-          variant->description = description;
-          entry->variants = g_list_insert_sorted (entry->variants, variant, layout_variant_cmp);
-        }
-    }
-
-  GList *entries = g_hash_table_get_values (layouts);
-  settings->priv->layout_entries = g_list_sort (entries, layout_cmp);
-  settings->priv->layouts = layouts;
-}
-
-
-
 #ifdef ENABLE_X11
 
 static gchar **
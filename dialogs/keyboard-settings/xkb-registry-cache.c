@@ -0,0 +1,743 @@
+/* vi:set sw=2 sts=2 ts=2 et ai: */
+/*-
+ * Copyright (c) 2026 The Xfce Development Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Parsing the XKB rules registry means reading several hundred KB of XML,
+ * so the parts the keyboard dialog needs are stored in a compact binary
+ * file in the user's cache directory. The file is memory-mapped and all
+ * strings are handed out as pointers into the mapping.
+ *
+ * The cache is keyed by the locale, which decides both the translations and
+ * the sort order, and the path, mtime and size of every rules file
+ * libxkbregistry might read, and rebuilt when any of them changes. All
+ * numbers are stored in host byte order.
+ */
+
+#include "xkb-registry-cache.h"
+
+#include <errno.h>
+#include <glib/gstdio.h>
+#include <libxfce4util/libxfce4util.h>
+#include <locale.h>
+#include <string.h>
+#include <xkbcommon/xkbcommon.h>
+#include <xkbcommon/xkbregistry.h>
+
+
+
+#define CACHE_MAGIC "XFKBREG\0"
+#define CACHE_VERSION 1
+#define CACHE_FILENAME "xfce4" G_DIR_SEPARATOR_S "keyboard-settings" G_DIR_SEPARATOR_S "xkb-registry.cache"
+
+
+
+typedef struct
+{
+  gchar magic[8];
+  guint32 version;
+  guint32 key;
+
+  guint32 n_models;
+  guint32 models;
+  guint32 n_groups;
+  guint32 groups;
+  guint32 n_options;
+  guint32 options;
+  guint32 n_layouts;
+  guint32 layouts;
+  guint32 layouts_by_name;
+  guint32 n_variants;
+  guint32 variants;
+
+  guint32 strings;
+  guint32 strings_size;
+} CacheHeader;
+
+typedef struct
+{
+  guint32 name;
+  guint32 description;
+} CacheItem;
+
+typedef struct
+{
+  guint32 name;
+  guint32 first_option;
+  guint32 n_options;
+} CacheGroup;
+
+typedef struct
+{
+  guint32 name;
+  guint32 description;
+  guint32 first_variant;
+  guint32 n_variants;
+} CacheLayout;
+
+struct _XkbRegistryCache
+{
+  GBytes *bytes;
+
+  const CacheHeader *header;
+  const CacheItem *models;
+  const CacheGroup *groups;
+  const CacheItem *options;
+  const CacheLayout *layouts;
+  const guint32 *layouts_by_name;
+  const CacheItem *variants;
+  const gchar *strings;
+};
+
+/* temporary structures used while building the cache */
+typedef struct
+{
+  gchar *name;
+  gchar *description;
+  GPtrArray *variants;
+} BuildLayout;
+
+typedef struct
+{
+  gchar *name;
+  gchar *description;
+} BuildItem;
+
+
+
+static const gchar *
+cache_string (XkbRegistryCache *cache,
+              guint32 offset)
+{
+  if (offset == 0 || offset >= cache->header->strings_size)
+    return NULL;
+
+  return cache->strings + offset;
+}
+
+
+
+static gchar *
+xkb_registry_cache_build_key (void)
+{
+  struct xkb_context *context;
+  const gchar *ruleset;
+  const gchar *value;
+  GString *key;
+  GStatBuf st;
+  gchar *path;
+  guint i, j;
+  const gchar *suffixes[] = { ".xml", ".extras.xml" };
+
+  ruleset = g_getenv ("XKB_DEFAULT_RULES");
+  if (xfce_str_is_empty (ruleset))
+    ruleset = "evdev";
+
+  key = g_string_new (NULL);
+  value = setlocale (LC_MESSAGES, NULL);
+  g_string_append_printf (key, "%s\n", value != NULL ? value : "C");
+  value = setlocale (LC_COLLATE, NULL);
+  g_string_append_printf (key, "%s\n%s\n", value != NULL ? value : "C", ruleset);
+
+  /* libxkbregistry shares its default include paths with libxkbcommon:
+   * the user overrides, XKB_CONFIG_EXTRA_PATH and the configured or
+   * XKB_CONFIG_ROOT rules root, so look at the same directories */
+  context = xkb_context_new (XKB_CONTEXT_NO_FLAGS);
+  for (i = 0; context != NULL && i < xkb_context_num_include_paths (context); i++)
+    {
+      for (j = 0; j < G_N_ELEMENTS (suffixes); j++)
+        {
+          gchar *filename = g_strconcat (ruleset, suffixes[j], NULL);
+          path = g_build_filename (xkb_context_include_path_get (context, i), "rules", filename, NULL);
+          if (g_stat (path, &st) == 0)
+            g_string_append_printf (key, "%s:%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT "\n",
+                                    path, (gint64) st.st_mtime, (gint64) st.st_size);
+          g_free (filename);
+          g_free (path);
+        }
+    }
+
+  if (context != NULL)
+    xkb_context_unref (context);
+
+  return g_string_free (key, FALSE);
+}
+
+
+
+static gboolean
+xkb_registry_cache_check_array (gsize size,
+                                guint32 offset,
+                                guint32 n_items,
+                                gsize item_size)
+{
+  return offset % 4 == 0 && offset <= size && (size - offset) / item_size >= n_items;
+}
+
+
+
+static XkbRegistryCache *
+xkb_registry_cache_new_from_bytes (GBytes *bytes,
+                                   const gchar *key)
+{
+  XkbRegistryCache *cache;
+  const CacheHeader *header;
+  const guint8 *data;
+  gsize size;
+
+  data = g_bytes_get_data (bytes, &size);
+  if (size < sizeof (CacheHeader))
+    return NULL;
+
+  header = (const CacheHeader *) data;
+  if (memcmp (header->magic, CACHE_MAGIC, sizeof (header->magic)) != 0
+      || header->version != CACHE_VERSION)
+    return NULL;
+
+  /* make sure the file is consistent: every string offset is checked
+   * against the string table, which must be NUL-terminated */
+  if (!xkb_registry_cache_check_array (size, header->strings, header->strings_size, 1)
+      || header->strings_size == 0
+      || data[header->strings + header->strings_size - 1] != '\0'
+      || header->key >= header->strings_size
+      || !xkb_registry_cache_check_array (size, header->models, header->n_models, sizeof (CacheItem))
+      || !xkb_registry_cache_check_array (size, header->groups, header->n_groups, sizeof (CacheGroup))
+      || !xkb_registry_cache_check_array (size, header->options, header->n_options, sizeof (CacheItem))
+      || !xkb_registry_cache_check_array (size, header->layouts, header->n_layouts, sizeof (CacheLayout))
+      || !xkb_registry_cache_check_array (size, header->layouts_by_name, header->n_layouts, sizeof (guint32))
+      || !xkb_registry_cache_check_array (size, header->variants, header->n_variants, sizeof (CacheItem)))
+    return NULL;
+
+  if (g_strcmp0 ((const gchar *) data + header->strings + header->key, key) != 0)
+    return NULL;
+
+  cache = g_new0 (XkbRegistryCache, 1);
+  cache->bytes = g_bytes_ref (bytes);
+  cache->header = header;
+  cache->models = (const CacheItem *) (data + header->models);
+  cache->groups = (const CacheGroup *) (data + header->groups);
+  cache->options = (const CacheItem *) (data + header->options);
+  cache->layouts = (const CacheLayout *) (data + header->layouts);
+  cache->layouts_by_name = (const guint32 *) (data + header->layouts_by_name);
+  cache->variants = (const CacheItem *) (data + header->variants);
+  cache->strings = (const gchar *) (data + header->strings);
+
+  return cache;
+}
+
+
+
+static guint32
+xkb_registry_cache_add_string (GByteArray *strings,
+                               GHashTable *offsets,
+                               const gchar *string)
+{
+  gpointer offset;
+
+  if (string == NULL)
+    return 0;
+
+  if (g_hash_table_lookup_extended (offsets, string, NULL, &offset))
+    return GPOINTER_TO_UINT (offset);
+
+  offset = GUINT_TO_POINTER (strings->len);
+  g_byte_array_append (strings, (const guint8 *) string, strlen (string) + 1);
+  g_hash_table_insert (offsets, g_strdup (string), offset);
+
+  return GPOINTER_TO_UINT (offset);
+}
+
+
+
+static gint
+build_description_cmp (gconstpointer a,
+                       gconstpointer b)
+{
+  const BuildItem *ia = *(BuildItem *const *) a;
+  const BuildItem *ib = *(BuildItem *const *) b;
+
+  /* BuildLayout starts with the same members as BuildItem */
+  return g_utf8_collate (ia->description != NULL ? ia->description : "",
+                         ib->description != NULL ? ib->description : "");
+}
+
+
+
+static gint
+build_layout_name_cmp (gconstpointer a,
+                       gconstpointer b,
+                       gpointer user_data)
+{
+  GPtrArray *layouts = user_data;
+  const BuildLayout *la = g_ptr_array_index (layouts, *(const guint32 *) a);
+  const BuildLayout *lb = g_ptr_array_index (layouts, *(const guint32 *) b);
+
+  return strcmp (la->name, lb->name);
+}
+
+
+
+static void
+build_item_free (gpointer data)
+{
+  BuildItem *item = data;
+
+  g_free (item->name);
+  g_free (item->description);
+  g_free (item);
+}
+
+
+
+static void
+build_layout_free (gpointer data)
+{
+  BuildLayout *layout = data;
+
+  g_free (layout->name);
+  g_free (layout->description);
+  g_ptr_array_free (layout->variants, TRUE);
+  g_free (layout);
+}
+
+
+
+static GBytes *
+xkb_registry_cache_build (const gchar *key)
+{
+  struct rxkb_context *context;
+  CacheHeader header;
+  GByteArray *data;
+  GByteArray *strings;
+  GHashTable *offsets;
+  GHashTable *layouts_table;
+  GPtrArray *layouts;
+  GArray *models;
+  GArray *groups;
+  GArray *options;
+  GArray *variants;
+  GArray *layout_items;
+  GArray *by_name;
+  guint i, j;
+
+  context = rxkb_context_new (RXKB_CONTEXT_NO_FLAGS);
+  if (context == NULL)
+    return NULL;
+
+  if (!rxkb_context_parse_default_ruleset (context))
+    {
+      rxkb_context_unref (context);
+      return NULL;
+    }
+
+  strings = g_byte_array_new ();
+  g_byte_array_append (strings, (const guint8 *) "", 1); /* offset 0 is NULL */
+  offsets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  models = g_array_new (FALSE, FALSE, sizeof (CacheItem));
+  for (struct rxkb_model *model = rxkb_model_first (context);
+       model != NULL;
+       model = rxkb_model_next (model))
+    {
+      CacheItem item;
+      item.name = xkb_registry_cache_add_string (strings, offsets, rxkb_model_get_name (model));
+      item.description = xkb_registry_cache_add_string (strings, offsets, rxkb_model_get_description (model));
+      g_array_append_val (models, item);
+    }
+
+  groups = g_array_new (FALSE, FALSE, sizeof (CacheGroup));
+  options = g_array_new (FALSE, FALSE, sizeof (CacheItem));
+  for (struct rxkb_option_group *group = rxkb_option_group_first (context);
+       group != NULL;
+       group = rxkb_option_group_next (group))
+    {
+      CacheGroup cache_group;
+      cache_group.name = xkb_registry_cache_add_string (strings, offsets, rxkb_option_group_get_name (group));
+      cache_group.first_option = options->len;
+
+      for (struct rxkb_option *option = rxkb_option_first (group);
+           option != NULL;
+           option = rxkb_option_next (option))
+        {
+          CacheItem item;
+          item.name = xkb_registry_cache_add_string (strings, offsets, rxkb_option_get_name (option));
+          item.description = xkb_registry_cache_add_string (strings, offsets, rxkb_option_get_description (option));
+          g_array_append_val (options, item);
+        }
+
+      cache_group.n_options = options->len - cache_group.first_option;
+      g_array_append_val (groups, cache_group);
+    }
+
+  /* group the variants under their layout */
+  layouts = g_ptr_array_new_with_free_func (build_layout_free);
+  layouts_table = g_hash_table_new (g_str_hash, g_str_equal);
+  for (struct rxkb_layout *layout = rxkb_layout_first (context);
+       layout != NULL;
+       layout = rxkb_layout_next (layout))
+    {
+      const char *layout_name = rxkb_layout_get_name (layout);
+      const char *variant_name = rxkb_layout_get_variant (layout);
+      const char *raw_description = rxkb_layout_get_description (layout);
+      gchar *description = raw_description != NULL ? g_utf8_make_valid (raw_description, -1) : NULL;
+      BuildLayout *entry;
+
+      entry = g_hash_table_lookup (layouts_table, layout_name);
+      if (entry == NULL)
+        {
+          entry = g_new0 (BuildLayout, 1);
+          entry->name = g_strdup (layout_name);
+          entry->variants = g_ptr_array_new_with_free_func (build_item_free);
+          g_ptr_array_add (layouts, entry);
+          g_hash_table_insert (layouts_table, entry->name, entry);
+        }
+
+      if (xfce_str_is_empty (variant_name))
+        {
+          g_free (entry->description);
+          entry->description = description;
+        }
+      else
+        {
+          BuildItem *variant = g_new0 (BuildItem, 1);
+          variant->name = g_strdup (variant_name);
+          variant->description = description;
+          g_ptr_array_add (entry->variants, variant);
+        }
+    }
+  g_hash_table_destroy (layouts_table);
+  rxkb_context_unref (context);
+
+  g_ptr_array_sort (layouts, build_description_cmp);
+
+  layout_items = g_array_new (FALSE, FALSE, sizeof (CacheLayout));
+  variants = g_array_new (FALSE, FALSE, sizeof (CacheItem));
+  by_name = g_array_new (FALSE, FALSE, sizeof (guint32));
+  for (i = 0; i < layouts->len; i++)
+    {
+      BuildLayout *layout = g_ptr_array_index (layouts, i);
+      CacheLayout item;
+      guint32 index = i;
+
+      g_ptr_array_sort (layout->variants, build_description_cmp);
+
+      item.name = xkb_registry_cache_add_string (strings, offsets, layout->name);
+      item.description = xkb_registry_cache_add_string (strings, offsets, layout->description);
+      item.first_variant = variants->len;
+      item.n_variants = layout->variants->len;
+      g_array_append_val (layout_items, item);
+      g_array_append_val (by_name, index);
+
+      for (j = 0; j < layout->variants->len; j++)
+        {
+          BuildItem *variant = g_ptr_array_index (layout->variants, j);
+          CacheItem variant_item;
+          variant_item.name = xkb_registry_cache_add_string (strings, offsets, variant->name);
+          variant_item.description = xkb_registry_cache_add_string (strings, offsets, variant->description);
+          g_array_append_val (variants, variant_item);
+        }
+    }
+  g_array_sort_with_data (by_name, build_layout_name_cmp, layouts);
+
+  /* serialize, every section is a multiple of 4 bytes */
+  memset (&header, 0, sizeof (header));
+  memcpy (header.magic, CACHE_MAGIC, sizeof (header.magic));
+  header.version = CACHE_VERSION;
+  header.key = xkb_registry_cache_add_string (strings, offsets, key);
+  header.n_models = models->len;
+  header.models = sizeof (header);
+  header.n_groups = groups->len;
+  header.groups = header.models + models->len * sizeof (CacheItem);
+  header.n_options = options->len;
+  header.options = header.groups + groups->len * sizeof (CacheGroup);
+  header.n_layouts = layout_items->len;
+  header.layouts = header.options + options->len * sizeof (CacheItem);
+  header.layouts_by_name = header.layouts + layout_items->len * sizeof (CacheLayout);
+  header.n_variants = variants->len;
+  header.variants = header.layouts_by_name + by_name->len * sizeof (guint32);
+  header.strings = header.variants + variants->len * sizeof (CacheItem);
+  header.strings_size = strings->len;
+
+  data = g_byte_array_sized_new (header.strings + header.strings_size);
+  g_byte_array_append (data, (const guint8 *) &header, sizeof (header));
+  g_byte_array_append (data, (const guint8 *) models->data, models->len * sizeof (CacheItem));
+  g_byte_array_append (data, (const guint8 *) groups->data, groups->len * sizeof (CacheGroup));
+  g_byte_array_append (data, (const guint8 *) options->data, options->len * sizeof (CacheItem));
+  g_byte_array_append (data, (const guint8 *) layout_items->data, layout_items->len * sizeof (CacheLayout));
+  g_byte_array_append (data, (const guint8 *) by_name->data, by_name->len * sizeof (guint32));
+  g_byte_array_append (data, (const guint8 *) variants->data, variants->len * sizeof (CacheItem));
+  g_byte_array_append (data, strings->data, strings->len);
+
+  g_array_free (models, TRUE);
+  g_array_free (groups, TRUE);
+  g_array_free (options, TRUE);
+  g_array_free (layout_items, TRUE);
+  g_array_free (variants, TRUE);
+  g_array_free (by_name, TRUE);
+  g_ptr_array_free (layouts, TRUE);
+  g_byte_array_free (strings, TRUE);
+  g_hash_table_destroy (offsets);
+
+  return g_byte_array_free_to_bytes (data);
+}
+
+
+
+/**
+ * xkb_registry_cache_load:
+ *
+ * Map the registry cache, rebuilding it from the XKB rules first if it is
+ * missing or outdated. If the cache file cannot be written, the freshly
+ * built data is used from memory.
+ *
+ * Returns: a new #XkbRegistryCache or %NULL if the registry could not be
+ *          parsed at all.
+ **/
+XkbRegistryCache *
+xkb_registry_cache_load (void)
+{
+  XkbRegistryCache *cache = NULL;
+  GMappedFile *mapped_file;
+  GError *error = NULL;
+  GBytes *bytes;
+  gchar *filename;
+  gchar *dirname;
+  gchar *key;
+  gconstpointer data;
+  gsize size;
+
+  key = xkb_registry_cache_build_key ();
+  filename = g_build_filename (g_get_user_cache_dir (), CACHE_FILENAME, NULL);
+
+  mapped_file = g_mapped_file_new (filename, FALSE, NULL);
+  if (mapped_file != NULL)
+    {
+      bytes = g_mapped_file_get_bytes (mapped_file);
+      cache = xkb_registry_cache_new_from_bytes (bytes, key);
+      g_bytes_unref (bytes);
+      g_mapped_file_unref (mapped_file);
+    }
+
+  if (cache == NULL)
+    {
+      DBG ("Rebuilding XKB registry cache %s", filename);
+
+      bytes = xkb_registry_cache_build (key);
+      if (bytes != NULL)
+        {
+          dirname = g_path_get_dirname (filename);
+          data = g_bytes_get_data (bytes, &size);
+          if (g_mkdir_with_parents (dirname, 0700) != 0
+              || !g_file_set_contents (filename, data, size, &error))
+            {
+              g_warning ("Failed to write XKB registry cache: %s",
+                         error != NULL ? error->message : g_strerror (errno));
+              g_clear_error (&error);
+            }
+          g_free (dirname);
+
+          cache = xkb_registry_cache_new_from_bytes (bytes, key);
+          g_bytes_unref (bytes);
+        }
+    }
+
+  g_free (filename);
+  g_free (key);
+
+  return cache;
+}
+
+
+
+void
+xkb_registry_cache_free (XkbRegistryCache *cache)
+{
+  if (cache == NULL)
+    return;
+
+  g_bytes_unref (cache->bytes);
+  g_free (cache);
+}
+
+
+
+guint
+xkb_registry_cache_get_n_models (XkbRegistryCache *cache)
+{
+  return cache != NULL ? cache->header->n_models : 0;
+}
+
+
+
+void
+xkb_registry_cache_get_model (XkbRegistryCache *cache,
+                              guint n,
+                              const gchar **name,
+                              const gchar **description)
+{
+  g_return_if_fail (n < cache->header->n_models);
+
+  *name = cache_string (cache, cache->models[n].name);
+  *description = cache_string (cache, cache->models[n].description);
+}
+
+
+
+gboolean
+xkb_registry_cache_get_option_group (XkbRegistryCache *cache,
+                                     const gchar *group,
+                                     guint *first_option,
+                                     guint *n_options)
+{
+  guint i;
+
+  if (cache == NULL)
+    return FALSE;
+
+  for (i = 0; i < cache->header->n_groups; i++)
+    {
+      if (g_strcmp0 (cache_string (cache, cache->groups[i].name), group) == 0)
+        {
+          /* a corrupt file must not point outside the options array */
+          if (cache->groups[i].first_option > cache->header->n_options
+              || cache->header->n_options - cache->groups[i].first_option < cache->groups[i].n_options)
+            return FALSE;
+
+          *first_option = cache->groups[i].first_option;
+          *n_options = cache->groups[i].n_options;
+          return TRUE;
+        }
+    }
+
+  return FALSE;
+}
+
+
+
+void
+xkb_registry_cache_get_option (XkbRegistryCache *cache,
+                               guint n,
+                               const gchar **name,
+                               const gchar **description)
+{
+  g_return_if_fail (n < cache->header->n_options);
+
+  *name = cache_string (cache, cache->options[n].name);
+  *description = cache_string (cache, cache->options[n].description);
+}
+
+
+
+guint
+xkb_registry_cache_get_n_layouts (XkbRegistryCache *cache)
+{
+  return cache != NULL ? cache->header->n_layouts : 0;
+}
+
+
+
+void
+xkb_registry_cache_get_layout (XkbRegistryCache *cache,
+                               guint n,
+                               const gchar **name,
+                               const gchar **description,
+                               guint *first_variant,
+                               guint *n_variants)
+{
+  const CacheLayout *layout;
+
+  g_return_if_fail (n < cache->header->n_layouts);
+
+  layout = &cache->layouts[n];
+  if (name != NULL)
+    *name = cache_string (cache, layout->name);
+  if (description != NULL)
+    *description = cache_string (cache, layout->description);
+
+  if (first_variant != NULL && n_variants != NULL)
+    {
+      if (layout->first_variant <= cache->header->n_variants
+          && cache->header->n_variants - layout->first_variant >= layout->n_variants)
+        {
+          *first_variant = layout->first_variant;
+          *n_variants = layout->n_variants;
+        }
+      else
+        {
+          *first_variant = 0;
+          *n_variants = 0;
+        }
+    }
+}
+
+
+
+/**
+ * xkb_registry_cache_find_layout:
+ * @cache: a #XkbRegistryCache.
+ * @name: the layout name, e.g. "us".
+ *
+ * Returns: the index of the layout or -1 if there is no such layout.
+ **/
+gint
+xkb_registry_cache_find_layout (XkbRegistryCache *cache,
+                                const gchar *name)
+{
+  const gchar *layout_name;
+  guint32 index;
+  guint lower, upper, middle;
+  gint cmp;
+
+  if (cache == NULL || name == NULL)
+    return -1;
+
+  lower = 0;
+  upper = cache->header->n_layouts;
+  while (lower < upper)
+    {
+      middle = lower + (upper - lower) / 2;
+      index = cache->layouts_by_name[middle];
+      if (index >= cache->header->n_layouts)
+        return -1;
+
+      layout_name = cache_string (cache, cache->layouts[index].name);
+      cmp = strcmp (name, layout_name != NULL ? layout_name : "");
+      if (cmp == 0)
+        return index;
+      else if (cmp < 0)
+        upper = middle;
+      else
+        lower = middle + 1;
+    }
+
+  return -1;
+}
+
+
+
+void
+xkb_registry_cache_get_variant (XkbRegistryCache *cache,
+                                guint n,
+                                const gchar **name,
+                                const gchar **description)
+{
+  g_return_if_fail (n < cache->header->n_variants);
+
+  *name = cache_string (cache, cache->variants[n].name);
+  *description = cache_string (cache, cache->variants[n].description);
+}
@@ -0,0 +1,73 @@
+/* vi:set sw=2 sts=2 ts=2 et ai: */
+/*-
+ * Copyright (c) 2026 The Xfce Development Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __XKB_REGISTRY_CACHE_H__
+#define __XKB_REGISTRY_CACHE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _XkbRegistryCache XkbRegistryCache;
+
+XkbRegistryCache *
+xkb_registry_cache_load (void);
+void
+xkb_registry_cache_free (XkbRegistryCache *cache);
+
+guint
+xkb_registry_cache_get_n_models (XkbRegistryCache *cache);
+void
+xkb_registry_cache_get_model (XkbRegistryCache *cache,
+                              guint n,
+                              const gchar **name,
+                              const gchar **description);
+
+gboolean
+xkb_registry_cache_get_option_group (XkbRegistryCache *cache,
+                                     const gchar *group,
+                                     guint *first_option,
+                                     guint *n_options);
+void
+xkb_registry_cache_get_option (XkbRegistryCache *cache,
+                               guint n,
+                               const gchar **name,
+                               const gchar **description);
+
+guint
+xkb_registry_cache_get_n_layouts (XkbRegistryCache *cache);
+void
+xkb_registry_cache_get_layout (XkbRegistryCache *cache,
+                               guint n,
+                               const gchar **name,
+                               const gchar **description,
+                               guint *first_variant,
+                               guint *n_variants);
+gint
+xkb_registry_cache_find_layout (XkbRegistryCache *cache,
+                                const gchar *name);
+void
+xkb_registry_cache_get_variant (XkbRegistryCache *cache,
+                                guint n,
+                                const gchar **name,
+                                const gchar **description);
+
+G_END_DECLS
+
+#endif /* !__XKB_REGISTRY_CACHE_H__ */
@@ -0,0 +1,354 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Drives the display code of xfsettingsd on the outputs of the mock backend,
+ * for 1 to 32 outputs:
+ *
+ *   hotplug        a helper takes over the outputs: it reads the profiles,
+ *                  matches them against the outputs and applies the match
+ *   profile-match  the profile matching the outputs is looked up
+ *   apply          a profile that moves every output is applied
+ *
+ * Each scenario prints its median and worst latency and the allocations per
+ * run. The profiles are written to the mock channel, so this needs xfconfd
+ * on the session bus; without one the benchmark is skipped. Run it with
+ *
+ *   meson test -C build --benchmark --verbose displays
+ */
+
+#include "displays.h"
+
+#include "common/display-mock.h"
+#include "common/display-profiles.h"
+
+#include <stdlib.h>
+
+/* what meson expects from a skipped test or benchmark */
+#define EXIT_SKIP 77
+
+/* profiles with other outputs, that profile matching has to skip */
+#define N_DECOYS 16
+
+#define N_HOTPLUG_RUNS 20
+#define N_MATCH_RUNS 1000
+#define N_APPLY_RUNS 100
+
+#define PROFILE_A "BenchA"
+#define PROFILE_B "BenchB"
+
+
+
+static const guint bench_n_outputs[] = { 1, 2, 4, 8, 16, 32 };
+
+static gint bench_allocations = 0;
+
+#ifdef __GLIBC__
+/* counts the allocations of the whole process, GLib's and xfconf's included */
+#define BENCH_COUNTS_ALLOCATIONS 1
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t n_members,
+                            size_t size);
+extern void *__libc_realloc (void *ptr,
+                             size_t size);
+
+void *
+malloc (size_t size)
+{
+    g_atomic_int_inc (&bench_allocations);
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n_members,
+        size_t size)
+{
+    g_atomic_int_inc (&bench_allocations);
+    return __libc_calloc (n_members, size);
+}
+
+void *
+realloc (void *ptr,
+         size_t size)
+{
+    g_atomic_int_inc (&bench_allocations);
+    return __libc_realloc (ptr, size);
+}
+#else
+#define BENCH_COUNTS_ALLOCATIONS 0
+#endif
+
+
+
+typedef void (*BenchFunc) (gpointer data,
+                           guint run);
+
+
+
+static gint
+compare_times (gconstpointer a,
+               gconstpointer b)
+{
+    gint64 t1 = *(const gint64 *) a;
+    gint64 t2 = *(const gint64 *) b;
+
+    return (t1 > t2) - (t1 < t2);
+}
+
+
+
+static void
+bench_run (const gchar *scenario,
+           guint n_outputs,
+           guint n_runs,
+           BenchFunc func,
+           gpointer data)
+{
+    gint64 *times = g_new (gint64, n_runs);
+    gint allocations = g_atomic_int_get (&bench_allocations);
+
+    for (guint run = 0; run < n_runs; run++)
+    {
+        gint64 start = g_get_monotonic_time ();
+
+        func (data, run);
+        times[run] = g_get_monotonic_time () - start;
+    }
+
+    allocations = g_atomic_int_get (&bench_allocations) - allocations;
+    qsort (times, n_runs, sizeof (gint64), compare_times);
+
+    if (BENCH_COUNTS_ALLOCATIONS)
+        g_print ("%-14s %2u outputs  median %8" G_GINT64_FORMAT " us  max %8" G_GINT64_FORMAT " us  %8.1f allocations\n",
+                 scenario, n_outputs, times[n_runs / 2], times[n_runs - 1], (gdouble) allocations / n_runs);
+    else
+        g_print ("%-14s %2u outputs  median %8" G_GINT64_FORMAT " us  max %8" G_GINT64_FORMAT " us\n",
+                 scenario, n_outputs, times[n_runs / 2], times[n_runs - 1]);
+
+    g_free (times);
+}
+
+
+
+static void
+bench_write_scheme (XfconfChannel *channel,
+                    const gchar *scheme,
+                    const gchar *name,
+                    DisplayMock *mock,
+                    gboolean reversed)
+{
+    gchar *root = g_strdup_printf ("/%s", scheme);
+    DisplayProfileWriter *writer = display_profile_writer_new (channel, root, TRUE);
+    gint x = 0;
+
+    if (name != NULL)
+        display_profile_writer_set_string (writer, root, name);
+
+    for (guint n = 0; n < mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (mock->outputs, reversed ? mock->outputs->len - 1 - n : n);
+        DisplayMockMode *mode = &output->modes[reversed && output->n_modes > 1 ? 1 : 0];
+        gchar *property, *resolution;
+
+        property = g_strdup_printf (OUTPUT_FMT, scheme, output->name);
+        display_profile_writer_set_string (writer, property, output->friendly_name);
+        g_free (property);
+
+        property = g_strdup_printf (OUTPUT_FMT "/EDID", scheme, output->name);
+        display_profile_writer_set_string (writer, property, output->edid);
+        g_free (property);
+
+        property = g_strdup_printf (ACTIVE_PROP, scheme, output->name);
+        display_profile_writer_set_bool (writer, property, TRUE);
+        g_free (property);
+
+        property = g_strdup_printf (RESOLUTION_PROP, scheme, output->name);
+        resolution = g_strdup_printf ("%ux%u", mode->width, mode->height);
+        display_profile_writer_set_string (writer, property, resolution);
+        g_free (resolution);
+        g_free (property);
+
+        property = g_strdup_printf (RRATE_PROP, scheme, output->name);
+        display_profile_writer_set_double (writer, property, mode->rate);
+        g_free (property);
+
+        property = g_strdup_printf (ROTATION_PROP, scheme, output->name);
+        display_profile_writer_set_int (writer, property, 0);
+        g_free (property);
+
+        property = g_strdup_printf (SCALE_PROP, scheme, output->name);
+        display_profile_writer_set_double (writer, property, 1.0);
+        g_free (property);
+
+        property = g_strdup_printf (POSX_PROP, scheme, output->name);
+        display_profile_writer_set_int (writer, property, x);
+        g_free (property);
+
+        property = g_strdup_printf (POSY_PROP, scheme, output->name);
+        display_profile_writer_set_int (writer, property, 0);
+        g_free (property);
+
+        property = g_strdup_printf (PRIMARY_PROP, scheme, output->name);
+        display_profile_writer_set_bool (writer, property, n == 0);
+        g_free (property);
+
+        x += mode->width;
+    }
+
+    display_profile_writer_commit (writer);
+    g_free (root);
+}
+
+
+
+/* Two user profiles for the outputs of @mock, that place them in opposite
+ * orders, Default like the first one, and decoys for other outputs. */
+static gboolean
+bench_write_profiles (XfconfChannel *channel,
+                      DisplayMock *mock,
+                      guint seed)
+{
+    gchar **display_infos = display_mock_get_display_infos (mock);
+    gint64 deadline;
+    gboolean indexed = FALSE;
+
+    bench_write_scheme (channel, DEFAULT_SCHEME_NAME, NULL, mock, FALSE);
+    bench_write_scheme (channel, PROFILE_A, "Bench A", mock, FALSE);
+    bench_write_scheme (channel, PROFILE_B, "Bench B", mock, TRUE);
+
+    for (guint n = 0; n < N_DECOYS; n++)
+    {
+        gchar *value = g_strdup_printf ("%u:%u", mock->outputs->len, seed + n + 1);
+        gchar *scheme = g_strdup_printf ("BenchDecoy%u", n);
+        DisplayMock *decoy;
+
+        /* the decoys get the same number of outputs, with other EDIDs */
+        g_setenv ("XFCE_DISPLAY_MOCK", value, TRUE);
+        decoy = display_mock_new (NULL);
+        bench_write_scheme (channel, scheme, scheme, decoy, FALSE);
+        display_mock_free (decoy);
+        g_free (scheme);
+        g_free (value);
+    }
+
+    /* the profile index learns about the new profiles from property-changed */
+    deadline = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+    while (!indexed && g_get_monotonic_time () < deadline)
+    {
+        GList *profiles;
+
+        if (!g_main_context_iteration (NULL, FALSE))
+            g_usleep (1000);
+
+        profiles = display_settings_get_profiles (display_infos, channel, TRUE);
+        indexed = g_list_length (profiles) == 2
+                  && display_settings_profile_matches (DEFAULT_SCHEME_NAME, display_infos, channel);
+        g_list_free_full (profiles, g_free);
+    }
+
+    g_strfreev (display_infos);
+
+    return indexed;
+}
+
+
+
+static void
+bench_hotplug (gpointer data,
+               guint run)
+{
+    g_ptr_array_add (data, xfce_displays_helper_new ());
+}
+
+
+
+static void
+bench_profile_match (gpointer data,
+                     guint run)
+{
+    g_free (xfce_displays_helper_get_matching_profile (data));
+}
+
+
+
+static void
+bench_apply (gpointer data,
+             guint run)
+{
+    XFCE_DISPLAYS_HELPER_GET_CLASS (data)->channel_apply (data, run % 2 == 0 ? PROFILE_B : PROFILE_A);
+}
+
+
+
+gint
+main (gint argc,
+      gchar **argv)
+{
+    GError *error = NULL;
+    XfconfChannel *channel;
+
+    if (!xfconf_init (&error))
+    {
+        g_print ("Skipped, xfconf is not available: %s\n", error->message);
+        g_error_free (error);
+        return EXIT_SKIP;
+    }
+
+    /* before the channel is looked up, so it is the mock one */
+    g_setenv ("XFCE_DISPLAY_MOCK", "1", TRUE);
+    channel = display_settings_profiles_channel_get ();
+    display_settings_profiles_load (channel);
+
+    for (guint i = 0; i < G_N_ELEMENTS (bench_n_outputs); i++)
+    {
+        guint n_outputs = bench_n_outputs[i];
+        gchar *value = g_strdup_printf ("%u:%u:0", n_outputs, n_outputs);
+        GPtrArray *helpers = g_ptr_array_new_with_free_func (g_object_unref);
+        DisplayMock *mock;
+        XfceDisplaysHelper *helper;
+
+        g_setenv ("XFCE_DISPLAY_MOCK", value, TRUE);
+        mock = display_mock_new (NULL);
+        if (!bench_write_profiles (channel, mock, n_outputs * 1000))
+        {
+            g_printerr ("The profiles for %u outputs did not reach the profile index\n", n_outputs);
+            display_mock_free (mock);
+            g_free (value);
+            return EXIT_FAILURE;
+        }
+
+        /* the helpers are created with the outputs of mock */
+        g_setenv ("XFCE_DISPLAY_MOCK", value, TRUE);
+        bench_run ("hotplug", n_outputs, N_HOTPLUG_RUNS, bench_hotplug, helpers);
+
+        helper = g_ptr_array_index (helpers, 0);
+        bench_run ("profile-match", n_outputs, N_MATCH_RUNS, bench_profile_match, helper);
+        bench_run ("apply", n_outputs, N_APPLY_RUNS, bench_apply, helper);
+
+        g_ptr_array_unref (helpers);
+        display_mock_free (mock);
+        g_free (value);
+    }
+
+    /* leave the mock channel as it was found */
+    xfconf_channel_reset_property (channel, "/", TRUE);
+    xfconf_shutdown ();
+
+    return EXIT_SUCCESS;
+}
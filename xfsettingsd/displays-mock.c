@@ -0,0 +1,443 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * Applies profiles to the outputs of common/display-mock.c, in memory.
+ * This runs the same xfconf and profile matching code as the real
+ * backends, so its timings show the cost of the daemon itself, without
+ * the round trips to the display server.
+ */
+
+#include "displays-mock.h"
+
+#include "common/debug.h"
+#include "common/display-mock.h"
+
+#include <string.h>
+
+
+
+static void
+xfce_displays_helper_mock_finalize (GObject *object);
+static GPtrArray *
+xfce_displays_helper_mock_get_outputs (XfceDisplaysHelper *helper);
+static void
+xfce_displays_helper_mock_toggle_internal (gpointer *power,
+                                           gboolean lid_is_closed,
+                                           XfceDisplaysHelper *helper);
+static gchar **
+xfce_displays_helper_mock_get_display_infos (XfceDisplaysHelper *helper);
+static void
+xfce_displays_helper_mock_channel_apply (XfceDisplaysHelper *helper,
+                                         const gchar *scheme);
+static gboolean
+xfce_displays_helper_mock_revert (XfceDisplaysHelper *helper);
+static GPtrArray *
+xfce_displays_helper_mock_get_layout_outputs (XfceDisplaysHelper *helper);
+
+
+
+typedef struct _MockOutputState
+{
+    /* index in DisplayMockOutput.modes, -1 if disabled */
+    gint mode;
+    gint rotation;
+    gdouble scale;
+    gint x;
+    gint y;
+    gboolean primary;
+} MockOutputState;
+
+struct _XfceDisplaysHelperMock
+{
+    XfceDisplaysHelper __parent__;
+
+    DisplayMock *mock;
+
+    /* what is applied, and what the current scheme asks for */
+    MockOutputState *current;
+    MockOutputState *pending;
+
+    /* what was applied before the last scheme, NULL if unknown */
+    MockOutputState *previous;
+
+    XfsdDebugHistogram *apply_latency;
+};
+
+
+
+G_DEFINE_FINAL_TYPE (XfceDisplaysHelperMock, xfce_displays_helper_mock, XFCE_TYPE_DISPLAYS_HELPER);
+
+
+
+static void
+xfce_displays_helper_mock_class_init (XfceDisplaysHelperMockClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+    XfceDisplaysHelperClass *helper_class = XFCE_DISPLAYS_HELPER_CLASS (klass);
+
+    gobject_class->finalize = xfce_displays_helper_mock_finalize;
+
+    helper_class->get_outputs = xfce_displays_helper_mock_get_outputs;
+    helper_class->toggle_internal = xfce_displays_helper_mock_toggle_internal;
+    helper_class->get_display_infos = xfce_displays_helper_mock_get_display_infos;
+    helper_class->channel_apply = xfce_displays_helper_mock_channel_apply;
+    helper_class->revert = xfce_displays_helper_mock_revert;
+    helper_class->get_layout_outputs = xfce_displays_helper_mock_get_layout_outputs;
+}
+
+
+
+static void
+xfce_displays_helper_mock_init (XfceDisplaysHelperMock *helper)
+{
+    GError *error = NULL;
+    gint x = 0;
+
+    helper->mock = display_mock_new (&error);
+    if (helper->mock == NULL)
+    {
+        g_critical ("%s", error->message);
+        g_error_free (error);
+        return;
+    }
+
+    helper->current = g_new0 (MockOutputState, helper->mock->outputs->len);
+    helper->pending = g_new0 (MockOutputState, helper->mock->outputs->len);
+    helper->apply_latency = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Mock scheme apply");
+
+    /* as many outputs as there are CRTCs start extended to the right */
+    for (guint n = 0; n < helper->mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (helper->mock->outputs, n);
+
+        helper->current[n].mode = n < helper->mock->n_crtcs ? 0 : -1;
+        helper->current[n].scale = 1.0;
+        helper->current[n].x = x;
+        helper->current[n].primary = n == 0;
+        if (helper->current[n].mode != -1)
+            x += output->modes[0].width;
+    }
+}
+
+
+
+static void
+xfce_displays_helper_mock_finalize (GObject *object)
+{
+    XfceDisplaysHelperMock *helper = XFCE_DISPLAYS_HELPER_MOCK (object);
+
+    g_free (helper->current);
+    g_free (helper->pending);
+    g_free (helper->previous);
+    display_mock_free (helper->mock);
+    xfsettings_dbg_histogram_free (helper->apply_latency);
+
+    G_OBJECT_CLASS (xfce_displays_helper_mock_parent_class)->finalize (object);
+}
+
+
+
+static GPtrArray *
+xfce_displays_helper_mock_get_outputs (XfceDisplaysHelper *helper)
+{
+    DisplayMock *mock = XFCE_DISPLAYS_HELPER_MOCK (helper)->mock;
+
+    return mock != NULL ? mock->outputs : NULL;
+}
+
+
+
+static void
+xfce_displays_helper_mock_toggle_internal (gpointer *power,
+                                           gboolean lid_is_closed,
+                                           XfceDisplaysHelper *helper)
+{
+    /* mock outputs are all external */
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Lid %s, no internal mock output to toggle.",
+                    lid_is_closed ? "closed" : "opened");
+}
+
+
+
+static gchar **
+xfce_displays_helper_mock_get_display_infos (XfceDisplaysHelper *helper)
+{
+    return display_mock_get_display_infos (XFCE_DISPLAYS_HELPER_MOCK (helper)->mock);
+}
+
+
+
+static GPtrArray *
+xfce_displays_helper_mock_get_layout_outputs (XfceDisplaysHelper *helper)
+{
+    DisplayMock *mock = XFCE_DISPLAYS_HELPER_MOCK (helper)->mock;
+    GPtrArray *outputs;
+
+    if (mock == NULL)
+        return NULL;
+
+    outputs = g_ptr_array_new_with_free_func ((GDestroyNotify) xfce_displays_layout_output_free);
+    for (guint n = 0; n < mock->outputs->len; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (mock->outputs, n);
+        XfceDisplaysLayoutOutput *layout_output;
+
+        /* the mock modes already start with the preferred one */
+        layout_output = xfce_displays_layout_output_new (output->name, output->friendly_name, output->edid);
+        for (guint m = 0; m < output->n_modes; m++)
+            xfce_displays_layout_output_add_mode (layout_output, output->modes[m].width, output->modes[m].height,
+                                                  output->modes[m].rate);
+        g_ptr_array_add (outputs, layout_output);
+    }
+
+    return outputs;
+}
+
+
+
+static const gchar *
+find_saved_output (GHashTable *saved_outputs,
+                   DisplayMockOutput *output)
+{
+    GHashTableIter iter;
+    gpointer key;
+    GValue *value;
+
+    /* mock EDIDs are unique, no need to fall back to names */
+    g_hash_table_iter_init (&iter, saved_outputs);
+    while (g_hash_table_iter_next (&iter, &key, (gpointer *) &value))
+    {
+        if (g_str_has_suffix (key, "/EDID")
+            && G_VALUE_HOLDS_STRING (value)
+            && g_strcmp0 (g_value_get_string (value), output->edid) == 0)
+            return key;
+    }
+
+    return NULL;
+}
+
+
+
+static gboolean
+load_from_xfconf (const gchar *scheme,
+                  GHashTable *saved_outputs,
+                  DisplayMockOutput *output,
+                  MockOutputState *state)
+{
+    const gchar *edid_property;
+    gchar *output_name;
+    gchar *property;
+    GValue *value;
+    const gchar *resolution;
+    gdouble rate;
+
+    state->mode = -1;
+
+    edid_property = find_saved_output (saved_outputs, output);
+    if (edid_property == NULL)
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_NO_XFCONF_DATA, output->name, output->edid);
+        return FALSE;
+    }
+
+    /* "/<scheme>/<output>/EDID" */
+    output_name = g_strndup (edid_property + strlen (scheme) + 2,
+                             strlen (edid_property) - strlen (scheme) - strlen ("//EDID"));
+
+    property = g_strdup_printf (ACTIVE_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    if (!G_VALUE_HOLDS_BOOLEAN (value) || !g_value_get_boolean (value))
+    {
+        g_free (output_name);
+        return FALSE;
+    }
+
+    property = g_strdup_printf (RESOLUTION_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    resolution = G_VALUE_HOLDS_STRING (value) ? g_value_get_string (value) : "";
+
+    property = g_strdup_printf (RRATE_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    rate = G_VALUE_HOLDS_DOUBLE (value) ? g_value_get_double (value) : 0.0;
+
+    for (guint n = 0; n < output->n_modes; n++)
+    {
+        gchar *mode_resolution = g_strdup_printf ("%ux%u", output->modes[n].width, output->modes[n].height);
+        gboolean match = g_strcmp0 (mode_resolution, resolution) == 0 && output->modes[n].rate == rate;
+        g_free (mode_resolution);
+        if (match)
+        {
+            state->mode = n;
+            break;
+        }
+    }
+
+    if (state->mode == -1)
+    {
+        g_warning (WARNING_MESSAGE_UNKNOWN_MODE, resolution, rate, output_name);
+        g_free (output_name);
+        return FALSE;
+    }
+
+    property = g_strdup_printf (ROTATION_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    state->rotation = G_VALUE_HOLDS_INT (value) ? g_value_get_int (value) : 0;
+
+    property = g_strdup_printf (SCALE_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    state->scale = G_VALUE_HOLDS_DOUBLE (value) ? g_value_get_double (value) : 1.0;
+
+    property = g_strdup_printf (POSX_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    state->x = G_VALUE_HOLDS_INT (value) ? g_value_get_int (value) : 0;
+
+    property = g_strdup_printf (POSY_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    state->y = G_VALUE_HOLDS_INT (value) ? g_value_get_int (value) : 0;
+
+    property = g_strdup_printf (PRIMARY_PROP, scheme, output_name);
+    value = g_hash_table_lookup (saved_outputs, property);
+    g_free (property);
+    state->primary = G_VALUE_HOLDS_BOOLEAN (value) && g_value_get_boolean (value);
+
+    g_free (output_name);
+
+    return TRUE;
+}
+
+
+
+static gboolean
+mock_output_state_equal (const MockOutputState *a,
+                         const MockOutputState *b)
+{
+    if (a->mode == -1 || b->mode == -1)
+        return a->mode == b->mode;
+
+    return a->mode == b->mode
+           && a->rotation == b->rotation
+           && a->scale == b->scale
+           && a->x == b->x
+           && a->y == b->y
+           && a->primary == b->primary;
+}
+
+
+
+static void
+xfce_displays_helper_mock_channel_apply (XfceDisplaysHelper *_helper,
+                                         const gchar *scheme)
+{
+    XfceDisplaysHelperMock *helper = XFCE_DISPLAYS_HELPER_MOCK (_helper);
+    XfconfChannel *channel = xfce_displays_helper_get_channel (_helper);
+    gint64 start_time = g_get_monotonic_time ();
+    gchar *property = g_strdup_printf ("/%s", scheme);
+    GHashTable *saved_outputs = xfconf_channel_get_properties (channel, property);
+    guint n_outputs = helper->mock->outputs->len;
+    guint n_enabled = 0, n_changed = 0;
+    g_free (property);
+
+    /* remember what to go back to if the user does not confirm */
+    g_free (helper->previous);
+    helper->previous = g_memdup2 (helper->current, n_outputs * sizeof (MockOutputState));
+
+    xfconf_channel_set_string (channel, ACTIVE_PROFILE, scheme);
+    if (saved_outputs == NULL)
+        return;
+
+    for (guint n = 0; n < n_outputs; n++)
+    {
+        if (load_from_xfconf (scheme, saved_outputs, g_ptr_array_index (helper->mock->outputs, n), &helper->pending[n]))
+            n_enabled++;
+    }
+    g_hash_table_destroy (saved_outputs);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_TOTAL_ACTIVE, n_enabled);
+
+    if (n_enabled == 0)
+    {
+        g_warning (WARNING_MESSAGE_ALL_DISABLED);
+        return;
+    }
+
+    /* like running out of CRTCs with RandR */
+    if (n_enabled > helper->mock->n_crtcs)
+    {
+        g_warning ("Scheme %s enables %u outputs but only %u CRTCs are available, aborting.",
+                   scheme, n_enabled, helper->mock->n_crtcs);
+        return;
+    }
+
+    for (guint n = 0; n < n_outputs; n++)
+    {
+        DisplayMockOutput *output = g_ptr_array_index (helper->mock->outputs, n);
+        MockOutputState *state = &helper->pending[n];
+
+        if (mock_output_state_equal (state, &helper->current[n]))
+            continue;
+
+        n_changed++;
+        if (state->mode == -1)
+            xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "  %s: disable", output->name);
+        else
+            xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "  %s: %ux%u@%.2f+%d+%d, rotation %d, scale %.2f%s",
+                            output->name, output->modes[state->mode].width, output->modes[state->mode].height,
+                            output->modes[state->mode].rate, state->x, state->y, state->rotation, state->scale,
+                            state->primary ? ", primary" : "");
+    }
+
+    if (n_changed == 0)
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Display configuration is already applied.");
+        return;
+    }
+
+    if (!xfce_displays_helper_get_dry_run ())
+        memcpy (helper->current, helper->pending, n_outputs * sizeof (MockOutputState));
+
+    xfsettings_dbg_histogram_add (helper->apply_latency, g_get_monotonic_time () - start_time);
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "%s scheme %s to %u mock output(s) in %.3f ms.",
+                    xfce_displays_helper_get_dry_run () ? "Would apply" : "Applied",
+                    scheme, n_changed, (g_get_monotonic_time () - start_time) / 1000.0);
+}
+
+
+
+static gboolean
+xfce_displays_helper_mock_revert (XfceDisplaysHelper *_helper)
+{
+    XfceDisplaysHelperMock *helper = XFCE_DISPLAYS_HELPER_MOCK (_helper);
+
+    if (helper->previous == NULL)
+        return FALSE;
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Reverting to the previous configuration.");
+    if (!xfce_displays_helper_get_dry_run ())
+        memcpy (helper->current, helper->previous, helper->mock->outputs->len * sizeof (MockOutputState));
+    g_clear_pointer (&helper->previous, g_free);
+
+    return TRUE;
+}
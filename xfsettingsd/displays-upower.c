@@ -97,7 +97,7 @@ xfce_displays_upower_init (XfceDisplaysUPower *upower)
 
     upower->lid_is_closed = up_client_get_lid_is_closed (upower->client);
     upower->handler = g_signal_connect (G_OBJECT (upower->client),
-                                        "notify",
+                                        "notify::lid-is-closed",
                                         G_CALLBACK (xfce_displays_upower_property_changed),
                                         upower);
 }
@@ -43,10 +43,20 @@ xfce_displays_helper_wayland_get_display_infos (XfceDisplaysHelper *helper);
 static void
 xfce_displays_helper_wayland_channel_apply (XfceDisplaysHelper *helper,
                                             const gchar *scheme);
+static gboolean
+xfce_displays_helper_wayland_revert (XfceDisplaysHelper *helper);
+static GPtrArray *
+xfce_displays_helper_wayland_get_layout_outputs (XfceDisplaysHelper *helper);
 
 static void
 manager_listener (XfceWlrOutputManager *manager, struct zwlr_output_manager_v1 *wl_manager, uint32_t serial);
 static void
+manager_ready (XfceWlrOutputManager *manager, XfceDisplaysHelperWayland *helper);
+static void
+manager_head_finished (XfceWlrOutputManager *manager, XfceWlrOutput *output, XfceDisplaysHelperWayland *helper);
+static void
+manager_mode_finished (XfceWlrOutputManager *manager, XfceWlrMode *mode, XfceDisplaysHelperWayland *helper);
+static void
 configuration_succeeded (void *data, struct zwlr_output_configuration_v1 *config);
 static void
 configuration_failed (void *data, struct zwlr_output_configuration_v1 *config);
@@ -55,6 +65,17 @@ configuration_cancelled (void *data, struct zwlr_output_configuration_v1 *config
 
 
 
+/* the writable part of a XfceWlrOutput */
+typedef struct _XfceWlrOutputSnapshot
+{
+    XfceWlrOutput *output;
+    int32_t enabled;
+    struct zwlr_output_mode_v1 *wl_mode;
+    int32_t x, y;
+    int32_t transform;
+    wl_fixed_t scale;
+} XfceWlrOutputSnapshot;
+
 struct _XfceDisplaysHelperWayland
 {
     XfceDisplaysHelper __parent__;
@@ -63,6 +84,9 @@ struct _XfceDisplaysHelperWayland
     uint32_t serial;
     guint previous_n_outputs;
     gboolean config_cancelled;
+
+    /* the configuration before the last channel_apply(), see revert() */
+    GArray *snapshot;
 };
 
 static const struct zwlr_output_configuration_v1_listener configuration_listener = {
@@ -90,6 +114,8 @@ xfce_displays_helper_wayland_class_init (XfceDisplaysHelperWaylandClass *klass)
     helper_class->toggle_internal = xfce_displays_helper_wayland_toggle_internal;
     helper_class->get_display_infos = xfce_displays_helper_wayland_get_display_infos;
     helper_class->channel_apply = xfce_displays_helper_wayland_channel_apply;
+    helper_class->revert = xfce_displays_helper_wayland_revert;
+    helper_class->get_layout_outputs = xfce_displays_helper_wayland_get_layout_outputs;
 }
 
 
@@ -97,7 +123,11 @@ xfce_displays_helper_wayland_class_init (XfceDisplaysHelperWaylandClass *klass)
 static void
 xfce_displays_helper_wayland_init (XfceDisplaysHelperWayland *helper)
 {
-    helper->manager = xfce_wlr_output_manager_new (manager_listener, helper);
+    /* the compositor answers while the rest of the daemon starts */
+    helper->manager = xfce_wlr_output_manager_new_async (manager_listener, helper);
+    g_signal_connect (helper->manager, "ready", G_CALLBACK (manager_ready), helper);
+    g_signal_connect (helper->manager, "head-finished", G_CALLBACK (manager_head_finished), helper);
+    g_signal_connect (helper->manager, "mode-finished", G_CALLBACK (manager_mode_finished), helper);
 }
 
 
@@ -118,6 +148,8 @@ xfce_displays_helper_wayland_finalize (GObject *object)
     XfceDisplaysHelperWayland *helper = XFCE_DISPLAYS_HELPER_WAYLAND (object);
 
     g_object_unref (helper->manager);
+    if (helper->snapshot != NULL)
+        g_array_free (helper->snapshot, TRUE);
 
     G_OBJECT_CLASS (xfce_displays_helper_wayland_parent_class)->finalize (object);
 }
@@ -127,7 +159,12 @@ xfce_displays_helper_wayland_finalize (GObject *object)
 static GPtrArray *
 xfce_displays_helper_wayland_get_outputs (XfceDisplaysHelper *helper)
 {
-    return xfce_wlr_output_manager_get_outputs (XFCE_DISPLAYS_HELPER_WAYLAND (helper)->manager);
+    XfceWlrOutputManager *manager = XFCE_DISPLAYS_HELPER_WAYLAND (helper)->manager;
+
+    if (!xfce_wlr_output_manager_is_ready (manager))
+        return NULL;
+
+    return xfce_wlr_output_manager_get_outputs (manager);
 }
 
 
@@ -371,6 +408,40 @@ apply_all (XfceDisplaysHelperWayland *helper)
 
 
 
+static gboolean
+xfce_displays_helper_wayland_revert (XfceDisplaysHelper *_helper)
+{
+    XfceDisplaysHelperWayland *helper = XFCE_DISPLAYS_HELPER_WAYLAND (_helper);
+
+    /* dropped when outputs come and go, or a head or mode it refers to is gone */
+    if (helper->snapshot == NULL)
+        return FALSE;
+
+    for (guint n = 0; n < helper->snapshot->len; n++)
+    {
+        XfceWlrOutputSnapshot *snapshot = &g_array_index (helper->snapshot, XfceWlrOutputSnapshot, n);
+        XfceWlrOutput *output = snapshot->output;
+
+        output->enabled = snapshot->enabled;
+        output->wl_mode = snapshot->wl_mode;
+        output->x = snapshot->x;
+        output->y = snapshot->y;
+        output->transform = snapshot->transform;
+        output->scale = snapshot->scale;
+    }
+
+    g_array_free (helper->snapshot, TRUE);
+    helper->snapshot = NULL;
+
+    /* a single configuration request, nothing to read from xfconf */
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Reverting to the previous configuration.");
+    apply_all (helper);
+
+    return TRUE;
+}
+
+
+
 static void
 xfce_displays_helper_wayland_toggle_internal (gpointer *power,
                                               gboolean lid_is_closed,
@@ -417,16 +488,13 @@ xfce_displays_helper_wayland_toggle_internal (gpointer *power,
     else
     {
         /* re-activate it because the user opened the lid */
-        XfconfChannel *channel = xfce_displays_helper_get_channel (XFCE_DISPLAYS_HELPER (helper));
-        GHashTable *saved_outputs = xfconf_channel_get_properties (channel, "/" DEFAULT_SCHEME_NAME);
+        GHashTable *saved_outputs = xfce_displays_helper_get_default_scheme (XFCE_DISPLAYS_HELPER (helper));
 
         if (saved_outputs != NULL)
         {
             /* reload settings, especially positions */
             for (guint n = 0; n < outputs->len; n++)
                 load_from_xfconf (helper, DEFAULT_SCHEME_NAME, saved_outputs, g_ptr_array_index (outputs, n));
-
-            g_hash_table_destroy (saved_outputs);
         }
 
         xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_ENABLING_INTERNAL, lvds->name);
@@ -447,6 +515,66 @@ xfce_displays_helper_wayland_get_display_infos (XfceDisplaysHelper *helper)
 
 
 
+/* the name the display dialog shows for @output */
+static const gchar *
+get_friendly_name (XfceWlrOutput *output)
+{
+    const EdidInfo *edid_info;
+    const gchar *fallback;
+
+    if (display_name_is_laptop_name (output->name))
+        return _("Laptop");
+
+    if (output->description != NULL)
+        return output->description;
+
+    edid_info = xfce_wlr_output_get_edid_info (output);
+    if (edid_info != NULL && edid_info->display_name != NULL)
+        return edid_info->display_name;
+
+    fallback = display_name_get_fallback (output->name);
+    if (fallback != NULL)
+        return fallback;
+
+    return output->name;
+}
+
+
+
+static GPtrArray *
+xfce_displays_helper_wayland_get_layout_outputs (XfceDisplaysHelper *helper)
+{
+    GPtrArray *wlr_outputs = xfce_wlr_output_manager_get_outputs (XFCE_DISPLAYS_HELPER_WAYLAND (helper)->manager);
+    GPtrArray *outputs = g_ptr_array_new_with_free_func ((GDestroyNotify) xfce_displays_layout_output_free);
+
+    for (guint n = 0; n < wlr_outputs->len; n++)
+    {
+        XfceWlrOutput *output = g_ptr_array_index (wlr_outputs, n);
+        XfceDisplaysLayoutOutput *layout_output;
+
+        layout_output = xfce_displays_layout_output_new (output->name, get_friendly_name (output), output->edid);
+
+        /* the preferred mode first, the rates are saved in Hz like the dialog does */
+        for (gint pass = 0; pass < 2; pass++)
+        {
+            for (GList *lp = output->modes; lp != NULL; lp = lp->next)
+            {
+                XfceWlrMode *mode = lp->data;
+
+                if (mode->preferred == (pass == 0))
+                    xfce_displays_layout_output_add_mode (layout_output, mode->width, mode->height,
+                                                          (gdouble) mode->refresh / 1000);
+            }
+        }
+
+        g_ptr_array_add (outputs, layout_output);
+    }
+
+    return outputs;
+}
+
+
+
 static void
 xfce_displays_helper_wayland_channel_apply (XfceDisplaysHelper *_helper,
                                             const gchar *scheme)
@@ -459,6 +587,19 @@ xfce_displays_helper_wayland_channel_apply (XfceDisplaysHelper *_helper,
     guint n_enabled = 0;
     g_free (property);
 
+    /* remember what to go back to if the user does not confirm */
+    if (helper->snapshot != NULL)
+        g_array_free (helper->snapshot, TRUE);
+    helper->snapshot = g_array_sized_new (FALSE, FALSE, sizeof (XfceWlrOutputSnapshot), outputs->len);
+    for (guint n = 0; n < outputs->len; n++)
+    {
+        XfceWlrOutput *output = g_ptr_array_index (outputs, n);
+        XfceWlrOutputSnapshot snapshot = {
+            output, output->enabled, output->wl_mode, output->x, output->y, output->transform, output->scale
+        };
+        g_array_append_val (helper->snapshot, snapshot);
+    }
+
     xfconf_channel_set_string (channel, ACTIVE_PROFILE, scheme);
     if (saved_outputs == NULL)
         return;
@@ -515,6 +656,13 @@ manager_listener (XfceWlrOutputManager *manager,
     xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_DIFF_N_OUTPUTS,
                     helper->previous_n_outputs, outputs->len);
 
+    /* whatever was applied before is meaningless for the new outputs */
+    if (outputs->len != helper->previous_n_outputs && helper->snapshot != NULL)
+    {
+        g_array_free (helper->snapshot, TRUE);
+        helper->snapshot = NULL;
+    }
+
     /* check if we have different amount of outputs and a matching profile and
        apply it if there's only one */
     if (outputs->len != helper->previous_n_outputs)
@@ -559,6 +707,7 @@ manager_listener (XfceWlrOutputManager *manager,
     else if (outputs->len > helper->previous_n_outputs)
     {
         gint action = xfconf_channel_get_int (channel, NOTIFY_PROP, ACTION_ON_NEW_OUTPUT_DEFAULT);
+        gint64 hotplug_time = 0;
         update_needed = TRUE;
 
         for (guint n = 0; n < outputs->len; n++)
@@ -569,6 +718,10 @@ manager_listener (XfceWlrOutputManager *manager,
 
             xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_NEW_OUTPUT, output->name);
 
+            /* the popup latency counts from the first head the compositor announced */
+            if (hotplug_time == 0 || output->added_time < hotplug_time)
+                hotplug_time = output->added_time;
+
             if (helper->previous_n_outputs == 0)
             {
                 output->enabled = TRUE;
@@ -592,10 +745,7 @@ manager_listener (XfceWlrOutputManager *manager,
 
         /* start the display dialog according to the user preferences */
         if (action == ACTION_ON_NEW_OUTPUT_SHOW_DIALOG)
-        {
-            const gchar *cmd = outputs->len <= 2 ? "xfce4-display-settings -m" : "xfce4-display-settings";
-            xfce_spawn_command_line (NULL, cmd, FALSE, FALSE, TRUE, NULL);
-        }
+            xfce_displays_helper_show_dialog (XFCE_DISPLAYS_HELPER (helper), outputs->len, hotplug_time);
     }
 
     if (update_needed)
@@ -637,3 +787,54 @@ configuration_cancelled (void *data,
     xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Cancelled application of configuration %p", config);
     zwlr_output_configuration_v1_destroy (config);
 }
+
+
+
+static void
+manager_ready (XfceWlrOutputManager *manager,
+               XfceDisplaysHelperWayland *helper)
+{
+    xfce_displays_helper_outputs_ready (XFCE_DISPLAYS_HELPER (helper));
+}
+
+
+
+static void
+manager_head_finished (XfceWlrOutputManager *manager,
+                       XfceWlrOutput *output,
+                       XfceDisplaysHelperWayland *helper)
+{
+    if (helper->snapshot == NULL)
+        return;
+
+    /* the output is about to be freed, or can no longer be configured */
+    for (guint n = 0; n < helper->snapshot->len; n++)
+    {
+        if (g_array_index (helper->snapshot, XfceWlrOutputSnapshot, n).output == output)
+        {
+            g_clear_pointer (&helper->snapshot, g_array_unref);
+            return;
+        }
+    }
+}
+
+
+
+static void
+manager_mode_finished (XfceWlrOutputManager *manager,
+                       XfceWlrMode *mode,
+                       XfceDisplaysHelperWayland *helper)
+{
+    if (helper->snapshot == NULL)
+        return;
+
+    /* the mode proxy is about to be destroyed */
+    for (guint n = 0; n < helper->snapshot->len; n++)
+    {
+        if (g_array_index (helper->snapshot, XfceWlrOutputSnapshot, n).wl_mode == mode->wl_mode)
+        {
+            g_clear_pointer (&helper->snapshot, g_array_unref);
+            return;
+        }
+    }
+}
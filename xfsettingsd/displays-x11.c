@@ -34,12 +34,36 @@
 #include <math.h>
 #endif
 
+/* how long outputs must be quiet after a RandR notification before the
+ * configuration is applied, in milliseconds */
+#define SETTLE_TIME_DEFAULT 250
+#define SETTLE_TIME_MIN 50
+#define SETTLE_TIME_MAX 2000
+
+/* apply anyway when outputs keep changing for that long, in microseconds */
+#define SETTLE_TIMEOUT (5 * G_USEC_PER_SEC)
+
 
 
 /* wrappers to avoid querying too often */
 typedef struct _XfceRRCrtc XfceRRCrtc;
 typedef struct _XfceRROutput XfceRROutput;
 
+/* steps of a display configuration change, in the order they are run */
+typedef enum
+{
+    XFCE_RR_STEP_DISABLE_CRTC,
+    XFCE_RR_STEP_SET_SCREEN_SIZE,
+    XFCE_RR_STEP_CONFIGURE_CRTC,
+    XFCE_RR_STEP_SET_PRIMARY,
+} XfceRRStepType;
+
+typedef struct _XfceRRStep
+{
+    XfceRRStepType type;
+    XfceRRCrtc *crtc;
+} XfceRRStep;
+
 
 
 static void
@@ -54,9 +78,17 @@ xfce_displays_helper_x11_toggle_internal (gpointer *power,
                                           XfceDisplaysHelper *helper);
 static gchar **
 xfce_displays_helper_x11_get_display_infos (XfceDisplaysHelper *helper);
+static GPtrArray *
+xfce_displays_helper_x11_get_layout_outputs (XfceDisplaysHelper *helper);
 static void
 xfce_displays_helper_x11_channel_apply (XfceDisplaysHelper *helper,
                                         const gchar *scheme);
+static gboolean
+xfce_displays_helper_x11_revert (XfceDisplaysHelper *helper);
+static void
+xfce_displays_helper_x11_take_snapshot (XfceDisplaysHelperX11 *helper);
+static void
+xfce_displays_helper_x11_drop_snapshot (XfceDisplaysHelperX11 *helper);
 static void
 xfce_displays_helper_x11_reload (XfceDisplaysHelperX11 *helper);
 static GdkFilterReturn
@@ -64,6 +96,11 @@ xfce_displays_helper_x11_screen_on_event (GdkXEvent *xevent,
                                           GdkEvent *event,
                                           gpointer data);
 static void
+xfce_displays_helper_x11_settle_time_changed (XfconfChannel *channel,
+                                              const gchar *property,
+                                              const GValue *value,
+                                              XfceDisplaysHelperX11 *helper);
+static void
 xfce_displays_helper_x11_set_screen_size (XfceDisplaysHelperX11 *helper);
 static gboolean
 xfce_displays_helper_x11_load_from_xfconf (XfceDisplaysHelperX11 *helper,
@@ -71,11 +108,13 @@ xfce_displays_helper_x11_load_from_xfconf (XfceDisplaysHelperX11 *helper,
                                            GHashTable *saved_outputs,
                                            XfceRROutput *output);
 static GPtrArray *
-xfce_displays_helper_x11_list_outputs (XfceDisplaysHelperX11 *helper);
+xfce_displays_helper_x11_list_outputs (XfceDisplaysHelperX11 *helper,
+                                       XfceRandrQuery *query);
 static void
 xfce_displays_helper_x11_free_output (XfceRROutput *output);
 static GPtrArray *
-xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper);
+xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper,
+                                     XfceRandrQuery *query);
 static XfceRRCrtc *
 xfce_displays_helper_x11_find_crtc_by_id (XfceDisplaysHelperX11 *helper,
                                           RRCrtc id);
@@ -93,9 +132,19 @@ xfce_displays_helper_x11_normalize_crtc (XfceRRCrtc *crtc,
 static Status
 xfce_displays_helper_x11_disable_crtc (XfceDisplaysHelperX11 *helper,
                                        RRCrtc crtc);
+static gboolean
+xfce_displays_helper_x11_crtc_differs (XfceRRCrtc *crtc);
+static gboolean
+xfce_displays_helper_x11_screen_size_differs (XfceDisplaysHelperX11 *helper);
+static GArray *
+xfce_displays_helper_x11_plan (XfceDisplaysHelperX11 *helper);
 static void
-xfce_displays_helper_x11_workaround_crtc_size (XfceRRCrtc *crtc,
-                                               XfceDisplaysHelperX11 *helper);
+xfce_displays_helper_x11_print_plan (XfceDisplaysHelperX11 *helper,
+                                     GArray *plan,
+                                     gboolean dry_run);
+static void
+xfce_displays_helper_x11_reset_crtc (XfceRRCrtc *crtc,
+                                     XfceDisplaysHelperX11 *helper);
 static void
 xfce_displays_helper_x11_apply_crtc_transform (XfceRRCrtc *crtc,
                                                XfceDisplaysHelperX11 *helper);
@@ -115,6 +164,7 @@ struct _XfceDisplaysHelperX11
     XfceDisplaysHelper __parent__;
 
     gint primary;
+    RROutput current_primary;
 
     GdkDisplay *display;
     GdkWindow *root_window;
@@ -122,6 +172,16 @@ struct _XfceDisplaysHelperX11
     gint event_base;
     guint screen_on_event_id;
 
+    /* settle detection after RandR notifications, settle_time follows the
+     * channel; the outputs of before the burst are kept once the cache was
+     * reloaded to look at the new ones, screen_changed() diffs against them */
+    gint settle_time;
+    gint64 settle_start;
+    gchar *settle_fingerprint;
+    GPtrArray *settle_outputs;
+    gboolean settle_reloaded;
+    XfsdDebugHistogram *settle_latency;
+
     /* RandR cache */
     XfceRandr *randr;
     XRRScreenResources *resources;
@@ -137,8 +197,33 @@ struct _XfceDisplaysHelperX11
     /* used to normalize positions */
     gint min_x;
     gint min_y;
+
+    /* the configuration before the last channel_apply(), see revert() */
+    GArray *snapshot;
+    RROutput snapshot_primary;
 };
 
+/* the CRTC configuration the X server currently uses */
+typedef struct _XfceRRCrtcState
+{
+    RRMode mode;
+    Rotation rotation;
+    gint x;
+    gint y;
+    guint width;
+    guint height;
+    gdouble scalex;
+    gdouble scaley;
+    gint noutput;
+    RROutput *outputs;
+} XfceRRCrtcState;
+
+typedef struct _XfceRRCrtcSnapshot
+{
+    RRCrtc id;
+    XfceRRCrtcState state;
+} XfceRRCrtcSnapshot;
+
 struct _XfceRRCrtc
 {
     RRCrtc id;
@@ -156,6 +241,7 @@ struct _XfceRRCrtc
     gint npossible;
     RROutput *possible;
     gint changed;
+    XfceRRCrtcState current;
 };
 
 struct _XfceRROutput
@@ -185,6 +271,8 @@ xfce_displays_helper_x11_class_init (XfceDisplaysHelperX11Class *klass)
     helper_class->toggle_internal = xfce_displays_helper_x11_toggle_internal;
     helper_class->get_display_infos = xfce_displays_helper_x11_get_display_infos;
     helper_class->channel_apply = xfce_displays_helper_x11_channel_apply;
+    helper_class->revert = xfce_displays_helper_x11_revert;
+    helper_class->get_layout_outputs = xfce_displays_helper_x11_get_layout_outputs;
 }
 
 
@@ -192,11 +280,15 @@ xfce_displays_helper_x11_class_init (XfceDisplaysHelperX11Class *klass)
 static void
 xfce_displays_helper_x11_init (XfceDisplaysHelperX11 *helper)
 {
-    gint error_base, err;
+    XfceRandrQuery *query;
+    XfconfChannel *channel;
+    gint error_base, err, settle_time;
 
     helper->resources = NULL;
     helper->outputs = NULL;
     helper->crtcs = NULL;
+    helper->settle_time = SETTLE_TIME_DEFAULT;
+    helper->settle_latency = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Hotplug to applied");
 
     /* get the default display */
     helper->display = gdk_display_get_default ();
@@ -227,8 +319,11 @@ xfce_displays_helper_x11_init (XfceDisplaysHelperX11 *helper)
         }
 
         /* get all existing CRTCs and connected outputs */
-        helper->crtcs = xfce_displays_helper_x11_list_crtcs (helper);
-        helper->outputs = xfce_displays_helper_x11_list_outputs (helper);
+        query = xfce_randr_query_new (helper->xdisplay, GDK_WINDOW_XID (helper->root_window), helper->resources, 0);
+        helper->crtcs = xfce_displays_helper_x11_list_crtcs (helper, query);
+        helper->outputs = xfce_displays_helper_x11_list_outputs (helper, query);
+        helper->current_primary = query->primary;
+        xfce_randr_query_free (query);
 
         /* Set up RandR notifications */
         XRRSelectInput (helper->xdisplay,
@@ -240,6 +335,13 @@ xfce_displays_helper_x11_init (XfceDisplaysHelperX11 *helper)
         gdk_window_add_filter (helper->root_window,
                                xfce_displays_helper_x11_screen_on_event,
                                helper);
+
+        /* read once, notifications must not cost any round-trip */
+        channel = display_settings_profiles_channel_get ();
+        settle_time = xfconf_channel_get_int (channel, SETTLE_TIME_PROP, SETTLE_TIME_DEFAULT);
+        helper->settle_time = CLAMP (settle_time, SETTLE_TIME_MIN, SETTLE_TIME_MAX);
+        g_signal_connect_object (G_OBJECT (channel), "property-changed::" SETTLE_TIME_PROP,
+                                 G_CALLBACK (xfce_displays_helper_x11_settle_time_changed), helper, 0);
     }
     else
     {
@@ -261,6 +363,7 @@ xfce_displays_helper_x11_dispose (GObject *object)
 
     g_clear_pointer (&helper->randr, xfce_randr_free);
     g_clear_pointer (&helper->outputs, g_ptr_array_unref);
+    g_clear_pointer (&helper->settle_outputs, g_ptr_array_unref);
     g_clear_pointer (&helper->crtcs, g_ptr_array_unref);
 
     (*G_OBJECT_CLASS (xfce_displays_helper_x11_parent_class)->dispose) (object);
@@ -276,6 +379,10 @@ xfce_displays_helper_x11_finalize (GObject *object)
     if (helper->screen_on_event_id != 0)
         g_source_remove (helper->screen_on_event_id);
 
+    g_free (helper->settle_fingerprint);
+    xfsettings_dbg_histogram_free (helper->settle_latency);
+    xfce_displays_helper_x11_drop_snapshot (helper);
+
     /* Free the screen resources */
     if (helper->resources)
     {
@@ -356,8 +463,7 @@ xfce_displays_helper_x11_toggle_internal (gpointer *power,
     else if (!lvds->active && !lid_is_closed)
     {
         /* re-activate it because the user opened the lid */
-        XfconfChannel *channel = xfce_displays_helper_get_channel (XFCE_DISPLAYS_HELPER (helper));
-        saved_outputs = xfconf_channel_get_properties (channel, "/" DEFAULT_SCHEME_NAME);
+        saved_outputs = xfce_displays_helper_get_default_scheme (XFCE_DISPLAYS_HELPER (helper));
         if (saved_outputs)
         {
             /* first, ensure the position of the other outputs is correct */
@@ -376,7 +482,6 @@ xfce_displays_helper_x11_toggle_internal (gpointer *power,
             /* try to load user saved settings for lvds */
             active = xfce_displays_helper_x11_load_from_xfconf (helper, DEFAULT_SCHEME_NAME,
                                                                 saved_outputs, lvds);
-            g_hash_table_destroy (saved_outputs);
         }
         if (!active)
         {
@@ -428,6 +533,64 @@ xfce_displays_helper_x11_get_display_infos (XfceDisplaysHelper *_helper)
 
 
 
+static GPtrArray *
+xfce_displays_helper_x11_get_layout_outputs (XfceDisplaysHelper *_helper)
+{
+    XfceDisplaysHelperX11 *helper = XFCE_DISPLAYS_HELPER_X11 (_helper);
+    GPtrArray *outputs;
+
+    /* without EDIDs the layout could not be matched to the outputs */
+    if (helper->randr == NULL)
+        return NULL;
+
+    outputs = g_ptr_array_new_with_free_func ((GDestroyNotify) xfce_displays_layout_output_free);
+    for (guint n = 0; n < helper->outputs->len; ++n)
+    {
+        XfceRROutput *output = g_ptr_array_index (helper->outputs, n);
+        XfceDisplaysLayoutOutput *layout_output;
+        const gchar *friendly_name = NULL;
+
+        for (guint m = 0; m < helper->randr->noutput; ++m)
+        {
+            if (g_strcmp0 (xfce_randr_get_output_info_name (helper->randr, m), output->info->name) == 0)
+            {
+                friendly_name = helper->randr->friendly_name[m];
+                break;
+            }
+        }
+
+        layout_output = xfce_displays_layout_output_new (output->info->name, friendly_name, output->edid);
+
+        /* the preferred mode first, then the others in the order of the output */
+        for (gint pass = 0; pass < 2; ++pass)
+        {
+            for (gint l = 0; l < output->info->nmode; ++l)
+            {
+                if ((output->info->modes[l] == output->preferred_mode) != (pass == 0))
+                    continue;
+
+                for (gint m = 0; m < helper->resources->nmode; ++m)
+                {
+                    XRRModeInfo *mode = &helper->resources->modes[m];
+
+                    if (mode->id == output->info->modes[l])
+                    {
+                        xfce_displays_layout_output_add_mode (layout_output, mode->width, mode->height,
+                                                              xfce_randr_calculate_refresh_rate (*mode));
+                        break;
+                    }
+                }
+            }
+        }
+
+        g_ptr_array_add (outputs, layout_output);
+    }
+
+    return outputs;
+}
+
+
+
 static void
 xfce_displays_helper_x11_channel_apply (XfceDisplaysHelper *_helper,
                                         const gchar *scheme)
@@ -438,6 +601,9 @@ xfce_displays_helper_x11_channel_apply (XfceDisplaysHelper *_helper,
     guint n, nactive;
     GHashTable *saved_outputs = NULL;
 
+    /* remember what to go back to if the user does not confirm */
+    xfce_displays_helper_x11_take_snapshot (helper);
+
     helper->primary = None;
 
     xfconf_channel_set_string (channel, ACTIVE_PROFILE, scheme);
@@ -479,9 +645,116 @@ err_cleanup:
 
 
 
+static void
+xfce_displays_helper_x11_clear_crtc_snapshot (gpointer data)
+{
+    XfceRRCrtcSnapshot *snapshot = data;
+
+    g_free (snapshot->state.outputs);
+}
+
+
+
+static void
+xfce_displays_helper_x11_take_snapshot (XfceDisplaysHelperX11 *helper)
+{
+    xfce_displays_helper_x11_drop_snapshot (helper);
+
+    helper->snapshot = g_array_sized_new (FALSE, FALSE, sizeof (XfceRRCrtcSnapshot), helper->crtcs->len);
+    g_array_set_clear_func (helper->snapshot, xfce_displays_helper_x11_clear_crtc_snapshot);
+    helper->snapshot_primary = helper->current_primary;
+
+    for (guint n = 0; n < helper->crtcs->len; ++n)
+    {
+        XfceRRCrtc *crtc = g_ptr_array_index (helper->crtcs, n);
+        XfceRRCrtcSnapshot snapshot;
+
+        snapshot.id = crtc->id;
+        snapshot.state = crtc->current;
+        snapshot.state.outputs = NULL;
+        if (crtc->current.noutput > 0)
+            snapshot.state.outputs = g_memdup2 (crtc->current.outputs, crtc->current.noutput * sizeof (RROutput));
+        g_array_append_val (helper->snapshot, snapshot);
+    }
+}
+
+
+
+static void
+xfce_displays_helper_x11_drop_snapshot (XfceDisplaysHelperX11 *helper)
+{
+    if (helper->snapshot != NULL)
+    {
+        g_array_free (helper->snapshot, TRUE);
+        helper->snapshot = NULL;
+    }
+}
+
+
+
+static gboolean
+xfce_displays_helper_x11_revert (XfceDisplaysHelper *_helper)
+{
+    XfceDisplaysHelperX11 *helper = XFCE_DISPLAYS_HELPER_X11 (_helper);
+    XfceRRCrtcSnapshot *snapshot;
+    XfceRRCrtc *crtc;
+    guint n;
+
+    if (helper->snapshot == NULL)
+        return FALSE;
+
+    /* CRTCs come from the screen resources, they only change with the hardware */
+    for (n = 0; n < helper->snapshot->len; ++n)
+    {
+        snapshot = &g_array_index (helper->snapshot, XfceRRCrtcSnapshot, n);
+        if (xfce_displays_helper_x11_find_crtc_by_id (helper, snapshot->id) == NULL)
+        {
+            xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "CRTC %lu is gone, cannot revert.", snapshot->id);
+            xfce_displays_helper_x11_drop_snapshot (helper);
+            return FALSE;
+        }
+    }
+
+    for (n = 0; n < helper->snapshot->len; ++n)
+    {
+        snapshot = &g_array_index (helper->snapshot, XfceRRCrtcSnapshot, n);
+        crtc = xfce_displays_helper_x11_find_crtc_by_id (helper, snapshot->id);
+
+        crtc->mode = snapshot->state.mode;
+        crtc->rotation = snapshot->state.rotation;
+        crtc->x = snapshot->state.x;
+        crtc->y = snapshot->state.y;
+        crtc->scalex = snapshot->state.scalex;
+        crtc->scaley = snapshot->state.scaley;
+
+        /* the state has the scaled size, the CRTC the size of the mode */
+        if (snapshot->state.mode != None)
+        {
+            crtc->width = round (snapshot->state.width / snapshot->state.scalex);
+            crtc->height = round (snapshot->state.height / snapshot->state.scaley);
+        }
+
+        g_free (crtc->outputs);
+        crtc->noutput = snapshot->state.noutput;
+        crtc->outputs = g_steal_pointer (&snapshot->state.outputs);
+        crtc->changed = xfce_displays_helper_x11_crtc_differs (crtc);
+    }
+
+    helper->primary = helper->snapshot_primary;
+    xfce_displays_helper_x11_drop_snapshot (helper);
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Reverting to the previous configuration.");
+    xfce_displays_helper_x11_apply_all (helper);
+
+    return TRUE;
+}
+
+
+
 static void
 xfce_displays_helper_x11_reload (XfceDisplaysHelperX11 *helper)
 {
+    XfceRandrQuery *query;
     gint err;
 
     xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Refreshing RandR cache.");
@@ -510,19 +783,24 @@ xfce_displays_helper_x11_reload (XfceDisplaysHelperX11 *helper)
         g_critical ("Failed to reload the RandR cache (err: %d).", err);
 
     /* recreate the caches */
-    helper->crtcs = xfce_displays_helper_x11_list_crtcs (helper);
-    helper->outputs = xfce_displays_helper_x11_list_outputs (helper);
+    query = xfce_randr_query_new (helper->xdisplay, GDK_WINDOW_XID (helper->root_window), helper->resources, 0);
+    helper->crtcs = xfce_displays_helper_x11_list_crtcs (helper, query);
+    helper->outputs = xfce_displays_helper_x11_list_outputs (helper, query);
+    helper->current_primary = query->primary;
+    xfce_randr_query_free (query);
 }
 
+static void
+screen_changed (XfceDisplaysHelperX11 *helper);
+
+
+
 static gboolean
 screen_on_event (gpointer data)
 {
     XfceDisplaysHelperX11 *helper = XFCE_DISPLAYS_HELPER_X11 (data);
-    XfconfChannel *channel = xfce_displays_helper_get_channel (XFCE_DISPLAYS_HELPER (helper));
-    GPtrArray *old_outputs;
     CARD16 dpms_mode;
     BOOL dpms_enabled;
-    gboolean edids_changed = FALSE;
 
     if (!DPMSInfo (gdk_x11_get_default_xdisplay (), &dpms_mode, &dpms_enabled))
     {
@@ -538,19 +816,45 @@ screen_on_event (gpointer data)
     }
     else
     {
-        GSource *source = g_main_context_find_source_by_id (NULL, helper->screen_on_event_id);
-        if (g_source_get_name (source) == NULL)
-        {
-            g_source_set_name (source, "xfsettingsd-RRScreenChangeNotify");
+        /* only log once, polling goes on until the screen is on */
+        if (helper->screen_on_event_id == 0)
             xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "DPMS enabled and DPMSModeOff: delaying RRScreenChangeNotify event");
-        }
+
+        /* the outputs may change again before the screen is on */
+        helper->settle_reloaded = FALSE;
         return TRUE;
     }
 
     helper->screen_on_event_id = 0;
 
-    old_outputs = g_ptr_array_ref (helper->outputs);
-    xfce_displays_helper_x11_reload (helper);
+    screen_changed (helper);
+
+    if (helper->settle_start != 0)
+    {
+        xfsettings_dbg_histogram_add (helper->settle_latency, g_get_monotonic_time () - helper->settle_start);
+        helper->settle_start = 0;
+    }
+
+    return FALSE;
+}
+
+
+
+static void
+screen_changed (XfceDisplaysHelperX11 *helper)
+{
+    XfconfChannel *channel = xfce_displays_helper_get_channel (XFCE_DISPLAYS_HELPER (helper));
+    GPtrArray *old_outputs;
+    gboolean edids_changed = FALSE;
+
+    /* the settle timeout usually reloaded the cache already */
+    if (helper->settle_outputs != NULL)
+        old_outputs = g_steal_pointer (&helper->settle_outputs);
+    else
+        old_outputs = g_ptr_array_ref (helper->outputs);
+    if (!helper->settle_reloaded)
+        xfce_displays_helper_x11_reload (helper);
+    helper->settle_reloaded = FALSE;
 
     xfsettings_dbg (XFSD_DEBUG_DISPLAYS, DEBUG_MESSAGE_DIFF_N_OUTPUTS,
                     old_outputs->len, helper->outputs->len);
@@ -588,6 +892,9 @@ screen_on_event (gpointer data)
     /* if output list changed, check if we have a matching profile */
     if (helper->outputs->len != old_outputs->len || edids_changed)
     {
+        /* whatever was applied before is meaningless for the new outputs */
+        xfce_displays_helper_x11_drop_snapshot (helper);
+
         gint mode = xfconf_channel_get_int (channel, AUTO_ENABLE_PROFILES, AUTO_ENABLE_PROFILES_DEFAULT);
         if (mode == AUTO_ENABLE_PROFILES_ALWAYS
             || (mode == AUTO_ENABLE_PROFILES_ON_CONNECT && helper->outputs->len > old_outputs->len)
@@ -599,7 +906,7 @@ screen_on_event (gpointer data)
                 xfce_displays_helper_x11_channel_apply (XFCE_DISPLAYS_HELPER (helper), matching_profile);
                 g_free (matching_profile);
                 g_ptr_array_unref (old_outputs);
-                return FALSE;
+                return;
             }
         }
         xfconf_channel_set_string (channel, ACTIVE_PROFILE, DEFAULT_SCHEME_NAME);
@@ -652,7 +959,7 @@ screen_on_event (gpointer data)
         {
             xfce_displays_helper_x11_apply_all (helper);
             g_ptr_array_unref (old_outputs);
-            return FALSE;
+            return;
         }
     }
 
@@ -684,7 +991,11 @@ screen_on_event (gpointer data)
                 if (crtc != NULL)
                 {
                     crtc->mode = None;
-                    xfce_displays_helper_x11_disable_crtc (helper, crtc->id);
+                    if (xfce_displays_helper_x11_disable_crtc (helper, crtc->id) == RRSetConfigSuccess)
+                    {
+                        crtc->current.mode = None;
+                        crtc->current.noutput = 0;
+                    }
                 }
                 /* if the output was active, we must recalculate the screen size */
                 changed |= output->active;
@@ -777,18 +1088,97 @@ screen_on_event (gpointer data)
 
                 /* Start the display dialog according to the user preferences */
                 if (action == ACTION_ON_NEW_OUTPUT_SHOW_DIALOG)
-                {
-                    const gchar *cmd = helper->outputs->len <= 2 ? "xfce4-display-settings -m" : "xfce4-display-settings";
-                    xfce_spawn_command_line (NULL, cmd, FALSE, FALSE, TRUE, NULL);
-                }
+                    xfce_displays_helper_show_dialog (XFCE_DISPLAYS_HELPER (helper), helper->outputs->len,
+                                                      helper->settle_start);
             }
         }
     }
     g_ptr_array_unref (old_outputs);
+}
 
-    return FALSE;
+
+
+/* The connected outputs and their EDIDs, from the last reload. */
+static gchar *
+xfce_displays_helper_x11_get_fingerprint (XfceDisplaysHelperX11 *helper,
+                                          gboolean *complete)
+{
+    GChecksum *checksum = g_checksum_new (G_CHECKSUM_MD5);
+    gchar *fingerprint;
+
+    for (guint n = 0; n < helper->outputs->len; ++n)
+    {
+        XfceRROutput *output = g_ptr_array_index (helper->outputs, n);
+
+        g_checksum_update (checksum, (const guchar *) &output->id, sizeof (RROutput));
+        if (output->edid != NULL)
+            g_checksum_update (checksum, (const guchar *) output->edid, -1);
+    }
+    fingerprint = g_strdup (g_checksum_get_string (checksum));
+    g_checksum_free (checksum);
+
+    *complete = helper->randr != NULL && xfce_randr_edids_complete (helper->randr);
+
+    return fingerprint;
+}
+
+
+
+static gboolean
+xfce_displays_helper_x11_settle_timeout (gpointer data)
+{
+    XfceDisplaysHelperX11 *helper = XFCE_DISPLAYS_HELPER_X11 (data);
+    gboolean complete;
+    gchar *fingerprint;
+
+    /* the reload screen_changed() would do anyway, done here to look at the
+     * new outputs */
+    if (helper->settle_outputs == NULL)
+        helper->settle_outputs = g_ptr_array_ref (helper->outputs);
+    xfce_displays_helper_x11_reload (helper);
+    helper->settle_reloaded = TRUE;
+
+    /* a freshly connected output may not expose its EDID yet: look again
+     * after another quiet period, as long as the outputs keep changing */
+    fingerprint = xfce_displays_helper_x11_get_fingerprint (helper, &complete);
+    if (!complete && g_strcmp0 (fingerprint, helper->settle_fingerprint) != 0
+        && g_get_monotonic_time () - helper->settle_start < SETTLE_TIMEOUT)
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Outputs did not settle yet.");
+        g_free (helper->settle_fingerprint);
+        helper->settle_fingerprint = fingerprint;
+        return G_SOURCE_CONTINUE;
+    }
+
+    /* compared with the outputs of the next burst */
+    g_free (helper->settle_fingerprint);
+    helper->settle_fingerprint = fingerprint;
+
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Outputs settled after %" G_GINT64_FORMAT "ms.",
+                    (g_get_monotonic_time () - helper->settle_start) / 1000);
+
+    helper->screen_on_event_id = 0;
+    if (screen_on_event (helper))
+        helper->screen_on_event_id = g_timeout_add_seconds (1, screen_on_event, helper);
+
+    return G_SOURCE_REMOVE;
+}
+
+
+
+static void
+xfce_displays_helper_x11_settle_time_changed (XfconfChannel *channel,
+                                              const gchar *property,
+                                              const GValue *value,
+                                              XfceDisplaysHelperX11 *helper)
+{
+    gint settle_time = G_VALUE_HOLDS_INT (value) ? g_value_get_int (value) : SETTLE_TIME_DEFAULT;
+
+    helper->settle_time = CLAMP (settle_time, SETTLE_TIME_MIN, SETTLE_TIME_MAX);
 }
 
+
+
 static GdkFilterReturn
 xfce_displays_helper_x11_screen_on_event (GdkXEvent *xevent,
                                           GdkEvent *event,
@@ -800,9 +1190,13 @@ xfce_displays_helper_x11_screen_on_event (GdkXEvent *xevent,
     if (e == NULL || e->type - helper->event_base != RRScreenChangeNotify)
         return GDK_FILTER_CONTINUE;
 
+    if (helper->settle_start == 0)
+        helper->settle_start = g_get_monotonic_time ();
+
+    /* every notification extends the quiet period */
     if (helper->screen_on_event_id != 0)
         g_source_remove (helper->screen_on_event_id);
-    helper->screen_on_event_id = g_timeout_add_seconds (1, screen_on_event, helper);
+    helper->screen_on_event_id = g_timeout_add (helper->settle_time, xfce_displays_helper_x11_settle_timeout, helper);
 
     /* Pass the event on to GTK+ */
     return GDK_FILTER_CONTINUE;
@@ -842,10 +1236,7 @@ xfce_displays_helper_x11_set_screen_size (XfceDisplaysHelperX11 *helper)
     /* set the screen size only if it's really needed and valid */
     if (helper->width >= min_width && helper->width <= max_width
         && helper->height >= min_height && helper->height <= max_height
-        && (helper->width != gdk_screen_width ()
-            || helper->height != gdk_screen_height ()
-            || helper->mm_width != gdk_screen_width_mm ()
-            || helper->mm_height != gdk_screen_height_mm ()))
+        && xfce_displays_helper_x11_screen_size_differs (helper))
     {
         xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Applying desktop dimensions: %dx%d (px), %dx%d (mm).",
                         helper->width, helper->height, helper->mm_width, helper->mm_height);
@@ -1154,13 +1545,14 @@ xfce_displays_helper_x11_load_from_xfconf (XfceDisplaysHelperX11 *helper,
 
 
 static GPtrArray *
-xfce_displays_helper_x11_list_outputs (XfceDisplaysHelperX11 *helper)
+xfce_displays_helper_x11_list_outputs (XfceDisplaysHelperX11 *helper,
+                                       XfceRandrQuery *query)
 {
     GPtrArray *outputs;
     XRROutputInfo *output_info;
     XfceRROutput *output;
     XfceRRCrtc *crtc;
-    gint best_dist, dist, n, m, l, err;
+    gint best_dist, dist, n, m, l;
 
     g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->xdisplay && helper->resources);
 
@@ -1168,22 +1560,18 @@ xfce_displays_helper_x11_list_outputs (XfceDisplaysHelperX11 *helper)
     outputs = g_ptr_array_new_with_free_func ((GDestroyNotify) xfce_displays_helper_x11_free_output);
     for (n = 0; n < helper->resources->noutput; ++n)
     {
-        gdk_x11_display_error_trap_push (helper->display);
-        output_info = XRRGetOutputInfo (helper->xdisplay, helper->resources, helper->resources->outputs[n]);
-        gdk_display_flush (helper->display);
-        err = gdk_x11_display_error_trap_pop (helper->display);
-        if (err || !output_info)
+        output_info = query->output_info[n];
+        if (output_info == NULL)
         {
-            g_warning ("Failed to load info for output %lu (err: %d). Skipping.",
-                       helper->resources->outputs[n], err);
+            g_warning ("Failed to load info for output %lu. Skipping.", helper->resources->outputs[n]);
             continue;
         }
 
         if (output_info->connection != RR_Connected)
-        {
-            XRRFreeOutputInfo (output_info);
             continue;
-        }
+
+        /* take it from the query */
+        query->output_info[n] = NULL;
 
         output = g_new0 (XfceRROutput, 1);
         output->id = helper->resources->outputs[n];
@@ -1262,12 +1650,13 @@ xfce_displays_helper_x11_free_output (XfceRROutput *output)
 
 
 static GPtrArray *
-xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper)
+xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper,
+                                     XfceRandrQuery *query)
 {
     GPtrArray *crtcs;
     XRRCrtcInfo *crtc_info;
     XfceRRCrtc *crtc;
-    gint n, err;
+    gint n;
 
     g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->xdisplay && helper->resources);
 
@@ -1275,17 +1664,12 @@ xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper)
     crtcs = g_ptr_array_new_with_free_func ((GDestroyNotify) xfce_displays_helper_x11_free_crtc);
     for (n = 0; n < helper->resources->ncrtc; ++n)
     {
-        XRRCrtcTransformAttributes *attr;
         xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Detected CRTC %lu.", helper->resources->crtcs[n]);
 
-        gdk_x11_display_error_trap_push (helper->display);
-        crtc_info = XRRGetCrtcInfo (helper->xdisplay, helper->resources, helper->resources->crtcs[n]);
-        gdk_display_flush (helper->display);
-        err = gdk_x11_display_error_trap_pop (helper->display);
-        if (err || !crtc_info)
+        crtc_info = query->crtc_info[n];
+        if (crtc_info == NULL)
         {
-            g_warning ("Failed to load info for CRTC %lu (err: %d). Skipping.",
-                       helper->resources->crtcs[n], err);
+            g_warning ("Failed to load info for CRTC %lu. Skipping.", helper->resources->crtcs[n]);
             continue;
         }
 
@@ -1298,17 +1682,8 @@ xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper)
         crtc->height = crtc_info->height;
         crtc->x = crtc_info->x;
         crtc->y = crtc_info->y;
-        if (XRRGetCrtcTransform (helper->xdisplay, helper->resources->crtcs[n], &attr) && attr)
-        {
-            crtc->scalex = XFixedToDouble (attr->currentTransform.matrix[0][0]);
-            crtc->scaley = XFixedToDouble (attr->currentTransform.matrix[1][1]);
-            XFree (attr);
-        }
-        else
-        {
-            crtc->scalex = 1.0;
-            crtc->scaley = 1.0;
-        }
+        crtc->scalex = query->crtc_scalex[n];
+        crtc->scaley = query->crtc_scaley[n];
 
         crtc->noutput = crtc_info->noutput;
         crtc->outputs = NULL;
@@ -1323,7 +1698,19 @@ xfce_displays_helper_x11_list_crtcs (XfceDisplaysHelperX11 *helper)
                                         crtc_info->npossible * sizeof (RROutput));
 
         crtc->changed = FALSE;
-        XRRFreeCrtcInfo (crtc_info);
+
+        crtc->current.mode = crtc->mode;
+        crtc->current.rotation = crtc->rotation;
+        crtc->current.x = crtc->x;
+        crtc->current.y = crtc->y;
+        crtc->current.width = crtc_info->width;
+        crtc->current.height = crtc_info->height;
+        crtc->current.scalex = crtc->scalex;
+        crtc->current.scaley = crtc->scaley;
+        crtc->current.noutput = crtc->noutput;
+        crtc->current.outputs = NULL;
+        if (crtc->noutput > 0)
+            crtc->current.outputs = g_memdup2 (crtc->outputs, crtc->noutput * sizeof (RROutput));
 
         /* cache it */
         g_ptr_array_add (crtcs, crtc);
@@ -1363,6 +1750,7 @@ xfce_displays_helper_x11_free_crtc (XfceRRCrtc *crtc)
 
     g_free (crtc->outputs);
     g_free (crtc->possible);
+    g_free (crtc->current.outputs);
     g_free (crtc);
 }
 
@@ -1480,32 +1868,6 @@ xfce_displays_helper_x11_disable_crtc (XfceDisplaysHelperX11 *helper,
 
 
 
-static void
-xfce_displays_helper_x11_workaround_crtc_size (XfceRRCrtc *crtc,
-                                               XfceDisplaysHelperX11 *helper)
-{
-    XRRCrtcInfo *crtc_info;
-
-    g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->xdisplay && helper->resources && crtc);
-
-    /* The CRTC needs to be disabled if its previous mode won't fit in the new screen.
-       It will be reenabled with its new mode (known to fit) after the screen size is
-       changed, unless the user disabled it (no need to reenable it then). */
-    crtc_info = XRRGetCrtcInfo (helper->xdisplay, helper->resources, crtc->id);
-    if (crtc_info->x + crtc_info->width > (guint) helper->width
-        || crtc_info->y + crtc_info->height > (guint) helper->height)
-    {
-        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "CRTC %lu must be temporarily disabled.", crtc->id);
-        if (xfce_displays_helper_x11_disable_crtc (helper, crtc->id) == RRSetConfigSuccess)
-            crtc->changed = (crtc->mode != None);
-        else
-            g_warning ("Failed to temporarily disable CRTC %lu.", crtc->id);
-    }
-    XRRFreeCrtcInfo (crtc_info);
-}
-
-
-
 static void
 xfce_displays_helper_x11_apply_crtc_transform (XfceRRCrtc *crtc,
                                                XfceDisplaysHelperX11 *helper)
@@ -1515,9 +1877,6 @@ xfce_displays_helper_x11_apply_crtc_transform (XfceRRCrtc *crtc,
 
     g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->xdisplay && crtc);
 
-    if (!crtc->changed)
-        return;
-
     if (crtc->scalex == 1 && crtc->scaley == 1)
         filter = "nearest";
     else
@@ -1550,31 +1909,38 @@ xfce_displays_helper_x11_apply_crtc (XfceRRCrtc *crtc,
 
     g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->xdisplay && helper->resources && crtc);
 
-    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Configuring CRTC %lu.", crtc->id);
-
-    /* check if we really need to do something */
-    if (crtc->changed)
-    {
-        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Applying changes to CRTC %lu.", crtc->id);
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Applying changes to CRTC %lu.", crtc->id);
 
-        if (crtc->mode == None)
-        {
-            ret = xfce_displays_helper_x11_disable_crtc (helper, crtc->id);
-        }
-        else
-        {
-            xfce_displays_helper_x11_apply_crtc_transform (crtc, helper);
+    /* the transform is only pending until the next CRTC configuration */
+    if (XDoubleToFixed (crtc->scalex) != XDoubleToFixed (crtc->current.scalex)
+        || XDoubleToFixed (crtc->scaley) != XDoubleToFixed (crtc->current.scaley))
+        xfce_displays_helper_x11_apply_crtc_transform (crtc, helper);
 
-            ret = XRRSetCrtcConfig (helper->xdisplay, helper->resources, crtc->id,
-                                    CurrentTime, crtc->x, crtc->y, crtc->mode,
-                                    crtc->rotation, crtc->outputs, crtc->noutput);
-        }
+    ret = XRRSetCrtcConfig (helper->xdisplay, helper->resources, crtc->id,
+                            CurrentTime, crtc->x, crtc->y, crtc->mode,
+                            crtc->rotation, crtc->outputs, crtc->noutput);
 
-        if (ret == RRSetConfigSuccess)
-            crtc->changed = FALSE;
-        else
-            g_warning ("Failed to configure CRTC %lu.", crtc->id);
+    if (ret != RRSetConfigSuccess)
+    {
+        g_warning ("Failed to configure CRTC %lu.", crtc->id);
+        return;
     }
+
+    /* this is what the server uses now */
+    crtc->changed = FALSE;
+    crtc->current.mode = crtc->mode;
+    crtc->current.rotation = crtc->rotation;
+    crtc->current.x = crtc->x;
+    crtc->current.y = crtc->y;
+    crtc->current.width = round (crtc->width * crtc->scalex);
+    crtc->current.height = round (crtc->height * crtc->scaley);
+    crtc->current.scalex = crtc->scalex;
+    crtc->current.scaley = crtc->scaley;
+    crtc->current.noutput = crtc->noutput;
+    g_free (crtc->current.outputs);
+    crtc->current.outputs = NULL;
+    if (crtc->noutput > 0)
+        crtc->current.outputs = g_memdup2 (crtc->outputs, crtc->noutput * sizeof (RROutput));
 }
 
 
@@ -1615,9 +1981,219 @@ xfce_displays_helper_x11_set_outputs (XfceRRCrtc *crtc,
 
 
 
+static gboolean
+xfce_displays_helper_x11_crtc_differs (XfceRRCrtc *crtc)
+{
+    gint n, m;
+
+    if (crtc->mode != crtc->current.mode)
+        return TRUE;
+
+    /* nothing else matters for a disabled CRTC */
+    if (crtc->mode == None)
+        return FALSE;
+
+    if (crtc->x != crtc->current.x
+        || crtc->y != crtc->current.y
+        || crtc->rotation != crtc->current.rotation
+        || XDoubleToFixed (crtc->scalex) != XDoubleToFixed (crtc->current.scalex)
+        || XDoubleToFixed (crtc->scaley) != XDoubleToFixed (crtc->current.scaley)
+        || crtc->noutput != crtc->current.noutput)
+        return TRUE;
+
+    /* same outputs, in any order */
+    for (n = 0; n < crtc->noutput; ++n)
+    {
+        for (m = 0; m < crtc->current.noutput; ++m)
+        {
+            if (crtc->outputs[n] == crtc->current.outputs[m])
+                break;
+        }
+        if (m == crtc->current.noutput)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+
+static gboolean
+xfce_displays_helper_x11_screen_size_differs (XfceDisplaysHelperX11 *helper)
+{
+    gboolean differs;
+
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+    differs = helper->width != gdk_screen_width ()
+              || helper->height != gdk_screen_height ()
+              || helper->mm_width != gdk_screen_width_mm ()
+              || helper->mm_height != gdk_screen_height_mm ();
+    G_GNUC_END_IGNORE_DEPRECATIONS
+
+    return differs;
+}
+
+
+
+static void
+xfce_displays_helper_x11_plan_add (GArray *plan,
+                                   XfceRRStepType type,
+                                   XfceRRCrtc *crtc)
+{
+    XfceRRStep step = { type, crtc };
+
+    g_array_append_val (plan, step);
+}
+
+
+
+static GArray *
+xfce_displays_helper_x11_plan (XfceDisplaysHelperX11 *helper)
+{
+    GArray *plan;
+    XfceRRCrtc *crtc;
+    guint n;
+
+    g_assert (XFCE_IS_DISPLAYS_HELPER_X11 (helper) && helper->crtcs);
+
+    plan = g_array_new (FALSE, FALSE, sizeof (XfceRRStep));
+
+    /* CRTCs to disable, either for good or because their current geometry won't
+       fit in the new screen; the latter are reenabled with their new mode (known
+       to fit) after the screen size is changed */
+    for (n = 0; n < helper->crtcs->len; ++n)
+    {
+        crtc = g_ptr_array_index (helper->crtcs, n);
+        if (crtc->current.mode == None || !xfce_displays_helper_x11_crtc_differs (crtc))
+            continue;
+
+        if (crtc->mode == None
+            || crtc->current.x + crtc->current.width > (guint) helper->width
+            || crtc->current.y + crtc->current.height > (guint) helper->height)
+            xfce_displays_helper_x11_plan_add (plan, XFCE_RR_STEP_DISABLE_CRTC, crtc);
+    }
+
+    if (xfce_displays_helper_x11_screen_size_differs (helper))
+        xfce_displays_helper_x11_plan_add (plan, XFCE_RR_STEP_SET_SCREEN_SIZE, NULL);
+
+    for (n = 0; n < helper->crtcs->len; ++n)
+    {
+        crtc = g_ptr_array_index (helper->crtcs, n);
+        if (crtc->mode != None && xfce_displays_helper_x11_crtc_differs (crtc))
+            xfce_displays_helper_x11_plan_add (plan, XFCE_RR_STEP_CONFIGURE_CRTC, crtc);
+    }
+
+    if ((RROutput) helper->primary != helper->current_primary)
+        xfce_displays_helper_x11_plan_add (plan, XFCE_RR_STEP_SET_PRIMARY, NULL);
+
+    return plan;
+}
+
+
+
+static void
+xfce_displays_helper_x11_print_plan (XfceDisplaysHelperX11 *helper,
+                                     GArray *plan,
+                                     gboolean dry_run)
+{
+    XfceRRStep *step;
+    GString *str;
+    guint n;
+
+    if (!dry_run && !xfsettings_dbg_enabled (XFSD_DEBUG_DISPLAYS))
+        return;
+
+    str = g_string_new (NULL);
+    for (n = 0; n < plan->len; ++n)
+    {
+        step = &g_array_index (plan, XfceRRStep, n);
+        g_string_append_printf (str, "\n  %u. ", n + 1);
+        switch (step->type)
+        {
+            case XFCE_RR_STEP_DISABLE_CRTC:
+                g_string_append_printf (str, "disable CRTC %lu%s", step->crtc->id,
+                                        step->crtc->mode != None ? " temporarily" : "");
+                break;
+
+            case XFCE_RR_STEP_SET_SCREEN_SIZE:
+                g_string_append_printf (str, "set screen size to %dx%d (%dx%d mm)",
+                                        helper->width, helper->height, helper->mm_width, helper->mm_height);
+                break;
+
+            case XFCE_RR_STEP_CONFIGURE_CRTC:
+                g_string_append_printf (str, "configure CRTC %lu: mode %lu at %d,%d, rotation %d, scale %.3fx%.3f, %d output(s)",
+                                        step->crtc->id, step->crtc->mode, step->crtc->x, step->crtc->y,
+                                        step->crtc->rotation, step->crtc->scalex, step->crtc->scaley,
+                                        step->crtc->noutput);
+                break;
+
+            case XFCE_RR_STEP_SET_PRIMARY:
+                g_string_append_printf (str, "set primary output to %lu", (RROutput) helper->primary);
+                break;
+        }
+    }
+
+    if (dry_run)
+        g_print ("Display configuration plan (dry run), %u step(s):%s\n", plan->len, str->str);
+    else
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Display configuration plan, %u step(s):%s", plan->len, str->str);
+
+    g_string_free (str, TRUE);
+}
+
+
+
+static void
+xfce_displays_helper_x11_reset_crtc (XfceRRCrtc *crtc,
+                                     XfceDisplaysHelperX11 *helper)
+{
+    /* forget about the planned configuration */
+    crtc->mode = crtc->current.mode;
+    crtc->rotation = crtc->current.rotation;
+    crtc->x = crtc->current.x;
+    crtc->y = crtc->current.y;
+    crtc->scalex = crtc->current.scalex;
+    crtc->scaley = crtc->current.scaley;
+    crtc->noutput = crtc->current.noutput;
+
+    /* the current size is scaled, the planned one is the rotated mode, as
+     * when a scheme is applied */
+    crtc->width = 0;
+    crtc->height = 0;
+    for (gint m = 0; m < helper->resources->nmode; ++m)
+    {
+        if (helper->resources->modes[m].id != crtc->mode)
+            continue;
+
+        if ((crtc->rotation & (RR_Rotate_90 | RR_Rotate_270)) != 0)
+        {
+            crtc->width = helper->resources->modes[m].height;
+            crtc->height = helper->resources->modes[m].width;
+        }
+        else
+        {
+            crtc->width = helper->resources->modes[m].width;
+            crtc->height = helper->resources->modes[m].height;
+        }
+        break;
+    }
+
+    g_free (crtc->outputs);
+    crtc->outputs = NULL;
+    if (crtc->noutput > 0)
+        crtc->outputs = g_memdup2 (crtc->current.outputs, crtc->noutput * sizeof (RROutput));
+    crtc->changed = FALSE;
+}
+
+
+
 static void
 xfce_displays_helper_x11_apply_all (XfceDisplaysHelperX11 *helper)
 {
+    XfceRRStep *step;
+    GArray *plan;
+    guint n;
+
     g_assert (XFCE_IS_DISPLAYS_HELPER (helper) && helper->crtcs);
 
     helper->mm_width = helper->mm_height = helper->width = helper->height = 0;
@@ -1627,21 +2203,62 @@ xfce_displays_helper_x11_apply_all (XfceDisplaysHelperX11 *helper)
     g_ptr_array_foreach (helper->crtcs, (GFunc) xfce_displays_helper_x11_get_topleftmost_pos, helper);
     g_ptr_array_foreach (helper->crtcs, (GFunc) xfce_displays_helper_x11_normalize_crtc, helper);
 
+    /* only touch what differs from the current configuration */
+    plan = xfce_displays_helper_x11_plan (helper);
+    if (plan->len == 0)
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Display configuration is already applied.");
+        g_array_free (plan, TRUE);
+        return;
+    }
+
+    xfce_displays_helper_x11_print_plan (helper, plan, xfce_displays_helper_get_dry_run ());
+    if (xfce_displays_helper_get_dry_run ())
+    {
+        g_ptr_array_foreach (helper->crtcs, (GFunc) xfce_displays_helper_x11_reset_crtc, helper);
+        helper->primary = helper->current_primary;
+        g_array_free (plan, TRUE);
+        return;
+    }
+
     gdk_x11_display_error_trap_push (helper->display);
 
     /* grab server to prevent clients from thinking no output is enabled */
     gdk_x11_display_grab (helper->display);
 
-    /* disable CRTCs that won't fit in the new screen */
-    g_ptr_array_foreach (helper->crtcs, (GFunc) xfce_displays_helper_x11_workaround_crtc_size, helper);
+    for (n = 0; n < plan->len; ++n)
+    {
+        step = &g_array_index (plan, XfceRRStep, n);
+        switch (step->type)
+        {
+            case XFCE_RR_STEP_DISABLE_CRTC:
+                if (xfce_displays_helper_x11_disable_crtc (helper, step->crtc->id) == RRSetConfigSuccess)
+                {
+                    step->crtc->current.mode = None;
+                    step->crtc->current.noutput = 0;
+                    if (step->crtc->mode == None)
+                        step->crtc->changed = FALSE;
+                }
+                else
+                    g_warning ("Failed to disable CRTC %lu.", step->crtc->id);
+                break;
 
-    /* set the screen size only if it's really needed and valid */
-    xfce_displays_helper_x11_set_screen_size (helper);
+            case XFCE_RR_STEP_SET_SCREEN_SIZE:
+                xfce_displays_helper_x11_set_screen_size (helper);
+                break;
 
-    /* final loop, apply crtc changes */
-    g_ptr_array_foreach (helper->crtcs, (GFunc) xfce_displays_helper_x11_apply_crtc, helper);
+            case XFCE_RR_STEP_CONFIGURE_CRTC:
+                xfce_displays_helper_x11_apply_crtc (step->crtc, helper);
+                break;
+
+            case XFCE_RR_STEP_SET_PRIMARY:
+                XRRSetOutputPrimary (helper->xdisplay, GDK_WINDOW_XID (helper->root_window), helper->primary);
+                helper->current_primary = helper->primary;
+                break;
+        }
+    }
 
-    XRRSetOutputPrimary (helper->xdisplay, GDK_WINDOW_XID (helper->root_window), helper->primary);
+    g_array_free (plan, TRUE);
 
     /* release the grab, changes are done */
     gdk_display_sync (helper->display);
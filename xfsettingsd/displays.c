@@ -36,11 +36,29 @@
 #include <gdk/gdkwayland.h>
 #endif
 
+#ifdef ENABLE_DISPLAY_MOCK
+#include "displays-mock.h"
+
+#include "common/display-mock.h"
+#endif
+
 #include "common/debug.h"
 #include "common/display-profiles.h"
 
 #include <libxfce4ui/libxfce4ui.h>
 
+/* a writer that did not end its batch by then is assumed to be gone */
+#define PROFILE_BATCH_TIMEOUT 5
+
+/* the layouts the popup offers for two outputs, like the minimal dialog */
+typedef enum
+{
+    LAYOUT_ONLY_FIRST,
+    LAYOUT_MIRROR,
+    LAYOUT_EXTEND,
+    LAYOUT_ONLY_SECOND,
+} XfceDisplaysLayout;
+
 
 #define get_instance_private(instance) \
     ((XfceDisplaysHelperPrivate *) xfce_displays_helper_get_instance_private (XFCE_DISPLAYS_HELPER (instance)))
@@ -58,6 +76,24 @@ typedef struct _XfceDisplaysHelperPrivate
 #ifdef HAVE_UPOWERGLIB
     XfceDisplaysUPower *power;
 #endif
+
+    /* a profile is being written, see PROFILE_BATCH_PROP */
+    gboolean in_batch;
+    guint batch_timeout_id;
+    gchar *pending_apply;
+
+    /* the Default scheme, ready for lid events */
+    GHashTable *default_scheme;
+    gboolean default_scheme_dirty;
+    guint default_scheme_id;
+
+    /* the profile chooser shown when an output is connected */
+    GtkWidget *popup;
+    gint64 popup_hotplug_time;
+    XfsdDebugHistogram *popup_latency;
+
+    /* time to go back when the user does not confirm a configuration */
+    XfsdDebugHistogram *revert_latency;
 } XfceDisplaysHelperPrivate;
 
 
@@ -66,6 +102,10 @@ G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (XfceDisplaysHelper, xfce_displays_helper, G
 
 
 
+static gboolean xfsettingsd_displays_dry_run = FALSE;
+
+
+
 static void
 xfce_displays_helper_class_init (XfceDisplaysHelperClass *klass)
 {
@@ -80,72 +120,177 @@ xfce_displays_helper_class_init (XfceDisplaysHelperClass *klass)
 static void
 xfce_displays_helper_init (XfceDisplaysHelper *helper)
 {
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    priv->popup_latency = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Hotplug to popup");
+    priv->revert_latency = xfsettings_dbg_histogram_new (XFSD_DEBUG_DISPLAYS, "Revert");
+}
+
+
+
+static gboolean
+xfce_displays_helper_refresh_default_scheme (gpointer data)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (data);
+
+    if (priv->default_scheme != NULL)
+        g_hash_table_destroy (priv->default_scheme);
+    priv->default_scheme = xfconf_channel_get_properties (priv->channel, "/" DEFAULT_SCHEME_NAME);
+    priv->default_scheme_dirty = FALSE;
+    priv->default_scheme_id = 0;
+
+    return G_SOURCE_REMOVE;
 }
 
 
 
 static void
-xfce_displays_helper_channel_property_changed (XfconfChannel *channel,
-                                               const gchar *property_name,
-                                               const GValue *value,
-                                               XfceDisplaysHelper *helper)
+xfce_displays_helper_queue_refresh_default_scheme (XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    /* wait for the end of a batch, there is no point in reading it half-written */
+    if (priv->default_scheme_dirty && !priv->in_batch && priv->default_scheme_id == 0)
+        priv->default_scheme_id = g_idle_add (xfce_displays_helper_refresh_default_scheme, helper);
+}
+
+
+
+static void
+xfce_displays_helper_revert (XfceDisplaysHelper *helper,
+                             const gchar *scheme)
 {
-    if (G_UNLIKELY (G_VALUE_HOLDS_STRING (value) && g_strcmp0 (property_name, APPLY_SCHEME_PROP) == 0))
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    XfceDisplaysHelperClass *klass = XFCE_DISPLAYS_HELPER_GET_CLASS (helper);
+    gint64 start_time = g_get_monotonic_time ();
+
+    if (klass->revert != NULL && klass->revert (helper))
     {
-        /* apply */
-        XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, g_value_get_string (value));
-        /* remove the apply property */
-        xfconf_channel_reset_property (channel, APPLY_SCHEME_PROP, FALSE);
+        /* the snapshot was taken while @scheme was active */
+        xfconf_channel_set_string (priv->channel, ACTIVE_PROFILE, scheme);
     }
+    else if (priv->in_batch)
+    {
+        g_free (priv->pending_apply);
+        priv->pending_apply = g_strdup (scheme);
+    }
+    else
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Nothing to revert to, applying %s instead", scheme);
+        klass->channel_apply (helper, scheme);
+    }
+
+    xfsettings_dbg_histogram_add (priv->revert_latency, g_get_monotonic_time () - start_time);
 }
 
 
 
 static void
-xfce_displays_helper_constructed (GObject *object)
+xfce_displays_helper_end_batch (XfceDisplaysHelper *helper)
 {
-    XfceDisplaysHelper *helper = XFCE_DISPLAYS_HELPER (object);
-    XfceDisplaysHelperPrivate *priv = get_instance_private (object);
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
 
-    /* if X11/Wayland impl init suceeded */
-    if (XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->get_outputs (helper) != NULL)
+    priv->in_batch = FALSE;
+    if (priv->batch_timeout_id != 0)
     {
-        gchar *matching_profile;
-        gint mode;
+        g_source_remove (priv->batch_timeout_id);
+        priv->batch_timeout_id = 0;
+    }
+    xfce_displays_helper_queue_refresh_default_scheme (helper);
+
+    /* the profile is complete, apply what was requested meanwhile */
+    if (priv->pending_apply != NULL)
+    {
+        gchar *scheme = g_steal_pointer (&priv->pending_apply);
+        XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, scheme);
+        g_free (scheme);
+    }
+}
 
-#ifdef HAVE_UPOWERGLIB
-        priv->power = g_object_new (XFCE_TYPE_DISPLAYS_UPOWER, NULL);
-        g_signal_connect (G_OBJECT (priv->power),
-                          "lid-changed",
-                          G_CALLBACK (XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->toggle_internal),
-                          helper);
-#endif
 
-        /* open the channel */
-        priv->channel = display_settings_profiles_channel_get ();
 
-        /* remove any leftover apply property before setting the monitor */
-        xfconf_channel_reset_property (priv->channel, APPLY_SCHEME_PROP, FALSE);
+static gboolean
+xfce_displays_helper_batch_timeout (gpointer data)
+{
+    XfceDisplaysHelper *helper = XFCE_DISPLAYS_HELPER (data);
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    /* the writer crashed or was killed, do not defer applies forever */
+    g_warning ("Display profile batch was not finished within %d seconds, ignoring it", PROFILE_BATCH_TIMEOUT);
+    priv->batch_timeout_id = 0;
+    xfce_displays_helper_end_batch (helper);
+    xfconf_channel_reset_property (priv->channel, PROFILE_BATCH_PROP, FALSE);
+
+    return G_SOURCE_REMOVE;
+}
 
-        /* monitor channel changes */
-        g_signal_connect_object (G_OBJECT (priv->channel),
-                                 "property-changed",
-                                 G_CALLBACK (xfce_displays_helper_channel_property_changed),
-                                 helper, G_CONNECT_DEFAULT);
 
-        /*  check if we can auto-enable a profile */
-        matching_profile = xfce_displays_helper_get_matching_profile (helper);
-        mode = xfconf_channel_get_int (priv->channel, AUTO_ENABLE_PROFILES, AUTO_ENABLE_PROFILES_DEFAULT);
-        if (matching_profile != NULL && (mode == AUTO_ENABLE_PROFILES_ON_CONNECT || mode == AUTO_ENABLE_PROFILES_ALWAYS))
+
+static void
+xfce_displays_helper_channel_property_changed (XfconfChannel *channel,
+                                               const gchar *property_name,
+                                               const GValue *value,
+                                               XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    const gchar *tail;
+
+    if (g_str_has_prefix (property_name, "/" DEFAULT_SCHEME_NAME))
+    {
+        tail = property_name + sizeof ("/" DEFAULT_SCHEME_NAME) - 1;
+        if (*tail == '/' || *tail == '\0')
         {
-            XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, matching_profile);
+            priv->default_scheme_dirty = TRUE;
+            xfce_displays_helper_queue_refresh_default_scheme (helper);
+        }
+    }
+    else if (G_UNLIKELY (g_strcmp0 (property_name, PROFILE_BATCH_PROP) == 0))
+    {
+        if (G_VALUE_HOLDS_STRING (value))
+        {
+            /* every batch gets the full timeout */
+            priv->in_batch = TRUE;
+            if (priv->batch_timeout_id != 0)
+                g_source_remove (priv->batch_timeout_id);
+            priv->batch_timeout_id = g_timeout_add_seconds (PROFILE_BATCH_TIMEOUT, xfce_displays_helper_batch_timeout, helper);
+        }
+        else if (priv->in_batch)
+        {
+            xfce_displays_helper_end_batch (helper);
+        }
+    }
+    else if (G_UNLIKELY (G_VALUE_HOLDS_STRING (value) && g_strcmp0 (property_name, APPLY_SCHEME_PROP) == 0))
+    {
+        if (priv->in_batch)
+        {
+            /* do not apply a half-written profile */
+            xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "deferring apply of %s until the profile is written",
+                            g_value_get_string (value));
+            g_free (priv->pending_apply);
+            priv->pending_apply = g_value_dup_string (value);
         }
         else
         {
-            XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, DEFAULT_SCHEME_NAME);
+            /* apply */
+            XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, g_value_get_string (value));
         }
-        g_free (matching_profile);
+
+        /* remove the apply property */
+        xfconf_channel_reset_property (channel, APPLY_SCHEME_PROP, FALSE);
+    }
+    else if (G_UNLIKELY (G_VALUE_HOLDS_STRING (value) && g_strcmp0 (property_name, REVERT_SCHEME_PROP) == 0))
+    {
+        xfce_displays_helper_revert (helper, g_value_get_string (value));
+        xfconf_channel_reset_property (channel, REVERT_SCHEME_PROP, FALSE);
     }
+}
+
+
+
+static void
+xfce_displays_helper_constructed (GObject *object)
+{
+    xfce_displays_helper_outputs_ready (XFCE_DISPLAYS_HELPER (object));
 
     G_OBJECT_CLASS (xfce_displays_helper_parent_class)->constructed (object);
 }
@@ -155,11 +300,23 @@ xfce_displays_helper_constructed (GObject *object)
 static void
 xfce_displays_helper_finalize (GObject *object)
 {
-#ifdef HAVE_UPOWERGLIB
     XfceDisplaysHelperPrivate *priv = get_instance_private (object);
+
+#ifdef HAVE_UPOWERGLIB
     if (priv->power != NULL)
         g_object_unref (priv->power);
 #endif
+    g_free (priv->pending_apply);
+    if (priv->batch_timeout_id != 0)
+        g_source_remove (priv->batch_timeout_id);
+    if (priv->default_scheme_id != 0)
+        g_source_remove (priv->default_scheme_id);
+    if (priv->default_scheme != NULL)
+        g_hash_table_destroy (priv->default_scheme);
+    if (priv->popup != NULL)
+        gtk_widget_destroy (priv->popup);
+    xfsettings_dbg_histogram_free (priv->popup_latency);
+    xfsettings_dbg_histogram_free (priv->revert_latency);
 
     G_OBJECT_CLASS (xfce_displays_helper_parent_class)->finalize (object);
 }
@@ -169,6 +326,10 @@ xfce_displays_helper_finalize (GObject *object)
 GObject *
 xfce_displays_helper_new (void)
 {
+#ifdef ENABLE_DISPLAY_MOCK
+    if (display_mock_enabled ())
+        return g_object_new (XFCE_TYPE_DISPLAYS_HELPER_MOCK, NULL);
+#endif
 #ifdef HAVE_XRANDR
     if (GDK_IS_X11_DISPLAY (gdk_display_get_default ()))
         return g_object_new (XFCE_TYPE_DISPLAYS_HELPER_X11, NULL);
@@ -242,3 +403,554 @@ xfce_displays_helper_get_channel (XfceDisplaysHelper *helper)
 {
     return get_instance_private (helper)->channel;
 }
+
+
+
+/**
+ * xfce_displays_helper_get_default_scheme:
+ * @helper: a #XfceDisplaysHelper.
+ *
+ * The properties of the Default scheme, as returned by
+ * xfconf_channel_get_properties(). They are read again in an idle callback
+ * whenever the scheme changes, so lid events do not have to wait for xfconf.
+ *
+ * Returns: the properties, owned by @helper, or %NULL if there are none.
+ **/
+GHashTable *
+xfce_displays_helper_get_default_scheme (XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    if (priv->default_scheme_dirty)
+    {
+        if (priv->default_scheme_id != 0)
+            g_source_remove (priv->default_scheme_id);
+        xfce_displays_helper_refresh_default_scheme (helper);
+    }
+
+    return priv->default_scheme;
+}
+
+
+
+void
+xfce_displays_helper_set_dry_run (gboolean dry_run)
+{
+    xfsettingsd_displays_dry_run = dry_run;
+}
+
+
+
+gboolean
+xfce_displays_helper_get_dry_run (void)
+{
+    return xfsettingsd_displays_dry_run;
+}
+
+
+
+XfceDisplaysLayoutOutput *
+xfce_displays_layout_output_new (const gchar *name,
+                                 const gchar *friendly_name,
+                                 const gchar *edid)
+{
+    XfceDisplaysLayoutOutput *output = g_new0 (XfceDisplaysLayoutOutput, 1);
+
+    output->name = g_strdup (name);
+    output->friendly_name = g_strdup (friendly_name != NULL ? friendly_name : name);
+    output->edid = g_strdup (edid);
+    output->modes = g_array_new (FALSE, FALSE, sizeof (XfceDisplaysLayoutMode));
+
+    return output;
+}
+
+
+
+void
+xfce_displays_layout_output_add_mode (XfceDisplaysLayoutOutput *output,
+                                      guint width,
+                                      guint height,
+                                      gdouble rate)
+{
+    XfceDisplaysLayoutMode mode = { width, height, rate };
+
+    g_array_append_val (output->modes, mode);
+}
+
+
+
+void
+xfce_displays_layout_output_free (XfceDisplaysLayoutOutput *output)
+{
+    g_free (output->name);
+    g_free (output->friendly_name);
+    g_free (output->edid);
+    g_array_free (output->modes, TRUE);
+    g_free (output);
+}
+
+
+
+/* the largest resolution both outputs support, at the first rate listed for it */
+static gboolean
+xfce_displays_layout_find_mirror_modes (XfceDisplaysLayoutOutput *first,
+                                        XfceDisplaysLayoutOutput *second,
+                                        const XfceDisplaysLayoutMode **first_mode,
+                                        const XfceDisplaysLayoutMode **second_mode)
+{
+    guint best_area = 0;
+
+    for (guint i = 0; i < first->modes->len; i++)
+    {
+        const XfceDisplaysLayoutMode *mode = &g_array_index (first->modes, XfceDisplaysLayoutMode, i);
+
+        if (mode->width * mode->height <= best_area)
+            continue;
+
+        for (guint j = 0; j < second->modes->len; j++)
+        {
+            const XfceDisplaysLayoutMode *other = &g_array_index (second->modes, XfceDisplaysLayoutMode, j);
+
+            if (other->width == mode->width && other->height == mode->height)
+            {
+                *first_mode = mode;
+                *second_mode = other;
+                best_area = mode->width * mode->height;
+                break;
+            }
+        }
+    }
+
+    return best_area > 0;
+}
+
+
+
+/* Write @layout of the two @outputs to the Default scheme and have it applied,
+ * like the minimal dialog does. */
+static void
+xfce_displays_helper_apply_layout (XfceDisplaysHelper *helper,
+                                   GPtrArray *outputs,
+                                   XfceDisplaysLayout layout)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    XfceDisplaysLayoutOutput *first = g_ptr_array_index (outputs, 0);
+    XfceDisplaysLayoutOutput *second = g_ptr_array_index (outputs, 1);
+    const XfceDisplaysLayoutMode *modes[2];
+    DisplayProfileWriter *writer;
+    gboolean duplicate = g_strcmp0 (first->edid, second->edid) == 0;
+    guint primary = layout == LAYOUT_ONLY_SECOND ? 1 : 0;
+    gint x = 0;
+
+    if (layout == LAYOUT_MIRROR)
+    {
+        if (!xfce_displays_layout_find_mirror_modes (first, second, &modes[0], &modes[1]))
+            return;
+    }
+    else
+    {
+        modes[0] = &g_array_index (first->modes, XfceDisplaysLayoutMode, 0);
+        modes[1] = &g_array_index (second->modes, XfceDisplaysLayoutMode, 0);
+    }
+
+    writer = display_profile_writer_new (priv->channel, "/" DEFAULT_SCHEME_NAME, TRUE);
+    for (guint n = 0; n < 2; n++)
+    {
+        XfceDisplaysLayoutOutput *output = g_ptr_array_index (outputs, n);
+        gboolean active = (layout != LAYOUT_ONLY_FIRST || n == 0) && (layout != LAYOUT_ONLY_SECOND || n == 1);
+        gchar *property, *resolution;
+
+        property = g_strdup_printf (OUTPUT_FMT, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_string (writer, property, output->friendly_name);
+        g_free (property);
+
+        property = g_strdup_printf (OUTPUT_FMT "/EDID", DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_string (writer, property, output->edid);
+        g_free (property);
+
+        property = g_strdup_printf (DUPLICATE_EDID_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_bool (writer, property, duplicate);
+        g_free (property);
+
+        property = g_strdup_printf (ACTIVE_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_bool (writer, property, active);
+        g_free (property);
+
+        if (!active)
+            continue;
+
+        property = g_strdup_printf (RESOLUTION_PROP, DEFAULT_SCHEME_NAME, output->name);
+        resolution = g_strdup_printf ("%ux%u", modes[n]->width, modes[n]->height);
+        display_profile_writer_set_string (writer, property, resolution);
+        g_free (resolution);
+        g_free (property);
+
+        property = g_strdup_printf (RRATE_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_double (writer, property, modes[n]->rate);
+        g_free (property);
+
+        property = g_strdup_printf (ROTATION_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_int (writer, property, 0);
+        g_free (property);
+
+        property = g_strdup_printf (REFLECTION_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_string (writer, property, "0");
+        g_free (property);
+
+        property = g_strdup_printf (SCALE_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_double (writer, property, 1.0);
+        g_free (property);
+
+        property = g_strdup_printf (POSX_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_int (writer, property, x);
+        g_free (property);
+
+        property = g_strdup_printf (POSY_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_int (writer, property, 0);
+        g_free (property);
+
+        property = g_strdup_printf (PRIMARY_PROP, DEFAULT_SCHEME_NAME, output->name);
+        display_profile_writer_set_bool (writer, property, n == primary);
+        g_free (property);
+
+        /* the second output goes on the right of the first one */
+        if (layout == LAYOUT_EXTEND)
+            x += modes[n]->width;
+    }
+
+    /* applied by our own property handler once the batch is written */
+    display_profile_writer_apply (writer, DEFAULT_SCHEME_NAME);
+    display_profile_writer_commit (writer);
+}
+
+
+
+static void
+xfce_displays_helper_popup_layout_clicked (GtkButton *button,
+                                           XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    GPtrArray *outputs = g_object_get_data (G_OBJECT (priv->popup), "layout-outputs");
+    XfceDisplaysLayout layout = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (button), "layout"));
+
+    xfce_displays_helper_apply_layout (helper, outputs, layout);
+    gtk_widget_destroy (priv->popup);
+}
+
+
+
+static void
+xfce_displays_helper_popup_profile_clicked (GtkButton *button,
+                                            XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    const gchar *profile = g_object_get_data (G_OBJECT (button), "profile");
+
+    /* applied by our own property handler, like from the dialog */
+    xfconf_channel_set_string (priv->channel, APPLY_SCHEME_PROP, profile);
+    gtk_widget_destroy (priv->popup);
+}
+
+
+
+static void
+xfce_displays_helper_popup_more_clicked (GtkButton *button,
+                                         XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    gtk_widget_destroy (priv->popup);
+    xfce_spawn_command_line (NULL, "xfce4-display-settings", FALSE, FALSE, TRUE, NULL);
+}
+
+
+
+static gboolean
+xfce_displays_helper_popup_key_press (GtkWidget *popup,
+                                      GdkEventKey *event,
+                                      gpointer user_data)
+{
+    if (event->keyval != GDK_KEY_Escape)
+        return FALSE;
+
+    gtk_widget_destroy (popup);
+    return TRUE;
+}
+
+
+
+static gboolean
+xfce_displays_helper_popup_drawn (GtkWidget *popup,
+                                  cairo_t *cr,
+                                  XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+
+    g_signal_handlers_disconnect_by_func (popup, xfce_displays_helper_popup_drawn, helper);
+    xfsettings_dbg_histogram_add (priv->popup_latency, g_get_monotonic_time () - priv->popup_hotplug_time);
+
+    return FALSE;
+}
+
+
+
+static GtkWidget *
+xfce_displays_helper_popup_layout_button (XfceDisplaysHelper *helper,
+                                          const gchar *label,
+                                          const gchar *icon_name,
+                                          XfceDisplaysLayout layout)
+{
+    GtkWidget *button, *image;
+
+    image = gtk_image_new_from_icon_name (icon_name, GTK_ICON_SIZE_DIALOG);
+    gtk_image_set_pixel_size (GTK_IMAGE (image), 64);
+
+    button = gtk_button_new_with_label (label);
+    gtk_button_set_image (GTK_BUTTON (button), image);
+    gtk_button_set_image_position (GTK_BUTTON (button), GTK_POS_TOP);
+    gtk_button_set_always_show_image (GTK_BUTTON (button), TRUE);
+    g_object_set_data (G_OBJECT (button), "layout", GINT_TO_POINTER (layout));
+    g_signal_connect (button, "clicked", G_CALLBACK (xfce_displays_helper_popup_layout_clicked), helper);
+
+    return button;
+}
+
+
+
+/* two outputs with modes, that the layout buttons can arrange */
+static GPtrArray *
+xfce_displays_helper_get_layout_outputs (XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperClass *klass = XFCE_DISPLAYS_HELPER_GET_CLASS (helper);
+    GPtrArray *outputs;
+
+    if (klass->get_layout_outputs == NULL)
+        return NULL;
+
+    outputs = klass->get_layout_outputs (helper);
+    if (outputs == NULL)
+        return NULL;
+
+    if (outputs->len != 2
+        || ((XfceDisplaysLayoutOutput *) g_ptr_array_index (outputs, 0))->modes->len == 0
+        || ((XfceDisplaysLayoutOutput *) g_ptr_array_index (outputs, 1))->modes->len == 0)
+    {
+        g_ptr_array_unref (outputs);
+        return NULL;
+    }
+
+    return outputs;
+}
+
+
+
+static gboolean
+xfce_displays_helper_popup_show (XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    gchar **display_infos = XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->get_display_infos (helper);
+    GPtrArray *outputs = xfce_displays_helper_get_layout_outputs (helper);
+    GList *profiles = NULL;
+    GtkWidget *box, *layout_box, *button_box, *label, *button;
+
+    if (display_infos != NULL)
+    {
+        profiles = display_settings_get_profiles (display_infos, priv->channel, TRUE);
+        g_strfreev (display_infos);
+    }
+
+    /* nothing to offer, the display dialog has to be launched */
+    if (profiles == NULL && outputs == NULL)
+        return FALSE;
+
+    if (priv->popup != NULL)
+        gtk_widget_destroy (priv->popup);
+
+    priv->popup = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+    g_signal_connect (priv->popup, "destroy", G_CALLBACK (gtk_widget_destroyed), &priv->popup);
+    g_signal_connect (priv->popup, "key-press-event", G_CALLBACK (xfce_displays_helper_popup_key_press), NULL);
+    g_signal_connect_after (priv->popup, "draw", G_CALLBACK (xfce_displays_helper_popup_drawn), helper);
+    gtk_window_set_title (GTK_WINDOW (priv->popup), _("Display"));
+    gtk_window_set_icon_name (GTK_WINDOW (priv->popup), "org.xfce.settings.display");
+    gtk_window_set_type_hint (GTK_WINDOW (priv->popup), GDK_WINDOW_TYPE_HINT_DIALOG);
+    gtk_window_set_position (GTK_WINDOW (priv->popup), GTK_WIN_POS_CENTER);
+    gtk_window_set_keep_above (GTK_WINDOW (priv->popup), TRUE);
+    gtk_window_set_resizable (GTK_WINDOW (priv->popup), FALSE);
+    gtk_container_set_border_width (GTK_CONTAINER (priv->popup), 12);
+
+    box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 6);
+    gtk_container_add (GTK_CONTAINER (priv->popup), box);
+
+    if (outputs != NULL)
+    {
+        XfceDisplaysLayoutOutput *first = g_ptr_array_index (outputs, 0);
+        XfceDisplaysLayoutOutput *second = g_ptr_array_index (outputs, 1);
+        const XfceDisplaysLayoutMode *first_mode, *second_mode;
+        gchar *text;
+
+        /* the layout buttons apply to these outputs, even if others come in meanwhile */
+        g_object_set_data_full (G_OBJECT (priv->popup), "layout-outputs", outputs, (GDestroyNotify) g_ptr_array_unref);
+
+        label = gtk_label_new (_("Choose how to use the connected displays:"));
+        gtk_label_set_xalign (GTK_LABEL (label), 0.0);
+        gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+
+        layout_box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+        gtk_box_set_homogeneous (GTK_BOX (layout_box), TRUE);
+        gtk_box_pack_start (GTK_BOX (box), layout_box, FALSE, FALSE, 0);
+
+        text = g_strdup_printf (_("Only %s (1)"), first->friendly_name);
+        button = xfce_displays_helper_popup_layout_button (helper, text, "xfce-display-left", LAYOUT_ONLY_FIRST);
+        gtk_container_add (GTK_CONTAINER (layout_box), button);
+        g_free (text);
+
+        button = xfce_displays_helper_popup_layout_button (helper, _("Mirror Displays"), "xfce-display-mirror", LAYOUT_MIRROR);
+        gtk_widget_set_sensitive (button, xfce_displays_layout_find_mirror_modes (first, second, &first_mode, &second_mode));
+        gtk_container_add (GTK_CONTAINER (layout_box), button);
+
+        button = xfce_displays_helper_popup_layout_button (helper, _("Extend right"), "xfce-display-extend-right", LAYOUT_EXTEND);
+        gtk_container_add (GTK_CONTAINER (layout_box), button);
+
+        text = g_strdup_printf (_("Only %s (2)"), second->friendly_name);
+        button = xfce_displays_helper_popup_layout_button (helper, text, "xfce-display-right", LAYOUT_ONLY_SECOND);
+        gtk_container_add (GTK_CONTAINER (layout_box), button);
+        g_free (text);
+    }
+
+    if (profiles != NULL)
+    {
+        label = gtk_label_new (_("Choose a profile for the connected displays:"));
+        gtk_label_set_xalign (GTK_LABEL (label), 0.0);
+        gtk_widget_set_margin_top (label, outputs != NULL ? 6 : 0);
+        gtk_box_pack_start (GTK_BOX (box), label, FALSE, FALSE, 0);
+    }
+
+    for (GList *lp = profiles; lp != NULL; lp = lp->next)
+    {
+        gchar *name = display_settings_profile_get_name (lp->data, priv->channel);
+
+        button = gtk_button_new_with_label (name != NULL ? name : lp->data);
+        g_object_set_data_full (G_OBJECT (button), "profile", g_strdup (lp->data), g_free);
+        g_signal_connect (button, "clicked", G_CALLBACK (xfce_displays_helper_popup_profile_clicked), helper);
+        gtk_box_pack_start (GTK_BOX (box), button, FALSE, FALSE, 0);
+        g_free (name);
+    }
+    g_list_free_full (profiles, g_free);
+
+    button_box = gtk_button_box_new (GTK_ORIENTATION_HORIZONTAL);
+    gtk_button_box_set_layout (GTK_BUTTON_BOX (button_box), GTK_BUTTONBOX_END);
+    gtk_box_set_spacing (GTK_BOX (button_box), 6);
+    gtk_widget_set_margin_top (button_box, 6);
+    gtk_box_pack_end (GTK_BOX (box), button_box, FALSE, FALSE, 0);
+
+    button = gtk_button_new_with_mnemonic (_("_More Options…"));
+    g_signal_connect (button, "clicked", G_CALLBACK (xfce_displays_helper_popup_more_clicked), helper);
+    gtk_container_add (GTK_CONTAINER (button_box), button);
+
+    button = gtk_button_new_with_mnemonic (_("_Close"));
+    g_signal_connect_swapped (button, "clicked", G_CALLBACK (gtk_widget_destroy), priv->popup);
+    gtk_container_add (GTK_CONTAINER (button_box), button);
+
+    gtk_widget_show_all (box);
+    gtk_window_present (GTK_WINDOW (priv->popup));
+
+    return TRUE;
+}
+
+
+
+/**
+ * xfce_displays_helper_show_dialog:
+ * @helper: the #XfceDisplaysHelper.
+ * @n_outputs: the number of connected outputs.
+ * @hotplug_time: monotonic time the new output was noticed, or 0 for now.
+ *
+ * Let the user choose what to do with a newly connected output. When at most
+ * two outputs are connected, the choice is offered right away from the
+ * daemon: the layouts of the minimal dialog if the backend can list the
+ * outputs, and the profiles matching them. Otherwise the display dialog is
+ * launched, in minimal mode for up to two outputs.
+ **/
+void
+xfce_displays_helper_show_dialog (XfceDisplaysHelper *helper,
+                                  guint n_outputs,
+                                  gint64 hotplug_time)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    const gchar *cmd = n_outputs <= 2 ? "xfce4-display-settings -m" : "xfce4-display-settings";
+
+    priv->popup_hotplug_time = hotplug_time != 0 ? hotplug_time : g_get_monotonic_time ();
+
+    if (n_outputs <= 2 && xfce_displays_helper_popup_show (helper))
+    {
+        xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Showing the display profiles popup");
+        return;
+    }
+
+    xfce_spawn_command_line (NULL, cmd, FALSE, FALSE, TRUE, NULL);
+    xfsettings_dbg (XFSD_DEBUG_DISPLAYS, "Launched \"%s\" %.1f ms after hotplug", cmd,
+                    (g_get_monotonic_time () - priv->popup_hotplug_time) / 1000.0);
+}
+
+
+
+/**
+ * xfce_displays_helper_outputs_ready:
+ * @helper: a #XfceDisplaysHelper.
+ *
+ * Start managing the displays. This is done at construction, implementations
+ * that learn about their outputs later call it again once get_outputs()
+ * returns non-%NULL.
+ **/
+void
+xfce_displays_helper_outputs_ready (XfceDisplaysHelper *helper)
+{
+    XfceDisplaysHelperPrivate *priv = get_instance_private (helper);
+    gchar *matching_profile;
+    gint mode;
+
+    /* not yet, X11/Wayland impl init failed, or already done */
+    if (XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->get_outputs (helper) == NULL || priv->channel != NULL)
+        return;
+
+#ifdef HAVE_UPOWERGLIB
+    priv->power = g_object_new (XFCE_TYPE_DISPLAYS_UPOWER, NULL);
+    g_signal_connect (G_OBJECT (priv->power),
+                      "lid-changed",
+                      G_CALLBACK (XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->toggle_internal),
+                      helper);
+#endif
+
+    /* open the channel */
+    priv->channel = display_settings_profiles_channel_get ();
+
+    /* remove any leftover apply, revert or batch property before setting the monitor */
+    xfconf_channel_reset_property (priv->channel, APPLY_SCHEME_PROP, FALSE);
+    xfconf_channel_reset_property (priv->channel, REVERT_SCHEME_PROP, FALSE);
+    xfconf_channel_reset_property (priv->channel, PROFILE_BATCH_PROP, FALSE);
+
+    /* read the Default scheme once, it is kept up to date from now on */
+    xfce_displays_helper_refresh_default_scheme (helper);
+
+    /* the same for the profiles, they are needed right below */
+    display_settings_profiles_load (priv->channel);
+
+    /* monitor channel changes */
+    g_signal_connect_object (G_OBJECT (priv->channel),
+                             "property-changed",
+                             G_CALLBACK (xfce_displays_helper_channel_property_changed),
+                             helper, G_CONNECT_DEFAULT);
+
+    /*  check if we can auto-enable a profile */
+    matching_profile = xfce_displays_helper_get_matching_profile (helper);
+    mode = xfconf_channel_get_int (priv->channel, AUTO_ENABLE_PROFILES, AUTO_ENABLE_PROFILES_DEFAULT);
+    if (matching_profile != NULL && (mode == AUTO_ENABLE_PROFILES_ON_CONNECT || mode == AUTO_ENABLE_PROFILES_ALWAYS))
+    {
+        XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, matching_profile);
+    }
+    else
+    {
+        XFCE_DISPLAYS_HELPER_GET_CLASS (helper)->channel_apply (helper, DEFAULT_SCHEME_NAME);
+    }
+    g_free (matching_profile);
+}
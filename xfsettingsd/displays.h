@@ -25,6 +25,7 @@
 
 /* Xfconf properties */
 #define APPLY_SCHEME_PROP "/Schemes/Apply"
+#define REVERT_SCHEME_PROP "/Schemes/Revert"
 #define DEFAULT_SCHEME_NAME "Default"
 #define ACTIVE_PROFILE "/ActiveProfile"
 #define AUTO_ENABLE_PROFILES "/AutoEnableProfiles"
@@ -42,6 +43,7 @@
 #define POSX_PROP OUTPUT_FMT "/Position/X"
 #define POSY_PROP OUTPUT_FMT "/Position/Y"
 #define NOTIFY_PROP "/Notify"
+#define SETTLE_TIME_PROP "/SettleTime"
 
 /* some messages belonging to parts of code common to X11/Wayland implementations
  * that are not easy to share in the parent class */
@@ -59,6 +61,24 @@
 
 G_BEGIN_DECLS
 
+/* what the popup shown when an output is connected needs to lay it out */
+typedef struct _XfceDisplaysLayoutMode
+{
+    guint width;
+    guint height;
+    gdouble rate;
+} XfceDisplaysLayoutMode;
+
+typedef struct _XfceDisplaysLayoutOutput
+{
+    gchar *name;
+    gchar *friendly_name;
+    gchar *edid;
+
+    /* XfceDisplaysLayoutMode, the preferred one first */
+    GArray *modes;
+} XfceDisplaysLayoutOutput;
+
 #define XFCE_TYPE_DISPLAYS_HELPER (xfce_displays_helper_get_type ())
 G_DECLARE_DERIVABLE_TYPE (XfceDisplaysHelper, xfce_displays_helper, XFCE, DISPLAYS_HELPER, GObject)
 
@@ -73,6 +93,14 @@ struct _XfceDisplaysHelperClass
     gchar **(*get_display_infos) (XfceDisplaysHelper *helper);
     void (*channel_apply) (XfceDisplaysHelper *helper,
                            const gchar *scheme);
+
+    /* optional, restores the configuration from before the last channel_apply(),
+     * returns FALSE if that is not possible anymore */
+    gboolean (*revert) (XfceDisplaysHelper *helper);
+
+    /* optional, the connected outputs as XfceDisplaysLayoutOutput, so that the
+     * popup can offer to mirror or extend them */
+    GPtrArray *(*get_layout_outputs) (XfceDisplaysHelper *helper);
 };
 
 GObject *
@@ -81,6 +109,32 @@ gchar *
 xfce_displays_helper_get_matching_profile (XfceDisplaysHelper *helper);
 XfconfChannel *
 xfce_displays_helper_get_channel (XfceDisplaysHelper *helper);
+GHashTable *
+xfce_displays_helper_get_default_scheme (XfceDisplaysHelper *helper);
+void
+xfce_displays_helper_outputs_ready (XfceDisplaysHelper *helper);
+void
+xfce_displays_helper_show_dialog (XfceDisplaysHelper *helper,
+                                  guint n_outputs,
+                                  gint64 hotplug_time);
+
+XfceDisplaysLayoutOutput *
+xfce_displays_layout_output_new (const gchar *name,
+                                 const gchar *friendly_name,
+                                 const gchar *edid);
+void
+xfce_displays_layout_output_add_mode (XfceDisplaysLayoutOutput *output,
+                                      guint width,
+                                      guint height,
+                                      gdouble rate);
+void
+xfce_displays_layout_output_free (XfceDisplaysLayoutOutput *output);
+
+/* print the planned display changes instead of applying them */
+void
+xfce_displays_helper_set_dry_run (gboolean dry_run);
+gboolean
+xfce_displays_helper_get_dry_run (void);
 
 G_END_DECLS
 
@@ -18,6 +18,7 @@
  */
 
 #include "keyboard-shortcuts.h"
+#include "launcher.h"
 
 #include "common/debug.h"
 
@@ -44,6 +45,8 @@ enum
 static void
 xfce_keyboard_shortcuts_helper_finalize (GObject *object);
 static void
+xfce_shortcut_launch_free (gpointer data);
+static void
 xfce_keyboard_shortcuts_helper_shortcut_added (XfceShortcutsProvider *provider,
                                                const gchar *shortcut,
                                                XfceKeyboardShortcutsHelper *helper);
@@ -67,8 +70,36 @@ struct _XfceKeyboardShortcutsHelper
 
     XfceShortcutsGrabber *grabber;
     XfceShortcutsProvider *provider;
+
+    /* shortcut string => XfceShortcutLaunch, so activating a shortcut
+     * does not need an xfconf lookup nor a command line parse */
+    GHashTable *launches;
+
+    /* key press to spawn latency, only recorded when debugging */
+    XfsdDebugHistogram *latency;
 };
 
+typedef struct _XfceShortcutLaunch
+{
+    gchar *command;
+    gchar **argv;
+    gboolean snotify;
+
+    /* only used to get a startup notification id, created on demand */
+    GAppInfo *app_info;
+} XfceShortcutLaunch;
+
+typedef struct _XfceShortcutSpawn
+{
+    gchar *shortcut;
+    gchar *startup_id;
+    GAppLaunchContext *context;
+
+    /* to record the latency once the launcher reported back */
+    XfceKeyboardShortcutsHelper *helper;
+    gint64 start_time;
+} XfceShortcutSpawn;
+
 
 
 G_DEFINE_FINAL_TYPE (XfceKeyboardShortcutsHelper, xfce_keyboard_shortcuts_helper, G_TYPE_OBJECT)
@@ -102,6 +133,9 @@ xfce_keyboard_shortcuts_helper_init (XfceKeyboardShortcutsHelper *helper)
     g_signal_connect (helper->provider, "shortcut-added", G_CALLBACK (xfce_keyboard_shortcuts_helper_shortcut_added), helper);
     g_signal_connect (helper->provider, "shortcut-removed", G_CALLBACK (xfce_keyboard_shortcuts_helper_shortcut_removed), helper);
 
+    helper->launches = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, xfce_shortcut_launch_free);
+    helper->latency = xfsettings_dbg_histogram_new (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "activation latency");
+
     xfce_keyboard_shortcuts_helper_load_shortcuts (helper);
 }
 
@@ -118,19 +152,68 @@ xfce_keyboard_shortcuts_helper_finalize (GObject *object)
     /* Free shortcuts grabber */
     g_object_unref (helper->grabber);
 
+    g_hash_table_destroy (helper->launches);
+    xfsettings_dbg_histogram_free (helper->latency);
+
     (*G_OBJECT_CLASS (xfce_keyboard_shortcuts_helper_parent_class)->finalize) (object);
 }
 
 
 
+static void
+xfce_shortcut_launch_free (gpointer data)
+{
+    XfceShortcutLaunch *launch = data;
+
+    g_free (launch->command);
+    g_strfreev (launch->argv);
+    if (launch->app_info != NULL)
+        g_object_unref (launch->app_info);
+    g_free (launch);
+}
+
+
+
+static void
+xfce_keyboard_shortcuts_helper_cache_launch (XfceKeyboardShortcutsHelper *helper,
+                                             XfceShortcut *sc)
+{
+    XfceShortcutLaunch *launch;
+
+    launch = g_new0 (XfceShortcutLaunch, 1);
+    launch->command = g_strdup (sc->command);
+    launch->snotify = sc->snotify;
+
+    /* Handle the argv ourselfs, because xfce_spawn_command_line() does
+     * not accept a custom timestamp for startup notification. If parsing
+     * fails, argv stays NULL and the error is reported on activation */
+    if (sc->command != NULL)
+        g_shell_parse_argv (sc->command, NULL, &launch->argv, NULL);
+
+    g_hash_table_replace (helper->launches, g_strdup (sc->shortcut), launch);
+}
+
+
+
 static void
 xfce_keyboard_shortcuts_helper_shortcut_added (XfceShortcutsProvider *provider,
                                                const gchar *shortcut,
                                                XfceKeyboardShortcutsHelper *helper)
 {
+    XfceShortcut *sc;
+
     g_return_if_fail (XFCE_IS_KEYBOARD_SHORTCUTS_HELPER (helper));
     xfce_shortcuts_grabber_add (helper->grabber, shortcut);
 
+    /* The signal is also emitted when the command of an existing
+     * shortcut changes, so always refresh the cached entry */
+    sc = xfce_shortcuts_provider_get_shortcut (provider, shortcut);
+    if (G_LIKELY (sc != NULL))
+    {
+        xfce_keyboard_shortcuts_helper_cache_launch (helper, sc);
+        xfce_shortcut_free (sc);
+    }
+
     xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "add \"%s\"", shortcut);
 }
 
@@ -143,6 +226,7 @@ xfce_keyboard_shortcuts_helper_shortcut_removed (XfceShortcutsProvider *provider
 {
     g_return_if_fail (XFCE_IS_KEYBOARD_SHORTCUTS_HELPER (helper));
     xfce_shortcuts_grabber_remove (helper->grabber, shortcut);
+    g_hash_table_remove (helper->launches, shortcut);
 
     xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "remove \"%s\"", shortcut);
 }
@@ -157,6 +241,7 @@ _xfce_keyboard_shortcuts_helper_load_shortcut (XfceShortcut *shortcut,
     g_return_if_fail (XFCE_IS_KEYBOARD_SHORTCUTS_HELPER (helper));
 
     xfce_shortcuts_grabber_add (helper->grabber, shortcut->shortcut);
+    xfce_keyboard_shortcuts_helper_cache_launch (helper, shortcut);
 
     xfsettings_dbg_filtered (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "loaded \"%s\" => \"%s\"",
                              shortcut->shortcut, shortcut->command);
@@ -172,6 +257,7 @@ xfce_keyboard_shortcuts_helper_load_shortcuts (XfceKeyboardShortcutsHelper *help
     g_return_if_fail (XFCE_IS_KEYBOARD_SHORTCUTS_HELPER (helper));
 
     /* Load shortcuts one by one */
+    g_hash_table_remove_all (helper->launches);
     shortcuts = xfce_shortcuts_provider_get_shortcuts (helper->provider);
     g_list_foreach (shortcuts, (GFunc) _xfce_keyboard_shortcuts_helper_load_shortcut, helper);
     xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "%d shortcuts loaded", g_list_length (shortcuts));
@@ -180,28 +266,141 @@ xfce_keyboard_shortcuts_helper_load_shortcuts (XfceKeyboardShortcutsHelper *help
 
 
 
+static void
+xfce_shortcut_spawn_free (XfceShortcutSpawn *spawn)
+{
+    if (spawn->context != NULL)
+        g_object_unref (spawn->context);
+    g_object_unref (spawn->helper);
+    g_free (spawn->startup_id);
+    g_free (spawn->shortcut);
+    g_free (spawn);
+}
+
+
+
+static void
+xfce_keyboard_shortcuts_helper_spawned (const GError *error,
+                                        gpointer user_data)
+{
+    XfceShortcutSpawn *spawn = user_data;
+
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        /* the launcher went away, the command may or may not have run */
+        if (spawn->startup_id != NULL)
+            g_app_launch_context_launch_failed (spawn->context, spawn->startup_id);
+        xfce_shortcut_spawn_free (spawn);
+        return;
+    }
+
+    xfsettings_dbg_histogram_add (spawn->helper->latency, g_get_monotonic_time () - spawn->start_time);
+
+    if (error != NULL)
+    {
+        if (spawn->startup_id != NULL)
+            g_app_launch_context_launch_failed (spawn->context, spawn->startup_id);
+
+        xfce_dialog_show_error (NULL, error, _("Failed to launch shortcut \"%s\""), spawn->shortcut);
+    }
+
+    xfce_shortcut_spawn_free (spawn);
+}
+
+
+
+static gboolean
+xfce_keyboard_shortcuts_helper_spawn_launcher (XfceKeyboardShortcutsHelper *helper,
+                                               const gchar *shortcut,
+                                               XfceShortcutLaunch *launch,
+                                               gint timestamp,
+                                               gint64 start_time)
+{
+    XfceShortcutSpawn *spawn;
+    GdkAppLaunchContext *context;
+    GdkScreen *screen;
+    GdkDisplay *display;
+    gchar **envp;
+    gboolean succeed;
+
+    if (!xfce_launcher_is_running ())
+        return FALSE;
+
+    screen = xfce_gdk_screen_get_active (NULL);
+    display = gdk_screen_get_display (screen);
+
+    spawn = g_new0 (XfceShortcutSpawn, 1);
+    spawn->shortcut = g_strdup (shortcut);
+    spawn->helper = g_object_ref (helper);
+    spawn->start_time = start_time;
+
+    /* the launcher was forked before the display was opened, so pass
+     * on the environment of the daemon, like xfce_spawn() would */
+    envp = g_get_environ ();
+    envp = g_environ_setenv (envp, "DISPLAY", gdk_display_get_name (display), TRUE);
+    envp = g_environ_unsetenv (envp, "DESKTOP_STARTUP_ID");
+
+    if (launch->snotify)
+    {
+        if (launch->app_info == NULL)
+            launch->app_info = g_app_info_create_from_commandline (launch->command, NULL,
+                                                                   G_APP_INFO_CREATE_SUPPORTS_STARTUP_NOTIFICATION,
+                                                                   NULL);
+
+        if (launch->app_info != NULL)
+        {
+            context = gdk_display_get_app_launch_context (display);
+            gdk_app_launch_context_set_screen (context, screen);
+            gdk_app_launch_context_set_timestamp (context, timestamp);
+            spawn->context = G_APP_LAUNCH_CONTEXT (context);
+
+            spawn->startup_id = g_app_launch_context_get_startup_notify_id (spawn->context, launch->app_info, NULL);
+            if (spawn->startup_id != NULL)
+                envp = g_environ_setenv (envp, "DESKTOP_STARTUP_ID", spawn->startup_id, TRUE);
+        }
+    }
+
+    succeed = xfce_launcher_spawn (launch->argv, envp, xfce_keyboard_shortcuts_helper_spawned, spawn);
+    if (!succeed)
+    {
+        if (spawn->startup_id != NULL)
+            g_app_launch_context_launch_failed (spawn->context, spawn->startup_id);
+        xfce_shortcut_spawn_free (spawn);
+    }
+
+    g_strfreev (envp);
+
+    return succeed;
+}
+
+
+
 static void
 xfce_keyboard_shortcuts_helper_shortcut_activated (XfceShortcutsGrabber *grabber,
                                                    const gchar *shortcut,
                                                    gint timestamp,
                                                    XfceKeyboardShortcutsHelper *helper)
 {
-    XfceShortcut *sc;
+    XfceShortcutLaunch *launch;
     GError *error = NULL;
-    gchar **argv;
+    gchar **argv = NULL;
     gboolean succeed;
+    gint64 start_time;
+
+    /* the grabber emits this from its event filter, so this is when the
+     * key press was received */
+    start_time = g_get_monotonic_time ();
 
     g_return_if_fail (XFCE_IS_KEYBOARD_SHORTCUTS_HELPER (helper));
-    g_return_if_fail (XFCE_IS_SHORTCUTS_PROVIDER (helper->provider));
 
     /* Ignore empty shortcuts */
-    if (shortcut == NULL || g_utf8_strlen (shortcut, -1) == 0)
+    if (shortcut == NULL || *shortcut == '\0')
         return;
 
-    /* Get shortcut from the provider */
-    sc = xfce_shortcuts_provider_get_shortcut (helper->provider, shortcut);
+    /* Get the pre-parsed command from the table */
+    launch = g_hash_table_lookup (helper->launches, shortcut);
 
-    if (G_UNLIKELY (sc == NULL))
+    if (G_UNLIKELY (launch == NULL))
     {
         xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "\"%s\" not found", shortcut);
         return;
@@ -209,18 +408,32 @@ xfce_keyboard_shortcuts_helper_shortcut_activated (XfceShortcutsGrabber *grabber
 
     xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS,
                     "activated \"%s\" (command=\"%s\", snotify=%d, stamp=%d)",
-                    shortcut, sc->command, sc->snotify, timestamp);
+                    shortcut, launch->command, launch->snotify, timestamp);
 
-    /* Handle the argv ourselfs, because xfce_spawn_command_line() does
-     * not accept a custom timestamp for startup notification */
-    succeed = g_shell_parse_argv (sc->command, NULL, &argv, &error);
-    if (G_LIKELY (succeed))
+    if (G_LIKELY (launch->argv != NULL))
     {
-        succeed = xfce_spawn (xfce_gdk_screen_get_active (NULL),
-                              NULL, argv, NULL, G_SPAWN_SEARCH_PATH,
-                              sc->snotify, timestamp, NULL, TRUE, &error);
+        /* Prefer the launcher process, errors and the latency are reported
+         * once it spawned the command */
+        if (xfce_keyboard_shortcuts_helper_spawn_launcher (helper, shortcut, launch, timestamp, start_time))
+            return;
 
+        succeed = xfce_spawn (xfce_gdk_screen_get_active (NULL),
+                              NULL, launch->argv, NULL, G_SPAWN_SEARCH_PATH,
+                              launch->snotify, timestamp, NULL, TRUE, &error);
+        xfsettings_dbg_histogram_add (helper->latency, g_get_monotonic_time () - start_time);
+    }
+    else
+    {
+        /* Parse again only to get a proper error message */
+        succeed = g_shell_parse_argv (launch->command != NULL ? launch->command : "",
+                                      NULL, &argv, &error);
         g_strfreev (argv);
+        if (succeed)
+        {
+            succeed = FALSE;
+            g_set_error_literal (&error, G_SHELL_ERROR, G_SHELL_ERROR_FAILED,
+                                 _("Failed to parse command line"));
+        }
     }
 
     if (!succeed)
@@ -228,6 +441,4 @@ xfce_keyboard_shortcuts_helper_shortcut_activated (XfceShortcutsGrabber *grabber
         xfce_dialog_show_error (NULL, error, _("Failed to launch shortcut \"%s\""), shortcut);
         g_error_free (error);
     }
-
-    xfce_shortcut_free (sc);
 }
@@ -0,0 +1,471 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * The launcher is a tiny child process forked at startup, before GTK is
+ * initialized. Because its address space stays small, spawning commands
+ * from it is cheap, and the daemon's main loop never waits for a fork.
+ *
+ * The daemon sends one SOCK_SEQPACKET message per command: a header
+ * followed by the NUL-terminated argv and envp strings. The launcher
+ * answers with the serial of the request and the posix_spawn() result.
+ */
+
+#include "launcher.h"
+
+#include "common/debug.h"
+
+#include <errno.h>
+#include <gio/gio.h>
+#include <glib-unix.h>
+#include <limits.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <libxfce4util/libxfce4util.h>
+
+
+
+/* stays well below the default unix socket buffer size */
+#define LAUNCHER_MAX_MESSAGE (128 * 1024)
+
+
+
+typedef struct _LauncherRequest
+{
+    guint32 serial;
+    guint32 argc;
+    guint32 envc;
+} LauncherRequest;
+
+typedef struct _LauncherReply
+{
+    guint32 serial;
+    gint32 errnum;
+} LauncherReply;
+
+typedef struct _LauncherPending
+{
+    XfceLauncherCallback callback;
+    gpointer user_data;
+} LauncherPending;
+
+
+
+static gint launcher_fd = -1;
+static guint launcher_watch_id = 0;
+static guint32 launcher_serial = 0;
+static GHashTable *launcher_pending = NULL;
+
+
+
+static void
+launcher_child_reply (gint fd,
+                      guint32 serial,
+                      gint errnum)
+{
+    LauncherReply reply;
+
+    reply.serial = serial;
+    reply.errnum = errnum;
+    send (fd, &reply, sizeof (reply), MSG_NOSIGNAL);
+}
+
+
+
+/* posix_spawnp() searches the PATH of the launcher, which is the one the
+ * daemon had at startup, not the one the command is given */
+static gint
+launcher_child_spawn (pid_t *pid,
+                      const posix_spawnattr_t *attr,
+                      gchar **argv,
+                      gchar **envp)
+{
+    const gchar *path = NULL;
+    const gchar *dir, *next;
+    gchar file[PATH_MAX];
+    gsize name_len, dir_len;
+    gint ret, last = ENOENT;
+
+    for (guint i = 0; envp[i] != NULL && path == NULL; i++)
+        if (strncmp (envp[i], "PATH=", 5) == 0)
+            path = envp[i] + 5;
+
+    if (path == NULL || strchr (argv[0], '/') != NULL)
+        return posix_spawnp (pid, argv[0], NULL, attr, argv, envp);
+
+    name_len = strlen (argv[0]);
+    for (dir = path; dir != NULL; dir = next != NULL ? next + 1 : NULL)
+    {
+        next = strchr (dir, ':');
+        dir_len = next != NULL ? (gsize) (next - dir) : strlen (dir);
+
+        /* an empty element is the current directory */
+        if (dir_len == 0)
+        {
+            dir = ".";
+            dir_len = 1;
+        }
+        if (dir_len + name_len + 2 > sizeof (file))
+            continue;
+
+        memcpy (file, dir, dir_len);
+        file[dir_len] = '/';
+        memcpy (file + dir_len + 1, argv[0], name_len + 1);
+
+        ret = posix_spawn (pid, file, NULL, attr, argv, envp);
+        if (ret != ENOENT && ret != ENOTDIR && ret != EACCES)
+            return ret;
+
+        /* like execvp(), report EACCES if the command exists somewhere */
+        if (ret == EACCES)
+            last = EACCES;
+    }
+
+    return last;
+}
+
+
+
+static void
+launcher_child_main (gint fd) G_GNUC_NORETURN;
+
+static void
+launcher_child_main (gint fd)
+{
+    struct sigaction action;
+    posix_spawnattr_t attr;
+    sigset_t signals;
+    LauncherRequest request;
+    gchar *buffer;
+    gchar **strv;
+    gchar *p, *end;
+    ssize_t len;
+    guint32 i, n;
+    pid_t pid;
+    gint ret;
+
+    /* let the kernel reap the spawned commands */
+    memset (&action, 0, sizeof (action));
+    action.sa_handler = SIG_IGN;
+    action.sa_flags = SA_NOCLDWAIT;
+    sigaction (SIGCHLD, &action, NULL);
+
+    /* but do not pass the ignored SIGCHLD on to the commands */
+    posix_spawnattr_init (&attr);
+    sigemptyset (&signals);
+    posix_spawnattr_setsigmask (&attr, &signals);
+    sigaddset (&signals, SIGCHLD);
+    sigaddset (&signals, SIGPIPE);
+    posix_spawnattr_setsigdefault (&attr, &signals);
+    posix_spawnattr_setflags (&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF
+#ifdef POSIX_SPAWN_SETSID
+                                         | POSIX_SPAWN_SETSID
+#endif
+    );
+
+    buffer = malloc (LAUNCHER_MAX_MESSAGE + 1);
+    if (buffer == NULL)
+        _exit (EXIT_FAILURE);
+
+    for (;;)
+    {
+        len = recv (fd, buffer, LAUNCHER_MAX_MESSAGE, 0);
+        if (len == 0)
+            _exit (EXIT_SUCCESS); /* the daemon went away */
+        if (len < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            _exit (EXIT_FAILURE);
+        }
+
+        if ((gsize) len < sizeof (request))
+            continue;
+
+        memcpy (&request, buffer, sizeof (request));
+        buffer[len] = '\0';
+
+        /* every string takes at least one byte, so this bounds the counts */
+        if (request.argc == 0 || request.argc > (guint32) len || request.envc > (guint32) len)
+        {
+            launcher_child_reply (fd, request.serial, EINVAL);
+            continue;
+        }
+
+        strv = malloc ((request.argc + request.envc + 2) * sizeof (gchar *));
+        if (strv == NULL)
+        {
+            launcher_child_reply (fd, request.serial, ENOMEM);
+            continue;
+        }
+
+        /* split the payload into argv and envp, both NULL-terminated */
+        p = buffer + sizeof (request);
+        end = buffer + len;
+        n = 0;
+        for (i = 0; i < request.argc + request.envc && p < end; i++)
+        {
+            if (i == request.argc)
+                strv[n++] = NULL;
+            strv[n++] = p;
+            p += strlen (p) + 1;
+        }
+        if (i != request.argc + request.envc)
+        {
+            launcher_child_reply (fd, request.serial, EINVAL);
+            free (strv);
+            continue;
+        }
+        if (request.envc == 0)
+            strv[n++] = NULL;
+        strv[n] = NULL;
+
+        ret = launcher_child_spawn (&pid, &attr, strv, strv + request.argc + 1);
+        launcher_child_reply (fd, request.serial, ret);
+        free (strv);
+    }
+}
+
+
+
+/**
+ * xfce_launcher_fork:
+ *
+ * Fork the launcher process. This must be called before GTK is initialized
+ * and before any threads are started; if it fails, xfce_launcher_spawn()
+ * simply returns %FALSE and callers spawn commands themselves.
+ **/
+void
+xfce_launcher_fork (void)
+{
+    gint fds[2];
+    pid_t pid;
+
+    g_return_if_fail (launcher_fd == -1);
+
+    if (socketpair (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) == -1)
+    {
+        g_warning ("Failed to create launcher socket: %s", g_strerror (errno));
+        return;
+    }
+
+    pid = fork ();
+    if (pid == -1)
+    {
+        g_warning ("Failed to fork launcher: %s", g_strerror (errno));
+        close (fds[0]);
+        close (fds[1]);
+        return;
+    }
+
+    if (pid == 0)
+    {
+        close (fds[0]);
+        launcher_child_main (fds[1]);
+    }
+
+    close (fds[1]);
+    launcher_fd = fds[0];
+}
+
+
+
+static void
+launcher_pending_fail (gpointer key,
+                       gpointer value,
+                       gpointer user_data)
+{
+    LauncherPending *pending = value;
+    const GError *error = user_data;
+
+    pending->callback (error, pending->user_data);
+}
+
+
+
+void
+xfce_launcher_shutdown (void)
+{
+    GHashTable *pending;
+    GError *error;
+
+    if (launcher_fd == -1)
+        return;
+
+    if (launcher_watch_id != 0)
+    {
+        g_source_remove (launcher_watch_id);
+        launcher_watch_id = 0;
+    }
+
+    /* the launcher exits as soon as it reads EOF */
+    close (launcher_fd);
+    launcher_fd = -1;
+
+    /* nobody waits for these launches anymore, callers only free their data */
+    if (launcher_pending != NULL)
+    {
+        /* detached first, a callback may call back into the launcher */
+        pending = g_steal_pointer (&launcher_pending);
+        error = g_error_new_literal (G_IO_ERROR, G_IO_ERROR_CANCELLED, "The launcher was shut down");
+        g_hash_table_foreach (pending, launcher_pending_fail, error);
+        g_hash_table_destroy (pending);
+        g_error_free (error);
+    }
+}
+
+
+
+gboolean
+xfce_launcher_is_running (void)
+{
+    return launcher_fd != -1;
+}
+
+
+
+static gboolean
+launcher_reply_received (gint fd,
+                         GIOCondition condition,
+                         gpointer user_data)
+{
+    LauncherReply reply;
+    LauncherPending *pending;
+    GError *error = NULL;
+    ssize_t len;
+
+    for (;;)
+    {
+        len = recv (fd, &reply, sizeof (reply), MSG_DONTWAIT);
+        if (len == -1 && errno == EINTR)
+            continue;
+        if (len == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return G_SOURCE_CONTINUE;
+
+        if (len != sizeof (reply))
+        {
+            /* EOF or error, stop using the launcher */
+            g_warning ("Launcher process is gone, spawning commands from the daemon");
+            launcher_watch_id = 0;
+            xfce_launcher_shutdown ();
+            return G_SOURCE_REMOVE;
+        }
+
+        /* the callback may run a nested main loop that shuts the launcher
+         * down, so the entry must not be in the table anymore */
+        if (G_UNLIKELY (launcher_pending == NULL
+                        || !g_hash_table_steal_extended (launcher_pending, GUINT_TO_POINTER (reply.serial),
+                                                         NULL, (gpointer *) &pending)))
+            continue;
+
+        if (reply.errnum != 0)
+            error = g_error_new_literal (G_SPAWN_ERROR, G_SPAWN_ERROR_FAILED, g_strerror (reply.errnum));
+
+        pending->callback (error, pending->user_data);
+        g_clear_error (&error);
+        g_free (pending);
+
+        if (launcher_fd != fd)
+            return G_SOURCE_REMOVE;
+    }
+}
+
+
+
+/**
+ * xfce_launcher_spawn:
+ * @argv: the command to spawn, argv[0] is looked up in the PATH of @envp.
+ * @envp: the environment of the command, or %NULL for an empty one.
+ * @callback: called once the launcher reported the spawn result.
+ * @user_data: data for @callback.
+ *
+ * Hand a command over to the launcher process without blocking.
+ *
+ * Returns: %TRUE if the command was sent, in which case @callback will be
+ *          called exactly once. %FALSE if the launcher is not available
+ *          or the command does not fit in a message; the caller should
+ *          spawn the command itself.
+ **/
+gboolean
+xfce_launcher_spawn (gchar **argv,
+                     gchar **envp,
+                     XfceLauncherCallback callback,
+                     gpointer user_data)
+{
+    LauncherRequest request;
+    LauncherPending *pending;
+    GByteArray *message;
+    gboolean succeed;
+    ssize_t len;
+    guint i;
+
+    g_return_val_if_fail (argv != NULL && argv[0] != NULL, FALSE);
+    g_return_val_if_fail (callback != NULL, FALSE);
+
+    if (launcher_fd == -1)
+        return FALSE;
+
+    request.serial = ++launcher_serial;
+    request.argc = g_strv_length (argv);
+    request.envc = envp != NULL ? g_strv_length (envp) : 0;
+
+    message = g_byte_array_sized_new (4096);
+    g_byte_array_append (message, (const guint8 *) &request, sizeof (request));
+    for (i = 0; argv[i] != NULL; i++)
+        g_byte_array_append (message, (const guint8 *) argv[i], strlen (argv[i]) + 1);
+    for (i = 0; envp != NULL && envp[i] != NULL; i++)
+        g_byte_array_append (message, (const guint8 *) envp[i], strlen (envp[i]) + 1);
+
+    if (message->len > LAUNCHER_MAX_MESSAGE)
+    {
+        xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "command \"%s\" is too large for the launcher", argv[0]);
+        g_byte_array_unref (message);
+        return FALSE;
+    }
+
+    len = send (launcher_fd, message->data, message->len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    succeed = len == (ssize_t) message->len;
+    g_byte_array_unref (message);
+
+    if (!succeed)
+    {
+        xfsettings_dbg (XFSD_DEBUG_KEYBOARD_SHORTCUTS, "launcher did not accept \"%s\": %s",
+                        argv[0], len == -1 ? g_strerror (errno) : "short write");
+        if (len == -1 && (errno == EPIPE || errno == ECONNRESET))
+            xfce_launcher_shutdown ();
+        return FALSE;
+    }
+
+    if (launcher_pending == NULL)
+        launcher_pending = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+
+    if (launcher_watch_id == 0)
+        launcher_watch_id = g_unix_fd_add (launcher_fd, G_IO_IN | G_IO_HUP | G_IO_ERR, launcher_reply_received, NULL);
+
+    pending = g_new0 (LauncherPending, 1);
+    pending->callback = callback;
+    pending->user_data = user_data;
+    g_hash_table_insert (launcher_pending, GUINT_TO_POINTER (request.serial), pending);
+
+    return TRUE;
+}
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2026 The Xfce Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __LAUNCHER_H__
+#define __LAUNCHER_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* called once the launcher reports back, error is NULL on success and
+ * G_IO_ERROR_CANCELLED if the launcher was shut down before replying */
+typedef void (*XfceLauncherCallback) (const GError *error,
+                                      gpointer user_data);
+
+void
+xfce_launcher_fork (void);
+
+void
+xfce_launcher_shutdown (void);
+
+gboolean
+xfce_launcher_is_running (void);
+
+gboolean
+xfce_launcher_spawn (gchar **argv,
+                     gchar **envp,
+                     XfceLauncherCallback callback,
+                     gpointer user_data);
+
+G_END_DECLS
+
+#endif /* !__LAUNCHER_H__ */
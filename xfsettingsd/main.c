@@ -34,6 +34,7 @@
 #include "keyboard-layout.h"
 #include "keyboard-shortcuts.h"
 #include "keyboards.h"
+#include "launcher.h"
 #include "pointers.h"
 #include "workspaces.h"
 #include "xsettings.h"
@@ -67,6 +68,9 @@ static gboolean opt_daemon = FALSE;
 static gboolean opt_disable_wm_check = FALSE;
 static gboolean opt_replace = FALSE;
 static gboolean opt_allow_multiple = FALSE;
+#ifdef ENABLE_DISPLAY_SETTINGS
+static gboolean opt_displays_dry_run = FALSE;
+#endif
 static guint owner_id = 0;
 
 struct t_data_set
@@ -96,6 +100,9 @@ static GOptionEntry option_entries[] = {
     { "disable-wm-check", 'D', 0, G_OPTION_ARG_NONE, &opt_disable_wm_check, N_ ("Do not wait for a window manager on startup"), NULL },
     { "replace", 0, 0, G_OPTION_ARG_NONE, &opt_replace, N_ ("Replace running xsettings daemon (if any)"), NULL },
     { "allow-multiple", 0, 0, G_OPTION_ARG_NONE, &opt_allow_multiple, N_ ("Allow xfsettingsd to start even if another instance is running"), NULL },
+#ifdef ENABLE_DISPLAY_SETTINGS
+    { "displays-dry-run", 0, 0, G_OPTION_ARG_NONE, &opt_displays_dry_run, N_ ("Print display changes instead of applying them"), NULL },
+#endif
     { NULL }
 };
 
@@ -124,6 +131,7 @@ start_xfsettingsd (struct t_data_set *s_data)
     s_data->gtk_decorations_helper = g_object_new (XFCE_TYPE_DECORATIONS_HELPER, NULL);
     s_data->gtk_settings_helper = g_object_new (XFCE_TYPE_GTK_SETTINGS_HELPER, NULL);
 #ifdef ENABLE_DISPLAY_SETTINGS
+    xfce_displays_helper_set_dry_run (opt_displays_dry_run);
     s_data->displays_helper = xfce_displays_helper_new ();
 #endif
 
@@ -279,12 +287,23 @@ main (gint argc,
         }
     }
 
+#ifdef ENABLE_X11
+    /* fork the shortcut launcher while the process is still small */
+    xfce_launcher_fork ();
+#endif
+
     if (!gtk_init_check (&argc, &argv))
     {
         g_printerr ("%s: %s.\n", G_LOG_DOMAIN, "Unable to open display");
         return EXIT_FAILURE;
     }
 
+#ifdef ENABLE_X11
+    /* keyboard shortcuts are only handled on X11 */
+    if (!GDK_IS_X11_DISPLAY (gdk_display_get_default ()))
+        xfce_launcher_shutdown ();
+#endif
+
     setlocale (LC_NUMERIC, "C");
 
     /* Initialize our data set */
@@ -372,6 +391,7 @@ main (gint argc,
     UNREF_GOBJECT (s_data.keyboard_layout_helper);
     UNREF_GOBJECT (s_data.workspaces_helper);
     UNREF_GOBJECT (s_data.clipboard_daemon);
+    xfce_launcher_shutdown ();
 #endif
     UNREF_GOBJECT (s_data.gtk_decorations_helper);
     UNREF_GOBJECT (s_data.gtk_settings_helper);
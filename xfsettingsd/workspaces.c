@@ -34,13 +34,17 @@
 static void
 xfce_workspaces_helper_finalize (GObject *object);
 static guint
-xfce_workspaces_helper_get_count (void);
+xfce_workspaces_helper_read_count (void);
 static GdkFilterReturn
 xfce_workspaces_helper_filter_func (GdkXEvent *gdkxevent,
                                     GdkEvent *event,
                                     gpointer user_data);
 static GPtrArray *
-xfce_workspaces_helper_get_names (void);
+xfce_workspaces_helper_read_names (void);
+static gboolean
+xfce_workspaces_helper_has_window_manager (XfceWorkspacesHelper *helper);
+static void
+xfce_workspaces_helper_window_manager_found (XfceWorkspacesHelper *helper);
 static void
 xfce_workspaces_helper_set_names (XfceWorkspacesHelper *helper,
                                   gboolean disable_wm_check);
@@ -60,23 +64,25 @@ struct _XfceWorkspacesHelper
 
     XfconfChannel *channel;
     gint64 timestamp;
+
+    /* fallback timeout while waiting for a window manager */
     guint wait_for_wm_timeout_id;
+    gint64 wait_for_wm_start;
+    Atom atom_wm_selection;
+
+    /* root window properties, updated on PropertyNotify */
+    guint n_desktops;
+    GPtrArray *names;
 };
 
 static Atom atom_net_number_of_desktops = 0;
 static Atom atom_net_desktop_names = 0;
+static Atom atom_net_supporting_wm_check = 0;
+static Atom atom_manager = 0;
 static gboolean xfsettingsd_disable_wm_check = FALSE;
 
-typedef struct
-{
-    XfceWorkspacesHelper *helper;
-
-    Display *dpy;
-    Atom *atoms;
-    guint atom_count;
-    guint have_wm : 1;
-    guint counter;
-} WaitForWM;
+/* give up waiting for a window manager after this time */
+#define WAIT_FOR_WM_TIMEOUT 5
 
 
 
@@ -93,6 +99,8 @@ xfce_workspaces_helper_class_init (XfceWorkspacesHelperClass *klass)
 
     atom_net_number_of_desktops = gdk_x11_get_xatom_by_name ("_NET_NUMBER_OF_DESKTOPS");
     atom_net_desktop_names = gdk_x11_get_xatom_by_name ("_NET_DESKTOP_NAMES");
+    atom_net_supporting_wm_check = gdk_x11_get_xatom_by_name ("_NET_SUPPORTING_WM_CHECK");
+    atom_manager = gdk_x11_get_xatom_by_name ("MANAGER");
 }
 
 
@@ -101,15 +109,25 @@ xfce_workspaces_helper_init (XfceWorkspacesHelper *helper)
 {
     GdkWindow *root_window;
     GdkEventMask events;
+    gchar *selection_name;
 
     helper->channel = xfconf_channel_get (WORKSPACES_CHANNEL);
 
-    /* monitor root window property changes */
+    /* the window manager selection of our screen, see ICCCM 2.8 */
+    selection_name = g_strdup_printf ("WM_S%d", gdk_x11_screen_get_screen_number (gdk_screen_get_default ()));
+    helper->atom_wm_selection = gdk_x11_get_xatom_by_name (selection_name);
+    g_free (selection_name);
+
+    /* monitor root window property changes, and the MANAGER client
+     * message a window manager broadcasts when it takes the selection */
     root_window = gdk_get_default_root_window ();
     events = gdk_window_get_events (root_window);
-    gdk_window_set_events (root_window, events | GDK_PROPERTY_CHANGE_MASK);
+    gdk_window_set_events (root_window, events | GDK_PROPERTY_CHANGE_MASK | GDK_STRUCTURE_MASK);
     gdk_window_add_filter (root_window, xfce_workspaces_helper_filter_func, helper);
 
+    helper->n_desktops = xfce_workspaces_helper_read_count ();
+    helper->names = xfce_workspaces_helper_read_names ();
+
     xfce_workspaces_helper_set_names (helper, FALSE);
 
     g_signal_connect (G_OBJECT (helper->channel),
@@ -128,6 +146,14 @@ xfce_workspaces_helper_finalize (GObject *object)
                                           G_CALLBACK (xfce_workspaces_helper_prop_changed),
                                           helper);
 
+    gdk_window_remove_filter (gdk_get_default_root_window (), xfce_workspaces_helper_filter_func, helper);
+
+    if (helper->wait_for_wm_timeout_id != 0)
+        g_source_remove (helper->wait_for_wm_timeout_id);
+
+    if (helper->names != NULL)
+        xfconf_array_free (helper->names);
+
     G_OBJECT_CLASS (xfce_workspaces_helper_parent_class)->finalize (object);
 }
 
@@ -146,12 +172,17 @@ xfce_workspaces_helper_filter_func (GdkXEvent *gdkxevent,
         if (xevent->xproperty.atom == atom_net_number_of_desktops)
         {
             /* new workspace was added or removed */
+            helper->n_desktops = xfce_workspaces_helper_read_count ();
             xfce_workspaces_helper_set_names (helper, TRUE);
 
             xfsettings_dbg (XFSD_DEBUG_WORKSPACES, "number of desktops changed");
         }
         else if (xevent->xproperty.atom == atom_net_desktop_names)
         {
+            if (helper->names != NULL)
+                xfconf_array_free (helper->names);
+            helper->names = xfce_workspaces_helper_read_names ();
+
             /* don't respond to our own name changes (1 sec) */
             if (g_get_real_time () > helper->timestamp)
             {
@@ -163,6 +194,21 @@ xfce_workspaces_helper_filter_func (GdkXEvent *gdkxevent,
                 xfsettings_dbg (XFSD_DEBUG_WORKSPACES, "someone else changed the desktop names");
             }
         }
+        else if (xevent->xproperty.atom == atom_net_supporting_wm_check
+                 && helper->wait_for_wm_timeout_id != 0
+                 && xfce_workspaces_helper_has_window_manager (helper))
+        {
+            /* window manager announced itself the EWMH way */
+            xfce_workspaces_helper_window_manager_found (helper);
+        }
+    }
+    else if (xevent->type == ClientMessage
+             && xevent->xclient.message_type == atom_manager
+             && (Atom) xevent->xclient.data.l[1] == helper->atom_wm_selection
+             && helper->wait_for_wm_timeout_id != 0)
+    {
+        /* window manager acquired the WM_Sn selection */
+        xfce_workspaces_helper_window_manager_found (helper);
     }
 
     return GDK_FILTER_CONTINUE;
@@ -171,7 +217,7 @@ xfce_workspaces_helper_filter_func (GdkXEvent *gdkxevent,
 
 
 static GPtrArray *
-xfce_workspaces_helper_get_names (void)
+xfce_workspaces_helper_read_names (void)
 {
     gboolean succeed;
     GdkAtom utf8_atom, type_returned;
@@ -230,7 +276,7 @@ xfce_workspaces_helper_get_names (void)
 
 
 static guint
-xfce_workspaces_helper_get_count (void)
+xfce_workspaces_helper_read_count (void)
 {
     guint result = 0;
     guchar *data = NULL;
@@ -281,7 +327,7 @@ xfce_workspaces_helper_set_names_real (XfceWorkspacesHelper *helper)
 
     g_return_if_fail (XFCE_IS_WORKSPACES_HELPER (helper));
 
-    n_workspaces = xfce_workspaces_helper_get_count ();
+    n_workspaces = helper->n_desktops;
     if (n_workspaces < 1)
         return;
 
@@ -341,8 +387,8 @@ xfce_workspaces_helper_set_names_real (XfceWorkspacesHelper *helper)
         if (names == NULL)
             names = g_ptr_array_sized_new (n_workspaces);
 
-        /* get current names set in x */
-        existing_names = xfce_workspaces_helper_get_names ();
+        /* current names set in x */
+        existing_names = helper->names;
 
         for (i = names->len; i < n_workspaces; i++)
         {
@@ -377,8 +423,6 @@ xfce_workspaces_helper_set_names_real (XfceWorkspacesHelper *helper)
             g_critical ("Failed to save xfconf property %s", WORKSPACE_NAMES_PROP);
 
         xfsettings_dbg (XFSD_DEBUG_WORKSPACES, "extended names in xfconf, waiting for property-change");
-
-        xfconf_array_free (existing_names);
     }
 
     xfconf_array_free (names);
@@ -387,54 +431,43 @@ xfce_workspaces_helper_set_names_real (XfceWorkspacesHelper *helper)
 
 
 static gboolean
-xfce_workspaces_helper_wait_for_window_manager (gpointer data)
+xfce_workspaces_helper_has_window_manager (XfceWorkspacesHelper *helper)
 {
-    WaitForWM *wfwm = data;
-    guint i;
-    gboolean have_wm = TRUE;
+    Display *dpy = GDK_DISPLAY_XDISPLAY (gdk_display_get_default ());
 
-    for (i = 0; i < wfwm->atom_count; i++)
-    {
-        if (XGetSelectionOwner (wfwm->dpy, wfwm->atoms[i]) == None)
-        {
-            DBG ("window manager not ready on screen %d, waiting...", i);
+    return XGetSelectionOwner (dpy, helper->atom_wm_selection) != None;
+}
 
-            have_wm = FALSE;
-            break;
-        }
-    }
 
-    wfwm->have_wm = have_wm;
 
-    /* abort if a window manager is found or 5 seconds expired */
-    return wfwm->counter++ < 20 * 5 && !wfwm->have_wm;
+static void
+xfce_workspaces_helper_window_manager_found (XfceWorkspacesHelper *helper)
+{
+    g_source_remove (helper->wait_for_wm_timeout_id);
+    helper->wait_for_wm_timeout_id = 0;
+
+    DBG ("found window manager after %" G_GINT64_FORMAT " ms",
+         (g_get_monotonic_time () - helper->wait_for_wm_start) / 1000);
+
+    xfce_workspaces_helper_set_names_real (helper);
 }
 
 
 
-static void
-xfce_workspaces_helper_wait_for_window_manager_destroyed (gpointer data)
+static gboolean
+xfce_workspaces_helper_wait_for_window_manager_timeout (gpointer data)
 {
-    WaitForWM *wfwm = data;
-    XfceWorkspacesHelper *helper = wfwm->helper;
+    XfceWorkspacesHelper *helper = data;
 
     helper->wait_for_wm_timeout_id = 0;
 
-    if (!wfwm->have_wm)
-    {
-        g_printerr (G_LOG_DOMAIN ": No window manager registered on screen 0.\n");
-    }
-    else
-    {
-        DBG ("found window manager after %d tries", wfwm->counter);
-    }
-
-    g_free (wfwm->atoms);
-    XCloseDisplay (wfwm->dpy);
-    g_slice_free (WaitForWM, wfwm);
+    g_printerr (G_LOG_DOMAIN ": No window manager registered on screen %d.\n",
+                gdk_x11_screen_get_screen_number (gdk_screen_get_default ()));
 
     /* set the names anyway... */
     xfce_workspaces_helper_set_names_real (helper);
+
+    return G_SOURCE_REMOVE;
 }
 
 
@@ -443,35 +476,20 @@ static void
 xfce_workspaces_helper_set_names (XfceWorkspacesHelper *helper,
                                   gboolean disable_wm_check)
 {
-    WaitForWM *wfwm;
-    gchar **atom_names;
+    /* names are set once the window manager shows up */
+    if (helper->wait_for_wm_timeout_id != 0)
+        return;
 
-    if (!disable_wm_check && !xfsettingsd_disable_wm_check)
+    if (!disable_wm_check && !xfsettingsd_disable_wm_check
+        && !xfce_workspaces_helper_has_window_manager (helper))
     {
-        /* setup data for wm checking */
-        wfwm = g_slice_new0 (WaitForWM);
-        wfwm->helper = helper;
-        wfwm->dpy = XOpenDisplay (NULL);
-        wfwm->have_wm = FALSE;
-        wfwm->counter = 0;
-
-        /* preload wm atoms for all screens */
-        wfwm->atom_count = XScreenCount (wfwm->dpy);
-        wfwm->atoms = g_new (Atom, wfwm->atom_count);
-        atom_names = g_new0 (gchar *, wfwm->atom_count + 1);
-
-        for (guint i = 0; i < wfwm->atom_count; i++)
-            atom_names[i] = g_strdup_printf ("WM_S%u", i);
-
-        if (!XInternAtoms (wfwm->dpy, atom_names, wfwm->atom_count, False, wfwm->atoms))
-            wfwm->atom_count = 0;
-
-        g_strfreev (atom_names);
+        DBG ("window manager not ready, waiting...");
 
-        /* setup timeout to check for a window manager */
+        /* wait for the MANAGER message or _NET_SUPPORTING_WM_CHECK in
+         * the event filter, with a timeout in case none shows up */
+        helper->wait_for_wm_start = g_get_monotonic_time ();
         helper->wait_for_wm_timeout_id =
-            g_timeout_add_full (G_PRIORITY_DEFAULT_IDLE, 50, xfce_workspaces_helper_wait_for_window_manager,
-                                wfwm, xfce_workspaces_helper_wait_for_window_manager_destroyed);
+            g_timeout_add_seconds (WAIT_FOR_WM_TIMEOUT, xfce_workspaces_helper_wait_for_window_manager_timeout, helper);
     }
     else
     {
@@ -493,7 +511,7 @@ xfce_workspaces_helper_save_names (XfceWorkspacesHelper *helper)
 
     g_return_if_fail (XFCE_IS_WORKSPACES_HELPER (helper));
 
-    new_names = xfce_workspaces_helper_get_names ();
+    new_names = helper->names;
     if (new_names == NULL)
         return;
 
@@ -541,7 +559,6 @@ xfce_workspaces_helper_save_names (XfceWorkspacesHelper *helper)
 
     if (xfconf_names != NULL)
         xfconf_array_free (xfconf_names);
-    xfconf_array_free (new_names);
 }
 
 